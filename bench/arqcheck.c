@@ -0,0 +1,195 @@
+//=======================================================================================================
+//
+//   Title: Reliable channel checks (arq.c).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Uso: lora_arqcheck
+//
+//   Passa sequencias montadas a mao pelo arq_rx/arq_pop reais: entrega em ordem atravessando a volta
+//   de 255 para 0, duplicatas (so reconfirmadas), lacuna abandonada pelo timeout, lacuna preenchida
+//   fora de ordem, reinicio do transmissor (salto para tras e no mudo) e payload grande demais. Cada
+//   verificacao que falha e impressa e o programa sai com erro.
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <string.h>
+#include "arq.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define CHECK(c) do{ if(!(c)){ printf("FALHA %s:%d: %s\n", __FILE__, __LINE__, #c); Fails++; } }while(0)
+
+//=======================================================================================================
+//--- Variaveis ---
+static unsigned    Fails;
+static arq_state_t A;                         // ~1 KB de buffers: fora da pilha
+static int64_t     Now = 1000000;
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- rx ---
+// Frame com payload = a propria sequencia e t_rx_us = instante de chegada.
+static int rx(uint8_t seq)
+{
+  link_rx_t m = {.t_rx_us = Now, .t_pre_us = Now - 1000, .rssi = -80, .late = false};
+  return arq_rx(&A, seq, &seq, 1, &m, Now);
+}//end rx
+
+//=======================================================================================================
+//--- pop ---
+// Devolve a sequencia liberada ou -1; 'late' recebe o flag guardado com o frame.
+static int pop(bool flush, bool *late)
+{
+  uint8_t   out[ARQ_FRAME_MAX];
+  size_t    len;
+  link_rx_t m;
+
+  if(!arq_pop(&A, out, &len, &m, Now, flush))
+    return -1;
+  if(late)
+    *late = m.late;
+  return len == 1 ? out[0] : -2;
+}//end pop
+
+//=======================================================================================================
+//--- check_wrap ---
+static void check_wrap(void)
+{
+  arq_reset(&A);
+  for(int i = 0; i < 12; i++)
+  {
+    uint8_t seq = (uint8_t)(250 + i);
+    CHECK(rx(seq) == ARQ_NEW);
+    CHECK(pop(false, NULL) == seq);
+    CHECK(pop(false, NULL) == -1);
+    Now += 100000;
+  }//end for
+  CHECK(A.base == 6 && A.given_up == 0 && A.resync == 0);
+}//end check_wrap
+
+//=======================================================================================================
+//--- check_dup ---
+// ACK perdido: o transmissor reenvia o que ja foi liberado. Confirmado de novo, nunca entregue.
+static void check_dup(void)
+{
+  arq_reset(&A);
+  for(uint8_t seq = 10; seq < 14; seq++)
+  {
+    rx(seq);
+    pop(false, NULL);
+  }//end for
+  CHECK(rx(13) == ARQ_DUP);
+  CHECK(rx(14 - ARQ_WINDOW) == ARQ_DUP);
+  CHECK(pop(false, NULL) == -1);
+  CHECK(rx(15) == ARQ_NEW);                   // 14 falta: 15 fica guardado
+  CHECK(rx(15) == ARQ_DUP);
+  CHECK(A.dup == 3 && A.resync == 0);
+}//end check_dup
+
+//=======================================================================================================
+//--- check_gap ---
+static void check_gap(void)
+{
+  bool late = false;
+
+  // Lacuna preenchida: 21 chega depois de 22 e 23, que saem atrasados
+  arq_reset(&A);
+  rx(20);
+  CHECK(pop(false, NULL) == 20);
+  rx(22);
+  rx(23);
+  CHECK(pop(false, NULL) == -1);
+  uint8_t ack[ARQ_ACK_LEN];
+  CHECK(arq_ack_encode(&A, 1, ack, sizeof(ack)) == ARQ_ACK_LEN);
+  CHECK(ack[2] == 21 && ack[3] == 0x03 && ack[4] == 0x00);  // base 21, SACK de 22 e 23
+  Now += 500000;
+  CHECK(rx(21) == ARQ_NEW);
+  CHECK(pop(false, &late) == 21 && late);     // Retransmissao: medida mais velha que o RxDone
+  CHECK(pop(false, &late) == 22 && !late);    // O chamador marca os presos pelo t_rx_us diferente
+  CHECK(pop(false, NULL) == 23);
+  CHECK(A.recovered == 1 && A.given_up == 0);
+
+  // Lacuna abandonada: 31 nunca chega
+  arq_reset(&A);
+  rx(30);
+  pop(false, NULL);
+  rx(32);
+  rx(33);
+  Now += ARQ_GAP_TIMEOUT_US - 1;
+  CHECK(pop(false, NULL) == -1);
+  Now += 1;
+  CHECK(pop(false, NULL) == 32);
+  CHECK(pop(false, NULL) == 33);
+  CHECK(A.given_up == 1 && A.base == 34);
+}//end check_gap
+
+//=======================================================================================================
+//--- check_restart ---
+// O transmissor reinicia e a sequencia volta: tem que virar sessao nova, nao duplicata confirmada.
+static void check_restart(void)
+{
+  arq_reset(&A);
+  for(uint8_t seq = 0; seq < 22; seq++)
+  {
+    rx(seq);
+    pop(false, NULL);
+    Now += 100000;
+  }//end for
+  CHECK(rx(250) == ARQ_NEW);                  // base 22: 28 para tras e mais que a janela
+  CHECK(pop(false, NULL) == 250);
+  CHECK(A.resync == 1 && A.base == 251);
+
+  // Salto para tras com frames guardados: ARQ_FAR, libera a sessao velha e repete
+  rx(253);
+  CHECK(pop(false, NULL) == -1);
+  CHECK(rx(200) == ARQ_FAR);
+  CHECK(pop(true, NULL) == 253);
+  CHECK(rx(200) == ARQ_NEW);
+  CHECK(pop(false, NULL) == 200);
+  CHECK(A.resync == 2);
+
+  // Reinicio que cai dentro da faixa de duplicatas: so o no mudo por ARQ_IDLE_US separa os dois
+  CHECK(rx(199) == ARQ_DUP);
+  Now += ARQ_IDLE_US;
+  CHECK(rx(198) == ARQ_NEW);
+  CHECK(pop(false, NULL) == 198);
+  CHECK(A.resync == 3);
+}//end check_restart
+
+//=======================================================================================================
+//--- check_big ---
+static void check_big(void)
+{
+  static uint8_t big[ARQ_FRAME_MAX + 1];
+  link_rx_t      m = {0};
+
+  arq_reset(&A);
+  CHECK(arq_rx(&A, 5, big, sizeof(big), &m, Now) == ARQ_BIG);
+  CHECK(!A.synced && A.have == 0);
+}//end check_big
+
+//=======================================================================================================
+//--- main ---
+int main(void)
+{
+  check_wrap();
+  check_dup();
+  check_gap();
+  check_restart();
+  check_big();
+  if(Fails)
+  {
+    fprintf(stderr, "%u verificacoes falharam\n", Fails);
+    return 1;
+  }//end if
+  printf("arq ok\n");
+  return 0;
+}//end main
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,135 @@
+//=======================================================================================================
+//
+//   Title: Minimal benchmark harness (google-benchmark style JSON output).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Opcoes (mesmos nomes do google-benchmark):
+//     --benchmark_filter=<substring>   --benchmark_min_time=<s>   --benchmark_out=<arquivo.json>
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "bench.h"
+
+//=======================================================================================================
+//--- Variaveis ---
+static uint64_t AllocCount;
+
+void *__real_malloc(size_t n);
+void *__real_calloc(size_t n, size_t m);
+void *__real_realloc(void *p, size_t n);
+void  __real_free(void *p);
+
+//=======================================================================================================
+//--- Allocation hooks (-Wl,--wrap) ---
+void *__wrap_malloc(size_t n)            { AllocCount++; return __real_malloc(n); }
+void *__wrap_calloc(size_t n, size_t m)  { AllocCount++; return __real_calloc(n, m); }
+void *__wrap_realloc(void *p, size_t n)  { AllocCount++; return __real_realloc(p, n); }
+void  __wrap_free(void *p)               { __real_free(p); }
+
+uint64_t bench_alloc_count(void)
+{
+  return AllocCount;
+}//end bench_alloc_count
+
+//=======================================================================================================
+//--- now_ns ---
+static double now_ns(clockid_t clk)
+{
+  struct timespec ts;
+  clock_gettime(clk, &ts);
+  return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}//end now_ns
+
+//=======================================================================================================
+//--- bench_run_all ---
+int bench_run_all(const bench_t *list, size_t n, int argc, char **argv)
+{
+  const char *filter  = NULL;
+  const char *outPath = NULL;
+  double      minTime = 0.5;
+
+  for(int i = 1; i < argc; i++)
+  {
+    if(strncmp(argv[i], "--benchmark_filter=", 19) == 0)        filter  = argv[i] + 19;
+    else if(strncmp(argv[i], "--benchmark_out=", 16) == 0)      outPath = argv[i] + 16;
+    else if(strncmp(argv[i], "--benchmark_min_time=", 21) == 0) minTime = atof(argv[i] + 21);
+    else
+    {
+      fprintf(stderr, "opcao desconhecida: %s\n", argv[i]);
+      return 2;
+    }//end else
+  }//end for
+
+  FILE *out = outPath ? fopen(outPath, "w") : stdout;
+  if(!out)
+  {
+    perror(outPath);
+    return 1;
+  }//end if
+
+  time_t t = time(NULL);
+  char   date[32];
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&t));
+  fprintf(out, "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"executable\": \"%s\",\n"
+               "    \"library_build_type\": \"%s\"\n  },\n  \"benchmarks\": [",
+          date, argv[0],
+#ifdef NDEBUG
+          "release"
+#else
+          "debug"
+#endif
+          );
+
+  fprintf(stderr, "%-32s %14s %14s %12s %10s\n", "Benchmark", "ns/iter", "items/s", "iters", "allocs/it");
+  int first = 1;
+  for(size_t b = 0; b < n; b++)
+  {
+    if(filter && !strstr(list[b].name, filter))
+      continue;
+
+    uint64_t iters = 1, items = 0, allocs = 0;
+    double   real = 0, cpu = 0;
+    while(1)
+    {
+      uint64_t a0 = AllocCount;
+      double   r0 = now_ns(CLOCK_MONOTONIC);
+      double   c0 = now_ns(CLOCK_PROCESS_CPUTIME_ID);
+      items  = list[b].fn(iters, list[b].ctx);
+      cpu    = now_ns(CLOCK_PROCESS_CPUTIME_ID) - c0;
+      real   = now_ns(CLOCK_MONOTONIC) - r0;
+      allocs = AllocCount - a0;
+      if(real >= minTime * 1e9 || iters >= (1ull << 40))
+        break;
+      // Estima as iteracoes para o tempo minimo (com folga), sem crescer mais que 10x por rodada
+      double grow = real > 0 ? (minTime * 1e9 * 1.4) / real : 10.0;
+      iters = (uint64_t)((double)iters * (grow > 10.0 ? 10.0 : (grow < 2.0 ? 2.0 : grow)));
+    }//end while
+
+    double nsIter = real / (double)iters;
+    double ips    = real > 0 ? (double)items * 1e9 / real : 0;
+    double apiter = (double)allocs / (double)iters;
+    fprintf(stderr, "%-32s %14.1f %14.0f %12llu %10.2f\n", list[b].name, nsIter, ips,
+            (unsigned long long)iters, apiter);
+    fprintf(out, "%s\n    {\n      \"name\": \"%s\",\n      \"run_type\": \"iteration\",\n"
+                 "      \"iterations\": %llu,\n      \"real_time\": %.3f,\n      \"cpu_time\": %.3f,\n"
+                 "      \"time_unit\": \"ns\",\n      \"items_per_second\": %.1f,\n"
+                 "      \"allocs_per_iteration\": %.3f\n    }",
+            first ? "" : ",", list[b].name, (unsigned long long)iters, nsIter, cpu / (double)iters, ips, apiter);
+    first = 0;
+  }//end for
+
+  fprintf(out, "\n  ]\n}\n");
+  if(out != stdout)
+    fclose(out);
+  return 0;
+}//end bench_run_all
+
+//=======================================================================================================
+//--- End of Program ---
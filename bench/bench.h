@@ -0,0 +1,45 @@
+//=======================================================================================================
+//
+//   Title: Minimal benchmark harness (google-benchmark style JSON output).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Cada benchmark recebe o numero de iteracoes e devolve quantos itens (frames, amostras) processou.
+//   O harness dobra as iteracoes ate passar do tempo minimo, como o google-benchmark, e registra
+//   tempo por iteracao, itens/s e alocacoes por iteracao.
+//=======================================================================================================
+
+#ifndef BENCH_h
+#define BENCH_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stddef.h>
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+// Impede o compilador de descartar um resultado que nao e usado
+#define BENCH_KEEP(p) __asm__ volatile("" : : "g"(p) : "memory")
+
+//=======================================================================================================
+//--- Types ---
+
+typedef uint64_t (*bench_fn_t)(uint64_t iters, void *ctx);
+
+typedef struct{
+    const char *name;
+    bench_fn_t  fn;
+    void       *ctx;
+}bench_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+int      bench_run_all(const bench_t *list, size_t n, int argc, char **argv);  // Executa e grava JSON
+uint64_t bench_alloc_count(void);                                              // Alocacoes desde o inicio
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
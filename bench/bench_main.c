@@ -0,0 +1,563 @@
+//=======================================================================================================
+//
+//   Title: Receiver hot-path benchmarks.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Uso: telemetry_bench [--corpus=arquivo] [opcoes do harness, ver bench.c]
+//   Sem --corpus usa um voo sintetico de 4096 frames. Os benchmarks BM_PipelineNodes* usam sempre
+//   corpora sinteticos com cabecalho de enlace (1 e 8 transmissores).
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "bench.h"
+#include "corpus.h"
+#include "telemetry.h"
+#include "geo.h"
+#include "sample_ring.h"
+#include "uplink.h"
+#include "lat_hist.h"
+#include "link.h"
+#include "nodes.h"
+#include "fec.h"
+#include "delta.h"
+#include "integrity.h"
+#include "pktpool.h"
+#include "metrics.h"
+#include "alarm.h"
+#include "display.h"
+
+//=======================================================================================================
+//--- Variaveis ---
+static corpus_t            Corpus;
+static telemetry_sample_t *Parsed;                          // Corpus ja decodificado (entrada dos estagios seguintes)
+static size_t              NParsed;
+static corpus_t            Nodes1, Nodes8;                  // Corpora com cabecalho de enlace
+static uint8_t           (*Delta)[DELTA_FRAME_MAX];         // Corpus decodificado recodificado em keyframe/delta
+static uint8_t            *DeltaLen;
+
+//=======================================================================================================
+//--- Benchmarks ---
+
+// Frame ASCII -> amostra (inclui a conversao das coordenadas)
+static uint64_t BM_TelemetryParse(uint64_t iters, void *ctx)
+{
+  telemetry_sample_t s;
+  uint64_t ok = 0;
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    size_t k = i % Corpus.n;
+    ok += telemetry_parse(Corpus.frame[k], Corpus.len[k], &s);
+    BENCH_KEEP(&s);
+  }//end for
+  BENCH_KEEP(ok);
+  return iters;
+}//end BM_TelemetryParse
+
+// So o campo de coordenada NMEA
+static uint64_t BM_CoordDecode(uint64_t iters, void *ctx)
+{
+  static const char *lat[] = {"2333.03012", "2332.99871", "0000.00010", "8959.99999"};
+  int64_t acc = 0;
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    const char *c = lat[i & 3];
+    acc += telemetry_parse_coord(c, 10, (i & 4) ? 'S' : 'N');
+  }//end for
+  BENCH_KEEP(acc);
+  return iters;
+}//end BM_CoordDecode
+
+// Range/bearing/elevation por amostra (caminho CONFIG_GEO_FAST_TRIG)
+static uint64_t BM_GeoUpdate(uint64_t iters, void *ctx)
+{
+  geo_station_t st;
+  geo_set_station(&st, -235505000, -466333000, 760.0f);
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    telemetry_sample_t s = Parsed[i % NParsed];
+    geo_update(&st, &s);
+    BENCH_KEEP(&s);
+  }//end for
+  return iters;
+}//end BM_GeoUpdate
+
+// Velocidade vertical, janelas min/max, EWMA e fases por amostra (amostras a 10 Hz)
+static uint64_t BM_MetricsUpdate(uint64_t iters, void *ctx)
+{
+  metrics_t m = {0};
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    telemetry_sample_t s = Parsed[i % NParsed];
+    s.t_sample_us = (int64_t)i * 100000;
+    metrics_update(&m, &s);
+    BENCH_KEEP(&s);
+  }//end for
+  return iters;
+}//end BM_MetricsUpdate
+
+// Regras de alarme por amostra: 8 regras de amostra + 1 de enlace, nenhuma disparando (caso comum)
+static uint64_t BM_AlarmEval(uint64_t iters, void *ctx)
+{
+  static const alarm_rule_t rules[] = {
+    {.threshold = 85.0f,    .field = ALARM_F_TEMP,     .op = ALARM_GT, .node = ALARM_NODE_ANY},
+    {.threshold = -40.0f,   .field = ALARM_F_TEMP,     .op = ALARM_LT, .node = ALARM_NODE_ANY},
+    {.threshold = 1e6f,     .field = ALARM_F_ALT,      .op = ALARM_GT, .node = ALARM_NODE_ANY},
+    {.threshold = -1e4f,    .field = ALARM_F_VZ,       .op = ALARM_LT, .node = ALARM_NODE_ANY},
+    {.threshold = 1000.0f,  .field = ALARM_F_PITCH,    .op = ALARM_GT, .node = ALARM_NODE_ANY},
+    {.threshold = -200.0f,  .field = ALARM_F_RSSI,     .op = ALARM_LT, .node = ALARM_NODE_ANY},
+    {.threshold = 1.0f,     .field = ALARM_F_PRESSURE, .op = ALARM_LT, .node = ALARM_NODE_ANY},
+    {.threshold = 1e7f,     .field = ALARM_F_RANGE,    .op = ALARM_GT, .node = ALARM_NODE_ANY},
+    {.threshold = 10.0f,    .field = ALARM_F_LINK,     .op = ALARM_GT, .node = ALARM_NODE_ANY},
+  };
+  alarm_state_t a = {0};
+  alarm_set_rules(rules, sizeof(rules) / sizeof(rules[0]));
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    telemetry_sample_t s = Parsed[i % NParsed];
+    s.t_rx_us = (int64_t)i * 100000;
+    alarm_eval(&a, &s);
+    BENCH_KEEP(&s);
+  }//end for
+  alarm_set_rules(NULL, 0);
+  return iters;
+}//end BM_AlarmEval
+
+// Painel 16x2 do MenuDashboard por amostra (escalas DASH_* do main.c): quadro composto inteiro, diff e
+// flush no driver de mentira
+static uint64_t BM_DispDashboard(uint64_t iters, void *ctx)
+{
+  char     line[DISP_COLS_MAX + 1];
+  float    spark[5];
+  uint32_t bytes = 0;
+
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    const telemetry_sample_t *s = &Parsed[i % NParsed];
+    for(int k = 0; k < 5; k++)
+      spark[k] = Parsed[(i + k) % NParsed].altitude;
+    snprintf(line, sizeof(line), "%5.0fm%+4.0f", s->altitude, s->speed);
+    disp_FbClear();
+    disp_FbPuts(0, 0, line);
+    disp_FbSpark(0, 11, spark, 5);
+    disp_FbPutc(1, 0, 'S');
+    disp_FbPutc(1, 1, 'R');
+    disp_FbBar(1, 2, 3, (float)(s->rssi + 120) / 80.0f);
+    disp_FbPutc(1, 5, 'S');
+    disp_FbBar(1, 6, 2, (float)(s->SNR + 20) / 30.0f);
+    disp_FbPuts(1, 9, "   --- ");
+    bytes += disp_Flush();
+  }//end for
+  BENCH_KEEP(bytes);
+  return iters;
+}//end BM_DispDashboard
+
+// Referencia: o mesmo atan2 pela libm
+static uint64_t BM_Atan2Libm(uint64_t iters, void *ctx)
+{
+  float acc = 0;
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    float y = (float)(int32_t)(i * 2654435761u) * 1e-6f;
+    acc += atan2f(y, 1234.5f) * 57.29578f;
+  }//end for
+  BENCH_KEEP(acc);
+  return iters;
+}//end BM_Atan2Libm
+
+static uint64_t BM_Atan2Fast(uint64_t iters, void *ctx)
+{
+  float acc = 0;
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    float y = (float)(int32_t)(i * 2654435761u) * 1e-6f;
+    acc += geo_atan2(y, 1234.5f);
+  }//end for
+  BENCH_KEEP(acc);
+  return iters;
+}//end BM_Atan2Fast
+
+// Registro CSV do uplink
+static uint64_t BM_UplinkFormatCsv(uint64_t iters, void *ctx)
+{
+  char   buf[UPLINK_LINE_MAX];
+  size_t bytes = 0;
+  for(uint64_t i = 0; i < iters; i++)
+    bytes += uplink_format_csv(&Parsed[i % NParsed], buf, sizeof(buf));
+  BENCH_KEEP(bytes);
+  return iters;
+}//end BM_UplinkFormatCsv
+
+static uint64_t BM_UplinkFormatJson(uint64_t iters, void *ctx)
+{
+  char   buf[UPLINK_LINE_MAX];
+  size_t bytes = 0;
+  for(uint64_t i = 0; i < iters; i++)
+    bytes += uplink_format_json(&Parsed[i % NParsed], buf, sizeof(buf));
+  BENCH_KEEP(bytes);
+  return iters;
+}//end BM_UplinkFormatJson
+
+// Push + pop intercalados (produtor e um consumidor no mesmo nucleo: custo puro da estrutura)
+static uint64_t BM_SampleRingPushPop(uint64_t iters, void *ctx)
+{
+  static sample_ring_t ring;
+  sample_reader_t      rd;
+  telemetry_sample_t   out;
+
+  sample_ring_init(&ring);
+  sample_ring_reader_init(&ring, &rd);
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    sample_ring_push(&ring, &Parsed[i % NParsed]);
+    sample_ring_pop(&ring, &rd, &out);
+    BENCH_KEEP(&out);
+  }//end for
+  return iters;
+}//end BM_SampleRingPushPop
+
+// Pacote do radio para os dois taps e de volta ao pool: get, publish, take e os tres put (items/s
+// zerado se algum buffer nao voltar ao pool)
+static uint64_t BM_PktPoolHandoff(uint64_t iters, void *ctx)
+{
+  pktpool_init();
+  pktpool_tap(PKT_TAP_FLASHLOG, true);
+  pktpool_tap(PKT_TAP_CAPTURE, true);
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    pkt_buf_t *p = pktpool_get();
+    p->len = (uint16_t)Corpus.len[i % Corpus.n];
+    pktpool_publish(p);
+    pktpool_put(p);
+    pktpool_put(pktpool_take(PKT_TAP_FLASHLOG));
+    pktpool_put(pktpool_take(PKT_TAP_CAPTURE));
+  }//end for
+  pkt_stats_t st;
+  pktpool_get_stats(&st);
+  BENCH_KEEP(st.received);
+  return st.free == st.size && st.exhausted == 0 ? iters : 0;
+}//end BM_PktPoolHandoff
+
+static uint64_t BM_LatHistAdd(uint64_t iters, void *ctx)
+{
+  lat_hist_t h;
+  lat_hist_reset(&h);
+  for(uint64_t i = 0; i < iters; i++)
+    lat_hist_add(&h, (int64_t)((i * 2654435761u) & 0xFFFFF));
+  BENCH_KEEP(&h);
+  return iters;
+}//end BM_LatHistAdd
+
+// Pipeline completo do ReceiveLoraData + DataExcel: parse, geo, ring, CSV
+static uint64_t BM_Pipeline(uint64_t iters, void *ctx)
+{
+  static sample_ring_t ring;
+  sample_reader_t      rd;
+  geo_station_t        st;
+  telemetry_sample_t   s, out;
+  char                 buf[UPLINK_LINE_MAX];
+  size_t               bytes = 0;
+
+  sample_ring_init(&ring);
+  sample_ring_reader_init(&ring, &rd);
+  geo_set_station(&st, -235505000, -466333000, 760.0f);
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    size_t k = i % Corpus.n;
+    if(!telemetry_parse(Corpus.frame[k], Corpus.len[k], &s))
+      continue;
+    geo_update(&st, &s);
+    sample_ring_push(&ring, &s);
+    while(sample_ring_pop(&ring, &rd, &out))
+      bytes += uplink_format_csv(&out, buf, sizeof(buf));
+  }//end for
+  BENCH_KEEP(bytes);
+  return iters;
+}//end BM_Pipeline
+
+// Mesmo pipeline com a checagem de integridade e o demultiplexador por no do ReceiveLoraData
+// (ctx = corpus com cabecalho e trailer)
+static uint64_t BM_PipelineNodes(uint64_t iters, void *ctx)
+{
+  static sample_ring_t ring;
+  const corpus_t      *c = ctx;
+  sample_reader_t      rd;
+  geo_station_t        st;
+  link_frame_t         f;
+  telemetry_sample_t   s, out;
+  char                 buf[UPLINK_LINE_MAX];
+  size_t               bytes = 0;
+
+  nodes_reset();
+  sample_ring_init(&ring);
+  sample_ring_reader_init(&ring, &rd);
+  geo_set_station(&st, -235505000, -466333000, 760.0f);
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    size_t        k = i % c->n;
+    size_t        n = integ_check((const uint8_t *)c->frame[k], c->len[k]);
+    node_state_t *node;
+    if(n == 0 || !link_decode((const uint8_t *)c->frame[k], n, &f) || f.type != LINK_T_ASCII
+       || (node = node_get(f.node)) == NULL)
+      continue;
+    node_rx(node, &f, -80, (int64_t)i);
+    if(!telemetry_parse((const char *)f.payload, f.plen, &s))
+    {
+      node->bad++;
+      continue;
+    }//end if
+    s.node        = f.node;
+    s.t_sample_us = (int64_t)i * 100000;
+    geo_update(&st, &s);
+    metrics_update(&node->metrics, &s);
+    node->last     = s;
+    node->ring_idx = sample_ring_push(&ring, &s);
+    while(sample_ring_pop(&ring, &rd, &out))
+      bytes += uplink_format_csv(&out, buf, sizeof(buf));
+  }//end for
+  BENCH_KEEP(bytes);
+  return iters;
+}//end BM_PipelineNodes
+
+// Decodificador FEC: um grupo com um frame perdido (K-1 dados + paridade -> frame refeito)
+static uint64_t BM_FecDecode(uint64_t iters, void *ctx)
+{
+  static uint8_t parity[64][FEC_PARITY_MAX];
+  static size_t  plen[64];
+  fec_state_t    rx;
+  fec_enc_t      tx;
+  uint8_t        out[FEC_FRAME_MAX], outSeq;
+  size_t         bytes = 0;
+
+  // Paridades dos primeiros 64 grupos do corpus, fora do tempo medido (o harness chama de novo a cada rodada)
+  fec_enc_reset(&tx);
+  for(size_t g = 0; g < 64; g++)
+  {
+    for(size_t j = 0; j < FEC_K; j++)
+    {
+      size_t k = (g * FEC_K + j) % Corpus.n;
+      fec_enc_add(&tx, (const uint8_t *)Corpus.frame[k], Corpus.len[k] < FEC_FRAME_MAX ? Corpus.len[k] : FEC_FRAME_MAX);
+    }//end for
+    plen[g] = fec_enc_parity(&tx, parity[g], FEC_PARITY_MAX);
+  }//end for
+
+  fec_reset(&rx);
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    size_t  g    = i % 64;
+    uint8_t base = (uint8_t)(i * FEC_K);
+    for(size_t j = 1; j < FEC_K; j++)                          // Frame 0 do grupo perdido
+    {
+      size_t k = (g * FEC_K + j) % Corpus.n;
+      fec_data(&rx, (uint8_t)(base + j), (const uint8_t *)Corpus.frame[k],
+               Corpus.len[k] < FEC_FRAME_MAX ? Corpus.len[k] : FEC_FRAME_MAX);
+    }//end for
+    bytes += fec_parity(&rx, base, parity[g], plen[g], out, &outSeq);
+  }//end for
+  BENCH_KEEP(bytes);
+  return iters;
+}//end BM_FecDecode
+
+// Custo da checagem de integridade por frame (frames do corpus, ~70 B)
+static uint64_t BM_Crc16(uint64_t iters, void *ctx)
+{
+  uint32_t acc = 0;
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    size_t k = i % Corpus.n;
+    acc += integ_crc16((const uint8_t *)Corpus.frame[k], Corpus.len[k]);
+  }//end for
+  BENCH_KEEP(acc);
+  return iters;
+}//end BM_Crc16
+
+static uint64_t BM_SipHash(uint64_t iters, void *ctx)
+{
+  static const uint8_t key[INTEG_KEY_LEN] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+  uint64_t acc = 0;
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    size_t k = i % Corpus.n;
+    acc += integ_siphash(key, (const uint8_t *)Corpus.frame[k], Corpus.len[k]);
+  }//end for
+  BENCH_KEEP(acc);
+  return iters;
+}//end BM_SipHash
+
+// Amostra -> frame keyframe/delta (lado do transmissor)
+static uint64_t BM_DeltaEncode(uint64_t iters, void *ctx)
+{
+  delta_enc_t e;
+  uint8_t     buf[DELTA_FRAME_MAX];
+  size_t      bytes = 0;
+
+  delta_enc_reset(&e);
+  for(uint64_t i = 0; i < iters; i++)
+    bytes += delta_encode(&e, &Parsed[i % NParsed], 0, (uint8_t)i, buf, sizeof(buf));
+  BENCH_KEEP(bytes);
+  return iters;
+}//end BM_DeltaEncode
+
+// Frame keyframe/delta -> amostra (comparar com BM_TelemetryParse)
+static uint64_t BM_DeltaDecode(uint64_t iters, void *ctx)
+{
+  delta_state_t      d;
+  link_frame_t       f;
+  telemetry_sample_t s;
+  size_t             ok = 0;
+
+  delta_reset(&d);
+  for(uint64_t i = 0; i < iters; i++)
+  {
+    size_t k = i % NParsed;
+    link_decode(Delta[k], DeltaLen[k], &f);
+    ok += delta_decode(&d, &f, &s);
+    BENCH_KEEP(&s);
+  }//end for
+  BENCH_KEEP(ok);
+  return iters;
+}//end BM_DeltaDecode
+
+// Confere que keyframe/delta reproduz as amostras do frame ASCII e resume o ganho
+static int DeltaPrepare(void)
+{
+  delta_enc_t   e;
+  delta_state_t d;
+  link_frame_t  f;
+  size_t        ascii = 0, bin = 0;
+
+  Delta    = calloc(NParsed, DELTA_FRAME_MAX);
+  DeltaLen = calloc(NParsed, 1);
+  delta_enc_reset(&e);
+  delta_reset(&d);
+  for(size_t i = 0; i < NParsed; i++)
+  {
+    telemetry_sample_t s;
+    const telemetry_sample_t *r = &Parsed[i];
+    DeltaLen[i] = (uint8_t)delta_encode(&e, &Parsed[i], 0, (uint8_t)i, Delta[i], DELTA_FRAME_MAX);
+    if(!link_decode(Delta[i], DeltaLen[i], &f) || !delta_decode(&d, &f, &s))
+      return -1;
+    // Mesma resolucao do ASCII: diferenca so de arredondamento (e "-0.00" vira 0)
+    if(fabsf(s.anglePitchDeg - r->anglePitchDeg) > 0.001f || fabsf(s.angleRollDeg - r->angleRollDeg) > 0.001f
+       || fabsf(s.temp - r->temp) > 0.001f || fabsf(s.altitude - r->altitude) > 0.001f
+       || fabsf(s.speed - r->speed) > 0.0001f || s.pressure_bmp != r->pressure_bmp || s.SNR != r->SNR
+       || s.lat_e7 != r->lat_e7 || s.lon_e7 != r->lon_e7 || s.flags != r->flags)
+    {
+      fprintf(stderr, "delta: amostra %zu difere do ASCII\n", i);
+      return -1;
+    }//end if
+    bin += DeltaLen[i];
+  }//end for
+  for(size_t i = 0; i < Corpus.n; i++)
+    ascii += Corpus.len[i];
+  // Delta so codifica os frames validos; compara pela media por frame
+  fprintf(stderr, "delta: %.1f B/amostra (ASCII %.1f B); keyframe a cada %d\n",
+          (double)bin / NParsed, (double)ascii / Corpus.n, DELTA_KEY_INTERVAL);
+  return 0;
+}//end DeltaPrepare
+
+static const bench_t Benchmarks[] = {
+  {"BM_TelemetryParse",    BM_TelemetryParse,    NULL},
+  {"BM_CoordDecode",       BM_CoordDecode,       NULL},
+  {"BM_GeoUpdate",         BM_GeoUpdate,         NULL},
+  {"BM_MetricsUpdate",     BM_MetricsUpdate,     NULL},
+  {"BM_AlarmEval",         BM_AlarmEval,         NULL},
+  {"BM_DispDashboard",     BM_DispDashboard,     NULL},
+  {"BM_Atan2Libm",         BM_Atan2Libm,         NULL},
+  {"BM_Atan2Fast",         BM_Atan2Fast,         NULL},
+  {"BM_UplinkFormatCsv",   BM_UplinkFormatCsv,   NULL},
+  {"BM_UplinkFormatJson",  BM_UplinkFormatJson,  NULL},
+  {"BM_SampleRingPushPop", BM_SampleRingPushPop, NULL},
+  {"BM_PktPoolHandoff",    BM_PktPoolHandoff,    NULL},
+  {"BM_LatHistAdd",        BM_LatHistAdd,        NULL},
+  {"BM_Pipeline",          BM_Pipeline,          NULL},
+  {"BM_PipelineNodes1",    BM_PipelineNodes,     &Nodes1},
+  {"BM_PipelineNodes8",    BM_PipelineNodes,     &Nodes8},
+  {"BM_FecDecode",         BM_FecDecode,         NULL},
+  {"BM_Crc16",             BM_Crc16,             NULL},
+  {"BM_SipHash",           BM_SipHash,           NULL},
+  {"BM_DeltaEncode",       BM_DeltaEncode,       NULL},
+  {"BM_DeltaDecode",       BM_DeltaDecode,       NULL},
+};
+
+//=======================================================================================================
+//--- Display de mentira ---
+// O display.c sem CONFIG_DISPLAY_SSD1306 usa DisplayHd44780: aqui o blit so soma as celulas e o flush
+// devolve os bytes do modelo do lcd_jr.c (como no lora_displaycheck), sem I2C no meio.
+static uint32_t DispSeq;
+
+static esp_err_t DispStubInit(void)
+{
+  return ESP_OK;
+}//end DispStubInit
+
+static void DispStubBlit(uint8_t row, uint8_t col, const uint8_t *cells, uint8_t n)
+{
+  DispSeq += 1u + n;
+  BENCH_KEEP(cells);
+}//end DispStubBlit
+
+static uint32_t DispStubFlush(void)
+{
+  uint32_t sent = DispSeq ? DispSeq * 6u + 1u : 0u;
+  DispSeq = 0;
+  return sent;
+}//end DispStubFlush
+
+const display_ops_t DisplayHd44780 = {"stub", 16, 2, DispStubInit, DispStubBlit, DispStubFlush};
+
+//=======================================================================================================
+//--- main ---
+int main(int argc, char **argv)
+{
+  const char *corpusPath = NULL;
+  int         nargs = 1;
+
+  // Separa a opcao propria das opcoes do harness
+  for(int i = 1; i < argc; i++)
+  {
+    if(strncmp(argv[i], "--corpus=", 9) == 0)
+      corpusPath = argv[i] + 9;
+    else
+      argv[nargs++] = argv[i];
+  }//end for
+
+  if(corpusPath ? corpus_load(&Corpus, corpusPath) : corpus_generate(&Corpus, 4096, 0, 0x5EED))
+  {
+    fprintf(stderr, "falha carregando corpus %s\n", corpusPath ? corpusPath : "(sintetico)");
+    return 1;
+  }//end if
+
+  Parsed = calloc(Corpus.n, sizeof(*Parsed));
+  for(size_t i = 0; i < Corpus.n; i++)
+  {
+    if(telemetry_parse(Corpus.frame[i], Corpus.len[i], &Parsed[NParsed]))
+      NParsed++;
+  }//end for
+  fprintf(stderr, "corpus: %zu frames, %zu validos\n", Corpus.n, NParsed);
+  if(corpus_generate(&Nodes1, 4096, 1, 0x5EED) || corpus_generate(&Nodes8, 4096, 8, 0x5EED))
+    return 1;
+  if(DeltaPrepare())
+    return 1;
+  if(disp_Start() != ESP_OK)
+    return 1;
+  if(NParsed == 0)
+    return 1;
+
+  int ret = bench_run_all(Benchmarks, sizeof(Benchmarks) / sizeof(Benchmarks[0]), nargs, argv);
+  free(Parsed);
+  corpus_free(&Corpus);
+  corpus_free(&Nodes1);
+  corpus_free(&Nodes8);
+  free(Delta);
+  free(DeltaLen);
+  return ret;
+}//end main
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,261 @@
+//=======================================================================================================
+//
+//   Title: LoRa channel simulator (ALOHA x TDMA goodput).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Uso: lora_chansim [--profile=0|1|2] [--frame=bytes] [--period-ms=ms] [--seconds=s] [--nodes=max]
+//
+//   Para 1..max transmissores simula o mesmo intervalo de tempo nos dois esquemas e imprime CSV:
+//     - ALOHA: cada no transmite a cada period-ms (+-10% de jitter, fase aleatoria), como hoje;
+//     - TDMA:  tdma.c real; nos entram pelo slot de entrada (backoff exponencial) e depois usam o slot
+//              anunciado no beacon, com jitter de acordar de +-GUARD_US/2 e deriva de ate TDMA_DRIFT_PPM/2.
+//              join_s = instante em que o ultimo no ganhou slot (inclui-se no goodput).
+//   Modelo de canal: qualquer sobreposicao no ar perde os dois frames (sem efeito captura) e o
+//   receptor nao recebe enquanto transmite o beacon. Goodput = frames entregues por segundo.
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "radio.h"
+#include "tdma.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define NODES_MAX   TDMA_SLOTS_MAX
+#define GUARD_US    2000                      // Mesmo default do menuconfig (CONFIG_TDMA_GUARD_US)
+#define LEAD_US     25000                     // CONFIG_TDMA_LEAD_US
+
+//=======================================================================================================
+//--- Types ---
+typedef struct{
+    int64_t start;
+    int64_t end;
+    int8_t  node;                             // -1 = beacon do receptor
+    bool    lost;
+}tx_t;
+
+typedef struct{
+    tx_t  *v;
+    size_t n, cap;
+}tx_list_t;
+
+typedef struct{
+    double offered;                           // Frames/s tentados
+    double goodput;                           // Frames/s entregues
+    double cycle_ms;                          // So TDMA
+    double join_s;                            // So TDMA: todos os nos com slot
+}result_t;
+
+//=======================================================================================================
+//--- Variaveis ---
+static uint32_t Seed = 0x5EED;
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- rnd ---
+static uint32_t rnd(void)
+{
+  Seed ^= Seed << 13;
+  Seed ^= Seed >> 17;
+  Seed ^= Seed << 5;
+  return Seed;
+}//end rnd
+
+static int64_t rnd_range(int64_t lo, int64_t hi)
+{
+  return hi > lo ? lo + (int64_t)(rnd() % (uint64_t)(hi - lo)) : lo;
+}//end rnd_range
+
+//=======================================================================================================
+//--- tx_add ---
+static void tx_add(tx_list_t *l, int64_t start, uint32_t air, int8_t node)
+{
+  if(l->n == l->cap)
+  {
+    l->cap = l->cap ? l->cap * 2 : 1024;
+    l->v   = realloc(l->v, l->cap * sizeof(tx_t));
+  }//end if
+  l->v[l->n++] = (tx_t){start, start + air, node, false};
+}//end tx_add
+
+static int tx_cmp(const void *a, const void *b)
+{
+  const tx_t *x = a, *y = b;
+  return (x->start > y->start) - (x->start < y->start);
+}//end tx_cmp
+
+//=======================================================================================================
+//--- collide ---
+// Ordena por inicio e marca como perdido tudo que se sobrepoe a outra transmissao.
+// Devolve quantos frames de transmissores (node >= 0) chegaram inteiros.
+static size_t collide(tx_list_t *l, size_t from)
+{
+  tx_t  *v = l->v + from;
+  size_t n = l->n - from;
+  size_t ok = 0;
+
+  qsort(v, n, sizeof(tx_t), tx_cmp);
+  int64_t maxEnd = INT64_MIN;
+  size_t  maxIdx = 0;
+  for(size_t i = 0; i < n; i++)
+  {
+    if(v[i].start < maxEnd)
+    {
+      v[i].lost = true;
+      v[maxIdx].lost = true;
+    }//end if
+    if(v[i].end > maxEnd)
+    {
+      maxEnd = v[i].end;
+      maxIdx = i;
+    }//end if
+  }//end for
+  for(size_t i = 0; i < n; i++)
+    ok += (v[i].node >= 0 && !v[i].lost);
+  return ok;
+}//end collide
+
+//=======================================================================================================
+//--- sim_aloha ---
+static result_t sim_aloha(const radio_profile_t *p, size_t frame, int nodes, uint32_t period_us, int64_t dur_us)
+{
+  tx_list_t l = {0};
+  uint32_t  air = radio_airtime_us(p, frame);
+  size_t    tried = 0;
+
+  for(int k = 0; k < nodes; k++)
+  {
+    int64_t t = rnd_range(0, period_us);
+    while(t < dur_us)
+    {
+      tx_add(&l, t, air, (int8_t)k);
+      tried++;
+      t += air + rnd_range(period_us - period_us / 10, period_us + period_us / 10);
+    }//end while
+  }//end for
+  size_t ok = collide(&l, 0);
+  free(l.v);
+  return (result_t){tried * 1e6 / dur_us, ok * 1e6 / dur_us, 0.0, 0.0};
+}//end sim_aloha
+
+//=======================================================================================================
+//--- sim_tdma ---
+// Ciclo a ciclo: o receptor planeja com o que ouviu no ciclo anterior, como no firmware.
+static result_t sim_tdma(const radio_profile_t *p, size_t frame, int nodes, uint32_t period_us, int64_t dur_us)
+{
+  tdma_t    t;
+  tx_list_t l = {0};
+  size_t    tried = 0, ok = 0, cycles = 0;
+  int32_t   ppm[NODES_MAX];
+  uint8_t   window[NODES_MAX], backoff[NODES_MAX];
+  double    cycleSum = 0;
+  int64_t   joined = -1;
+
+  tdma_init(&t, p, frame, GUARD_US, LEAD_US, period_us);
+  for(int k = 0; k < nodes; k++)
+  {
+    ppm[k]     = (int32_t)rnd_range(-TDMA_DRIFT_PPM / 2, TDMA_DRIFT_PPM / 2 + 1);
+    window[k]  = 1;
+    backoff[k] = 0;
+  }//end for
+
+  for(int64_t now = 0; now < dur_us; cycles++)
+  {
+    tdma_plan(&t);
+    size_t from = l.n;
+    tx_add(&l, now, t.beacon_us, -1);
+    int64_t ref = now + t.beacon_us;          // Fim do beacon
+
+    if(joined < 0 && t.plan.nslots == nodes)
+      joined = now;
+    for(int k = 0; k < nodes; k++)
+    {
+      bool assigned = false;
+      for(uint8_t i = 0; i < t.plan.nslots; i++)
+        assigned |= (t.plan.order[i] == k);
+      if(assigned)
+        window[k] = 1;
+      else if(backoff[k] > 0)
+      {
+        backoff[k]--;
+        continue;
+      }//end else if
+      else
+      {
+        // Tenta agora; se nao aparecer no proximo beacon, espera ate 'window' ciclos
+        backoff[k] = (uint8_t)(rnd() % window[k]);
+        if(window[k] < TDMA_JOIN_WINDOW_MAX)
+          window[k] *= 2;
+      }//end else
+      int64_t off = tdma_tx_offset_us(&t.plan, (uint8_t)k);
+      off += off * ppm[k] / 1000000 + rnd_range(-GUARD_US / 2, GUARD_US / 2);
+      tx_add(&l, ref + off, radio_airtime_us(p, frame), (int8_t)k);
+      tried++;
+    }//end for
+
+    ok += collide(&l, from);
+    for(size_t i = from; i < l.n; i++)
+    {
+      if(l.v[i].node >= 0 && !l.v[i].lost)
+        tdma_heard(&t, (uint8_t)l.v[i].node);
+    }//end for
+    cycleSum += t.cycle_us;
+    now += t.cycle_us;
+    l.n = 0;                                  // Ciclos nao se sobrepoem: nada a guardar
+  }//end for
+  free(l.v);
+  return (result_t){tried * 1e6 / dur_us, ok * 1e6 / dur_us, cycleSum / cycles / 1000.0,
+                    joined < 0 ? -1.0 : joined / 1e6};
+}//end sim_tdma
+
+//=======================================================================================================
+//--- main ---
+int main(int argc, char **argv)
+{
+  unsigned profile = RADIO_PROFILE_DEFAULT;
+  unsigned frame   = 96;
+  unsigned period  = 1000;
+  unsigned seconds = 3600;
+  unsigned maxN    = NODES_MAX;
+
+  for(int i = 1; i < argc; i++)
+  {
+    if(sscanf(argv[i], "--profile=%u", &profile) == 1) continue;
+    if(sscanf(argv[i], "--frame=%u", &frame) == 1) continue;
+    if(sscanf(argv[i], "--period-ms=%u", &period) == 1) continue;
+    if(sscanf(argv[i], "--seconds=%u", &seconds) == 1) continue;
+    if(sscanf(argv[i], "--nodes=%u", &maxN) == 1) continue;
+    fprintf(stderr, "opcao desconhecida: %s\n", argv[i]);
+    return 2;
+  }//end for
+
+  const radio_profile_t *p = radio_profile((uint8_t)profile);
+  if(!p || frame == 0 || frame > 255 || maxN == 0 || maxN > NODES_MAX || period == 0)
+  {
+    fprintf(stderr, "parametros invalidos\n");
+    return 2;
+  }//end if
+
+  int64_t dur = (int64_t)seconds * 1000000;
+  printf("# perfil %s SF%u BW%lu CR4/%u, frame %u B = %lu us no ar, periodo %u ms\n", p->name, p->sf,
+         (unsigned long)p->bw_hz, p->cr, frame, (unsigned long)radio_airtime_us(p, frame), period);
+  printf("nodes,aloha_offered_fps,aloha_goodput_fps,aloha_loss_pct,tdma_cycle_ms,tdma_join_s,tdma_offered_fps,tdma_goodput_fps,tdma_loss_pct\n");
+  for(unsigned n = 1; n <= maxN; n++)
+  {
+    result_t a = sim_aloha(p, frame, (int)n, period * 1000u, dur);
+    result_t t = sim_tdma(p, frame, (int)n, period * 1000u, dur);
+    printf("%u,%.3f,%.3f,%.1f,%.1f,%.1f,%.3f,%.3f,%.1f\n", n,
+           a.offered, a.goodput, a.offered > 0 ? 100.0 * (1.0 - a.goodput / a.offered) : 0.0,
+           t.cycle_ms, t.join_s, t.offered, t.goodput, t.offered > 0 ? 100.0 * (1.0 - t.goodput / t.offered) : 0.0);
+  }//end for
+  return 0;
+}//end main
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,164 @@
+//=======================================================================================================
+//
+//   Title: Frame corpora for the host benchmarks.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "corpus.h"
+#include "link.h"
+#include "integrity.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define NOFIX_PERCENT 5
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- rnd ---
+// xorshift32: deterministico para que os numeros sejam comparaveis entre execucoes
+static uint32_t rnd(uint32_t *s)
+{
+  uint32_t x = *s;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  return *s = x;
+}//end rnd
+
+static float rndf(uint32_t *s, float lo, float hi)
+{
+  return lo + (hi - lo) * (float)(rnd(s) & 0xFFFFFF) / (float)0xFFFFFF;
+}//end rndf
+
+//=======================================================================================================
+//--- fmt_nmea ---
+// Graus decimais -> ddmm.mmmmm / dddmm.mmmmm
+static void fmt_nmea(char *dst, size_t size, double deg, int degDigits)
+{
+  double a   = fabs(deg);
+  int    d   = (int)a;
+  double min = (a - d) * 60.0;
+  if(min >= 59.999995)                        // Arredondamento do %.5f nao pode gerar "60.00000"
+  {
+    d++;
+    min = 0.0;
+  }//end if
+  snprintf(dst, size, "%0*d%08.5f", degDigits, d, min);
+}//end fmt_nmea
+
+//=======================================================================================================
+//--- corpus_alloc ---
+static int corpus_alloc(corpus_t *c, size_t n)
+{
+  c->frame = calloc(n, CORPUS_FRAME_MAX);
+  c->len   = calloc(n, sizeof(uint16_t));
+  c->n     = 0;
+  return (c->frame && c->len) ? 0 : -1;
+}//end corpus_alloc
+
+//=======================================================================================================
+//--- corpus_generate ---
+int corpus_generate(corpus_t *c, size_t n, uint8_t nodes, uint32_t seed)
+{
+  uint8_t  seq[LINK_NODE_MAX] = {0};
+  uint32_t s   = seed ? seed : 1;
+  double   lat = -23.5505, lon = -46.6333;
+  float    alt = 760.0f, vz = 0.0f;
+
+  if(corpus_alloc(c, n))
+    return -1;
+
+  for(size_t i = 0; i < n; i++)
+  {
+    // Perfil: motor por 5% dos frames, depois balistico ate o apogeu e descida sob paraquedas
+    float t = (float)(i % 1000);
+    if(t == 0)      { alt = 760.0f; vz = 0.0f; }
+    if(t < 50)      vz += 4.0f;
+    else if(vz > -8.0f) vz -= 1.0f;
+    alt += vz * 0.1f;
+    if(alt < 760.0f) { alt = 760.0f; vz = 0.0f; }
+    lat += rndf(&s, -2e-6f, 4e-6f);
+    lon += rndf(&s, -2e-6f, 3e-6f);
+
+    char latStr[32] = "", lonStr[32] = "";
+    char latDir[2] = "", lonDir[2] = "";
+    if((rnd(&s) % 100) >= NOFIX_PERCENT)
+    {
+      fmt_nmea(latStr, sizeof(latStr), lat, 2);
+      fmt_nmea(lonStr, sizeof(lonStr), lon, 3);
+      latDir[0] = lat < 0 ? 'S' : 'N';
+      lonDir[0] = lon < 0 ? 'W' : 'E';
+    }//end if
+
+    size_t hdr = 0;
+    if(nodes)
+    {
+      uint8_t node = (uint8_t)(i % nodes);
+      hdr = link_encode_hdr((uint8_t *)c->frame[i], LINK_T_ASCII, node, 0, seq[node]++);
+    }//end if
+
+    int w = (int)hdr + snprintf(c->frame[i] + hdr, CORPUS_FRAME_MAX - hdr, "%.2f!%.2f@%.2f#%luC%sA%s&%s*%s(%.2f)%.3fB%uE",
+                     rndf(&s, -30, 30), rndf(&s, -30, 30), rndf(&s, 18, 32),
+                     (unsigned long)(101325 - (uint32_t)((alt - 760.0f) * 12.0f)),
+                     latStr, latDir, lonStr, lonDir, alt, fabsf(vz) * 3.6f, (unsigned)(rnd(&s) % 12));
+    c->len[i] = (uint16_t)(w < CORPUS_FRAME_MAX ? w : CORPUS_FRAME_MAX - 1);
+    if(nodes)
+      c->len[i] = (uint16_t)integ_append((uint8_t *)c->frame[i], c->len[i], CORPUS_FRAME_MAX);
+    c->n++;
+  }//end for
+  return 0;
+}//end corpus_generate
+
+//=======================================================================================================
+//--- corpus_load ---
+int corpus_load(corpus_t *c, const char *path)
+{
+  FILE *f = fopen(path, "r");
+  if(!f)
+    return -1;
+
+  size_t lines = 0;
+  char   buf[CORPUS_FRAME_MAX];
+  while(fgets(buf, sizeof(buf), f))
+    lines++;
+  rewind(f);
+
+  if(corpus_alloc(c, lines ? lines : 1))
+  {
+    fclose(f);
+    return -1;
+  }//end if
+  while(c->n < lines && fgets(c->frame[c->n], CORPUS_FRAME_MAX, f))
+  {
+    size_t len = strcspn(c->frame[c->n], "\r\n");
+    c->frame[c->n][len] = '\0';
+    if(len == 0)
+      continue;
+    c->len[c->n] = (uint16_t)len;
+    c->n++;
+  }//end while
+  fclose(f);
+  return c->n ? 0 : -1;
+}//end corpus_load
+
+//=======================================================================================================
+//--- corpus_free ---
+void corpus_free(corpus_t *c)
+{
+  free(c->frame);
+  free(c->len);
+  memset(c, 0, sizeof(*c));
+}//end corpus_free
+
+//=======================================================================================================
+//--- End of Program ---
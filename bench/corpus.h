@@ -0,0 +1,45 @@
+//=======================================================================================================
+//
+//   Title: Frame corpora for the host benchmarks.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Gera frames no mesmo formato do transmissor simulando um voo (subida, apogeu, descida com deriva
+//   de GPS), com uma fracao de frames sem fix. Tambem carrega um arquivo com um frame por linha
+//   (ex.: captura do ESP_LOGD do receptor).
+//   Com nodes > 0 cada frame recebe o cabecalho de enlace de um de 'nodes' transmissores, em rodizio,
+//   com sequencia propria por no e trailer de integridade; com nodes = 0 sai o frame ASCII legado.
+//=======================================================================================================
+
+#ifndef CORPUS_h
+#define CORPUS_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stddef.h>
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+#define CORPUS_FRAME_MAX 256
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    char     (*frame)[CORPUS_FRAME_MAX];
+    uint16_t  *len;
+    size_t     n;
+}corpus_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+int  corpus_generate(corpus_t *c, size_t n, uint8_t nodes, uint32_t seed);   // Voo sintetico com n frames
+int  corpus_load(corpus_t *c, const char *path);               // Um frame por linha
+void corpus_free(corpus_t *c);
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
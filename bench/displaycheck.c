@@ -0,0 +1,309 @@
+//=======================================================================================================
+//
+//   Title: Character display layer checks (display.c).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Uso: lora_displaycheck
+//
+//   O display.c real contra um driver de mentira no lugar do DisplayHd44780 (16x2): o blit copia as
+//   celulas para uma tela espelho e conta chamadas e celulas, e o flush devolve os bytes que o
+//   lcd_jr.c poria no I2C (6 por byte do controlador, endereco por sequencia, +1 por transferencia).
+//   Confere que o diff so manda o que mudou, que a tela espelho termina igual ao quadro e as contas de
+//   bytes. Por fim compara, numa subida sintetica, os bytes por volta de 250 ms do Painel com os das
+//   telas de um valor so (Altitude, Velocidade, LoRa) com e sem o quadro. Sai com erro se alguma
+//   verificacao falhar.
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <string.h>
+#include "display.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define CHECK(c) do{ if(!(c)){ printf("FALHA %s:%d: %s\n", __FILE__, __LINE__, #c); Fails++; } }while(0)
+
+#define COLS 16
+#define ROWS 2
+#define BUS(blits, cells) ((blits) + (cells) ? ((blits) + (cells)) * 6u + 1u : 0u)  // Modelo do lcd_jr.c
+
+#define ROUNDS    40                          // Voltas de 250 ms da comparacao (10 s de subida)
+#define SPARK     5                           // Sparkline do Painel no 16x2
+#define SPARK_RND 8                           // Um ponto a cada DASH_SPARK_MS (2 s = 8 voltas)
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static esp_err_t StubInit(void);
+static void      StubBlit(uint8_t row, uint8_t col, const uint8_t *cells, uint8_t n);
+static uint32_t  StubFlush(void);
+
+//=======================================================================================================
+//--- Variaveis ---
+static unsigned Fails;
+static uint8_t  Screen[ROWS][COLS];           // O que o controlador teria na DDRAM
+static unsigned Blits, Cells;                 // Desde o ultimo flush
+static unsigned Flushes;
+
+// Uma amostra por volta: subida a ~8 m/s com RSSI/SNR oscilando
+typedef struct{
+    float alt, vz, speed;
+    int   rssi, snr;
+}sample_t;
+
+typedef void (*screen_fn_t)(const sample_t *s, const float *hist);
+
+// O display.c sem CONFIG_DISPLAY_SSD1306 usa este simbolo
+const display_ops_t DisplayHd44780 = {"stub", COLS, ROWS, StubInit, StubBlit, StubFlush};
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- StubInit ---
+static esp_err_t StubInit(void)
+{
+  memset(Screen, ' ', sizeof(Screen));
+  return ESP_OK;
+}//end StubInit
+
+//=======================================================================================================
+//--- StubBlit ---
+static void StubBlit(uint8_t row, uint8_t col, const uint8_t *cells, uint8_t n)
+{
+  CHECK(row < ROWS && n > 0 && col + n <= COLS);
+  memcpy(&Screen[row][col], cells, n);
+  Blits++;
+  Cells += n;
+}//end StubBlit
+
+//=======================================================================================================
+//--- StubFlush ---
+static uint32_t StubFlush(void)
+{
+  uint32_t sent = BUS(Blits, Cells);
+  Blits   = 0;
+  Cells   = 0;
+  Flushes++;
+  return sent;
+}//end StubFlush
+
+//=======================================================================================================
+//--- row_is ---
+static int row_is(uint8_t row, const char *s)
+{
+  char line[COLS + 1];
+  memcpy(line, Screen[row], COLS);
+  line[COLS] = '\0';
+  return strcmp(line, s) == 0;
+}//end row_is
+
+//=======================================================================================================
+//--- sample ---
+static sample_t sample(unsigned i)
+{
+  sample_t s;
+  s.alt   = 812.0f + 2.1f * i;
+  s.vz    = 8.0f + (float)(i % 3) * 0.4f;
+  s.speed = 28.8f + (float)(i % 5) * 0.35f;
+  s.rssi  = -97 + (int)(i % 4) * 2;
+  s.snr   = 7 - (int)(i % 3);
+  return s;
+}//end sample
+
+//=======================================================================================================
+//--- Telas (mesmo layout do main.c no 16x2) ---
+static void dashboard(const sample_t *s, const float *hist)
+{
+  char line[COLS + 1];
+
+  snprintf(line, sizeof(line), "%5.0fm%+4.0f", s->alt, s->vz);
+  disp_FbClear();
+  disp_FbPuts(0, 0, line);
+  disp_FbSpark(0, COLS - SPARK, hist, SPARK);
+  disp_FbPutc(1, 0, '^');
+  disp_FbPutc(1, 1, 'R');
+  disp_FbBar(1, 2, 3, (float)(s->rssi + 120) / 80.0f);
+  disp_FbPutc(1, 5, 'S');
+  disp_FbBar(1, 6, 2, (float)(s->snr + 20) / 30.0f);
+  disp_FbPuts(1, COLS - 7, "   --- ");
+}//end dashboard
+
+static void altitude(const sample_t *s, const float *hist)
+{
+  char line[COLS + 1];
+
+  (void)hist;
+  snprintf(line, sizeof(line), "%.2f", s->alt);
+  disp_FbClear();
+  disp_FbPuts(0, 0, "Altitude:");
+  disp_FbPuts(1, 0, line);
+}//end altitude
+
+static void velocity(const sample_t *s, const float *hist)
+{
+  char line[COLS + 1];
+
+  (void)hist;
+  snprintf(line, sizeof(line), "%.3f Km/h", s->speed);
+  disp_FbClear();
+  disp_FbPuts(0, 0, "Velocidade:");
+  disp_FbPuts(1, 0, line);
+}//end velocity
+
+static void lora(const sample_t *s, const float *hist)
+{
+  char line[COLS + 1];
+
+  (void)hist;
+  disp_FbClear();
+  snprintf(line, sizeof(line), "SNR:%d", s->snr);
+  disp_FbPuts(0, 0, line);
+  snprintf(line, sizeof(line), "RSSI:%d", s->rssi);
+  disp_FbPuts(1, 0, line);
+  disp_FbBar(0, 10, 6, (float)(s->snr + 20) / 30.0f);
+  disp_FbBar(1, 10, 6, (float)(s->rssi + 120) / 80.0f);
+}//end lora
+
+//=======================================================================================================
+//--- rounds ---
+// Bytes no barramento de ROUNDS voltas de uma tela, depois de ela ja estar no display. full: cada volta
+// manda as duas linhas inteiras (quadro invalidado), o equivalente ao disp_Clear + reescrita de antes.
+static uint32_t rounds(screen_fn_t screen, int full)
+{
+  float    hist[SPARK];
+  sample_t s = sample(0);
+  uint32_t sent = 0;
+
+  for(int k = 0; k < SPARK; k++)
+    hist[k] = s.alt;
+  screen(&s, hist);
+  disp_Flush();                               // Entrada na tela: fora da conta
+  for(unsigned i = 1; i <= ROUNDS; i++)
+  {
+    s = sample(i);
+    if(i % SPARK_RND == 0)
+    {
+      memmove(hist, hist + 1, (SPARK - 1) * sizeof(hist[0]));
+      hist[SPARK - 1] = s.alt;
+    }//end if
+    screen(&s, hist);
+    if(full)
+      disp_Invalidate();
+    sent += disp_Flush();
+  }//end for
+  return sent;
+}//end rounds
+
+//=======================================================================================================
+//--- compare ---
+// O Painel mostra altitude, vz, RSSI e SNR juntos; antes era preciso passar por tres telas. A conta por
+// volta das telas de um valor soma as tres (o que custaria manter os mesmos numeros atualizados).
+static void compare(void)
+{
+  static const screen_fn_t single[] = {altitude, velocity, lora};
+  uint32_t dash = rounds(dashboard, 0);
+  uint32_t each = 0, full = 0;
+
+  for(unsigned k = 0; k < sizeof(single) / sizeof(single[0]); k++)
+  {
+    each += rounds(single[k], 0);
+    full += rounds(single[k], 1);
+  }//end for
+  printf("bytes por volta: painel %.1f, telas de um valor %.1f com quadro e %.1f sem quadro (soma das 3)\n",
+         (double)dash / ROUNDS, (double)each / ROUNDS, (double)full / ROUNDS);
+  CHECK(full == 3u * ROUNDS * BUS(ROWS, ROWS * COLS));
+  CHECK(dash < each && each < full);
+}//end compare
+
+//=======================================================================================================
+//--- main ---
+int main(void)
+{
+  unsigned blits;
+  uint32_t total = 0, sent;
+
+  CHECK(disp_Start() == ESP_OK);
+  CHECK(disp_Cols() == COLS && disp_Rows() == ROWS && strcmp(disp_Name(), "stub") == 0);
+
+  // Tela vazia sobre um display vazio: nada no barramento
+  sent = disp_Flush();
+  CHECK(sent == 0 && Blits == 0);
+
+  // Um texto: os espacos que o display ja tem ficam de fora, tres sequencias ("ALT", "1234", "m")
+  disp_FbPuts(0, 0, "ALT  1234 m");
+  blits = Blits;
+  sent  = disp_Flush();
+  CHECK(blits == 0);                          // O blit so acontece dentro do flush
+  CHECK(sent == BUS(3, 8));
+  CHECK(row_is(0, "ALT  1234 m     "));
+  total += sent;
+
+  // Quadro redesenhado igual (as telas limpam e desenham tudo a cada volta): zero bytes
+  disp_FbClear();
+  disp_FbPuts(0, 0, "ALT  1234 m");
+  sent = disp_Flush();
+  CHECK(sent == 0);
+
+  // Dois digitos separados mudam: duas sequencias
+  disp_FbPuts(0, 5, "7");
+  disp_FbPuts(0, 8, "9");
+  sent = disp_Flush();
+  CHECK(sent == BUS(2, 2));
+  CHECK(row_is(0, "ALT  7239 m     "));
+  total += sent;
+
+  // Digitos vizinhos: uma sequencia so
+  disp_FbPuts(0, 5, "2345");
+  sent = disp_Flush();
+  CHECK(sent == BUS(1, 4));
+  CHECK(row_is(0, "ALT  2345 m     "));
+  total += sent;
+
+  // Corte no fim da linha e fora da tela
+  disp_FbPuts(1, 13, "abcdef");
+  disp_FbPutc(2, 0, 'x');
+  disp_FbPutc(0, COLS, 'x');
+  sent = disp_Flush();
+  CHECK(sent == BUS(1, 3));
+  CHECK(row_is(1, "             abc"));
+  total += sent;
+
+  // Barra de 4 celulas pela metade: 10 quintos = 2 cheias
+  disp_FbClear();
+  disp_FbBar(1, 0, 4, 0.5f);
+  sent = disp_Flush();
+  CHECK(Screen[1][0] == DISP_FULL && Screen[1][1] == DISP_FULL && Screen[1][2] == ' ' && Screen[1][3] == ' ');
+  CHECK(row_is(0, "                "));
+  total += sent;
+
+  // Sparkline: minimo em '_', maximo em bloco cheio
+  const float v[4] = {1.0f, 2.0f, 3.0f, 5.0f};
+  disp_FbSpark(0, 0, v, 4);
+  sent = disp_Flush();
+  CHECK(Screen[0][0] == '_' && Screen[0][3] == DISP_FULL);
+  CHECK(Screen[0][1] == DISP_G_VBAR && Screen[0][2] == DISP_G_VBAR + 1);
+  total += sent;
+
+  // Escrita por fora do quadro (splash, menu antigo): tudo de novo, uma sequencia por linha
+  disp_Invalidate();
+  sent = disp_Flush();
+  CHECK(sent == BUS(ROWS, ROWS * COLS));
+  total += sent;
+  sent = disp_Flush();
+  CHECK(sent == 0);
+
+  CHECK(disp_BusBytes() == total);
+  compare();
+  if(Fails)
+  {
+    fprintf(stderr, "%u verificacoes falharam\n", Fails);
+    return 1;
+  }//end if
+  printf("display ok (%lu bytes no barramento)\n", (unsigned long)disp_BusBytes());
+  return 0;
+}//end main
+
+//=======================================================================================================
+//--- End of Program ---
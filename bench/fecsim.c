@@ -0,0 +1,162 @@
+//=======================================================================================================
+//
+//   Title: FEC loss simulator (goodput x loss rate).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Uso: lora_fecsim [--frames=n] [--burst=media]
+//
+//   Passa um voo sintetico pelo codificador e pelo decodificador reais (fec.c) sobre um canal com
+//   perda independente (Bernoulli) e em rajadas (Gilbert-Elliott, rajada media --burst frames) e
+//   imprime CSV. Todo frame refeito e comparado byte a byte com o original; qualquer diferenca
+//   faz o programa sair com erro, entao ele tambem serve de teste do fec.c.
+//     delivered_pct: frames de dados entregues ao parser / enviados
+//     goodput_ratio: frames entregues por byte no ar, relativo ao modo sem FEC
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "corpus.h"
+#include "link.h"
+#include "fec.h"
+
+//=======================================================================================================
+//--- Types ---
+typedef struct{
+    double p_loss;                            // Perda media
+    double burst;                             // Rajada media (1 = independente)
+    bool   bad;                               // Estado do canal (Gilbert-Elliott)
+}channel_t;
+
+//=======================================================================================================
+//--- Variaveis ---
+static uint32_t Seed = 0x5EED;
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- rndu ---
+static double rndu(void)
+{
+  Seed ^= Seed << 13;
+  Seed ^= Seed >> 17;
+  Seed ^= Seed << 5;
+  return (Seed & 0xFFFFFF) / (double)0x1000000;
+}//end rndu
+
+//=======================================================================================================
+//--- lost ---
+// Gilbert-Elliott com perda total no estado ruim: P(ruim->bom) = 1/rajada e P(bom->ruim) escolhido
+// para a fracao de tempo no estado ruim ser p_loss.
+static bool lost(channel_t *c)
+{
+  if(c->burst <= 1.0)
+    return rndu() < c->p_loss;
+  double r2g = 1.0 / c->burst;
+  double g2r = c->p_loss * r2g / (1.0 - c->p_loss);
+  c->bad = c->bad ? (rndu() >= r2g) : (rndu() < g2r);
+  return c->bad;
+}//end lost
+
+//=======================================================================================================
+//--- run ---
+// Devolve entregues sem FEC/com FEC e bytes no ar de cada modo; mismatch conta frames refeitos errados.
+static void run(const corpus_t *c, size_t frames, channel_t ch, size_t *plain, size_t *fec,
+                size_t *airPlain, size_t *airFec, size_t *mismatch)
+{
+  fec_state_t rx;
+  fec_enc_t   tx;
+  uint8_t     parity[FEC_PARITY_MAX];
+  uint8_t     out[FEC_FRAME_MAX];
+  uint8_t     outSeq;
+
+  fec_reset(&rx);
+  fec_enc_reset(&tx);
+  *plain = *fec = *airPlain = *airFec = *mismatch = 0;
+  for(size_t i = 0; i < frames; i++)
+  {
+    size_t         k   = i % c->n;
+    const uint8_t *p   = (const uint8_t *)c->frame[k];
+    size_t         len = c->len[k] < FEC_FRAME_MAX ? c->len[k] : FEC_FRAME_MAX;
+    uint8_t        seq = (uint8_t)i;
+
+    *airPlain += LINK_HDR_LEN + len;
+    *airFec   += LINK_HDR_LEN + len;
+    if(!lost(&ch))
+    {
+      (*plain)++;
+      (*fec)++;
+      fec_data(&rx, seq, p, len);
+    }//end if
+
+    if(fec_enc_add(&tx, p, len))
+    {
+      size_t plen = fec_enc_parity(&tx, parity, sizeof(parity));
+      *airFec += LINK_HDR_LEN + plen;
+      if(lost(&ch))
+        continue;
+      uint8_t base = (uint8_t)(seq - (FEC_K - 1));
+      size_t  n    = fec_parity(&rx, base, parity, plen, out, &outSeq);
+      if(n)
+      {
+        size_t j  = i - (uint8_t)(seq - outSeq);
+        size_t kj = j % c->n;
+        size_t lj = c->len[kj] < FEC_FRAME_MAX ? c->len[kj] : FEC_FRAME_MAX;
+        if(n != lj || memcmp(out, c->frame[kj], n) != 0)
+          (*mismatch)++;
+        else
+          (*fec)++;
+      }//end if
+    }//end if
+  }//end for
+}//end run
+
+//=======================================================================================================
+//--- main ---
+int main(int argc, char **argv)
+{
+  static const double Loss[] = {0.0, 0.01, 0.02, 0.05, 0.10, 0.15, 0.20, 0.30};
+  unsigned frames = 200000;
+  double   burst  = 3.0;
+  corpus_t c;
+
+  for(int i = 1; i < argc; i++)
+  {
+    if(sscanf(argv[i], "--frames=%u", &frames) == 1) continue;
+    if(sscanf(argv[i], "--burst=%lf", &burst) == 1) continue;
+    fprintf(stderr, "opcao desconhecida: %s\n", argv[i]);
+    return 2;
+  }//end for
+  if(corpus_generate(&c, 4096, 0, 0x5EED))
+    return 1;
+
+  size_t bad = 0;
+  printf("channel,loss_pct,k,plain_delivered_pct,fec_delivered_pct,fec_airtime_overhead_pct,goodput_ratio\n");
+  for(int model = 0; model < 2; model++)
+  {
+    for(size_t i = 0; i < sizeof(Loss) / sizeof(Loss[0]); i++)
+    {
+      channel_t ch = {Loss[i], model ? burst : 1.0, false};
+      size_t plain, fec, airPlain, airFec, mismatch;
+      run(&c, frames, ch, &plain, &fec, &airPlain, &airFec, &mismatch);
+      bad += mismatch;
+      double gp = airFec && plain ? ((double)fec / airFec) / ((double)plain / airPlain) : 0.0;
+      printf("%s,%.0f,%d,%.2f,%.2f,%.1f,%.3f\n", model ? "burst" : "random", Loss[i] * 100, FEC_K,
+             100.0 * plain / frames, 100.0 * fec / frames, 100.0 * ((double)airFec / airPlain - 1.0), gp);
+    }//end for
+  }//end for
+  corpus_free(&c);
+  if(bad)
+  {
+    fprintf(stderr, "%zu frames refeitos diferem do original\n", bad);
+    return 1;
+  }//end if
+  return 0;
+}//end main
+
+//=======================================================================================================
+//--- End of Program ---
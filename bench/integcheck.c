@@ -0,0 +1,121 @@
+//=======================================================================================================
+//
+//   Title: Frame integrity checks (integrity.c, modo SipHash).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Uso: lora_integcheck
+//
+//   Compilado com CONFIG_LINK_INTEGRITY_SIPHASH. Sem chave: nenhum trailer passa (nem CRC, nem o
+//   complemento do CRC, nem lixo) e integ_append recusa. Com chave: vetor de referencia do SipHash,
+//   ida e volta append/check e frame adulterado rejeitado. Sai com erro se alguma verificacao falhar.
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <string.h>
+#include "integrity.h"
+#include "link.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define CHECK(c) do{ if(!(c)){ printf("FALHA %s:%d: %s\n", __FILE__, __LINE__, #c); Fails++; } }while(0)
+
+#if INTEG_TRAILER != 4
+#error "lora_integcheck precisa de CONFIG_LINK_INTEGRITY_SIPHASH"
+#endif
+
+//=======================================================================================================
+//--- Variaveis ---
+static unsigned Fails;
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- frame ---
+// Cabecalho ASCII do no 3 + payload + trailer dado (big-endian); devolve o tamanho.
+static size_t frame(uint8_t *buf, uint32_t trailer)
+{
+  static const char payload[] = "T=21.5";
+  size_t n = 0;
+
+  buf[n++] = LINK_MAGIC | LINK_T_ASCII;
+  buf[n++] = 3 << 4;
+  buf[n++] = 7;
+  memcpy(&buf[n], payload, sizeof(payload) - 1);
+  n += sizeof(payload) - 1;
+  for(int i = 3; i >= 0; i--)
+    buf[n++] = (uint8_t)(trailer >> (8 * i));
+  return n;
+}//end frame
+
+//=======================================================================================================
+//--- check_no_key ---
+static void check_no_key(void)
+{
+  uint8_t  buf[32];
+  size_t   body = frame(buf, 0) - INTEG_TRAILER;
+  uint16_t crc  = integ_crc16(buf, body);
+  uint32_t rej  = integ_rejected();
+
+  CHECK(!integ_has_key());
+  frame(buf, crc);                            // Trailer de quem esta no modo CRC
+  CHECK(integ_check(buf, body + INTEG_TRAILER) == 0);
+  frame(buf, ~(uint32_t)crc);                 // O que o modo sem chave aceitava antes
+  CHECK(integ_check(buf, body + INTEG_TRAILER) == 0);
+  frame(buf, 0);
+  CHECK(integ_check(buf, body + INTEG_TRAILER) == 0);
+  frame(buf, 0xFFFFFFFFu);
+  CHECK(integ_check(buf, body + INTEG_TRAILER) == 0);
+  CHECK(integ_rejected() - rej == 4);
+
+  // Beacon/ACK: nao sai nada que so seria aceito por quem tambem esta sem chave
+  CHECK(integ_append(buf, body, sizeof(buf)) == 0);
+}//end check_no_key
+
+//=======================================================================================================
+//--- check_key ---
+static void check_key(void)
+{
+  uint8_t key[INTEG_KEY_LEN], msg[15], buf[32];
+
+  // Vetor do artigo do SipHash: chave 00..0f, mensagem 00..0e
+  for(uint8_t i = 0; i < sizeof(key); i++)
+    key[i] = i;
+  for(uint8_t i = 0; i < sizeof(msg); i++)
+    msg[i] = i;
+  CHECK(integ_siphash(key, msg, sizeof(msg)) == 0xa129ca6149be45e5ull);
+
+  integ_set_key(key);
+  CHECK(integ_has_key());
+  size_t body = frame(buf, 0) - INTEG_TRAILER;
+  size_t len  = integ_append(buf, body, sizeof(buf));
+  CHECK(len == body + INTEG_TRAILER);
+  CHECK(integ_check(buf, len) == body);
+  buf[LINK_HDR_LEN] ^= 0x01;                  // Payload adulterado
+  CHECK(integ_check(buf, len) == 0);
+  buf[LINK_HDR_LEN] ^= 0x01;
+  buf[len - 1] ^= 0x80;                       // Trailer adulterado
+  CHECK(integ_check(buf, len) == 0);
+  CHECK(integ_append(buf, body, body + INTEG_TRAILER - 1) == 0);
+}//end check_key
+
+//=======================================================================================================
+//--- main ---
+int main(void)
+{
+  check_no_key();                             // Antes: a chave nao pode ser desfeita
+  check_key();
+  if(Fails)
+  {
+    fprintf(stderr, "%u verificacoes falharam\n", Fails);
+    return 1;
+  }//end if
+  printf("integrity ok\n");
+  return 0;
+}//end main
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,100 @@
+//=======================================================================================================
+//
+//   Title: Flight metrics checks (metrics.c).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Uso: lora_metricscheck
+//
+//   Voo sintetico (solo, subida a 8 m/s, descida a 5 m/s, solo) a 10, 20 e 50 Hz pelo metrics_update
+//   real. A subida fica abaixo de METRICS_LAUNCH_VZ, entao o lancamento so e visto pela subida sobre o
+//   minimo da janela de METRICS_WIN_US: se o deque perder o minimo (janela mais curta que 3 s), o
+//   lancamento atrasa ou nao acontece. O pouso tambem depende da janela inteira. Sai com erro se algum
+//   evento cair fora do intervalo esperado.
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include "metrics.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define CHECK(c) do{ if(!(c)){ printf("FALHA %s:%d: %s\n", __FILE__, __LINE__, #c); Fails++; } }while(0)
+
+#define PAD_S     5.0                         // Parado antes do lancamento
+#define CLIMB_S   20.0                        // Subida a CLIMB_VZ
+#define CLIMB_VZ  8.0
+#define SINK_VZ   5.0
+#define GROUND    100.0
+#define SINK_S    (CLIMB_S * CLIMB_VZ / SINK_VZ)
+#define END_S     (PAD_S + CLIMB_S + SINK_S + 10.0)
+
+//=======================================================================================================
+//--- Variaveis ---
+static unsigned Fails;
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- altitude ---
+static double altitude(double t)
+{
+  if(t < PAD_S)
+    return GROUND;
+  if(t < PAD_S + CLIMB_S)
+    return GROUND + CLIMB_VZ * (t - PAD_S);
+  if(t < PAD_S + CLIMB_S + SINK_S)
+    return GROUND + CLIMB_VZ * CLIMB_S - SINK_VZ * (t - PAD_S - CLIMB_S);
+  return GROUND;
+}//end altitude
+
+//=======================================================================================================
+//--- fly ---
+static void fly(unsigned hz)
+{
+  metrics_t m = {0};
+  double    launch = -1, apogee = -1, landed = -1;
+
+  for(unsigned i = 0; i <= END_S * hz; i++)
+  {
+    double             t = (double)i / hz;
+    telemetry_sample_t s = {0};
+    s.altitude    = (float)altitude(t);
+    s.t_sample_us = (int64_t)i * 1000000 / hz + 1000000;
+    metrics_update(&m, &s);
+    if((s.flags & TELEM_FLAG_LAUNCH) && launch < 0)
+      launch = t - PAD_S;
+    if((s.flags & TELEM_FLAG_APOGEE) && apogee < 0)
+      apogee = t - PAD_S - CLIMB_S;
+    if((s.flags & TELEM_FLAG_LANDED) && landed < 0)
+      landed = t - PAD_S - CLIMB_S - SINK_S;
+  }//end for
+  printf("%2u Hz: lancamento +%.2f s, apogeu +%.2f s, pouso +%.2f s\n", hz, launch, apogee, landed);
+
+  // 20 m sobre o minimo a 8 m/s: 2,5 s depois do inicio da subida (mais o atraso do filtro)
+  CHECK(launch >= METRICS_LAUNCH_RISE / CLIMB_VZ - 0.2 && launch <= METRICS_LAUNCH_RISE / CLIMB_VZ + 0.5);
+  CHECK(apogee >= 0.0 && apogee <= 2.0);
+  // Parado ha quase uma janela: a descida so sai do maximo depois de ~3 s
+  CHECK(landed >= METRICS_WIN_US * 1e-6 - 0.5 && landed <= METRICS_WIN_US * 1e-6 + 0.5);
+}//end fly
+
+//=======================================================================================================
+//--- main ---
+int main(void)
+{
+  fly(10);
+  fly(20);                                    // 60 amostras na janela: o dobro de METRICS_WIN
+  fly(50);
+  if(Fails)
+  {
+    fprintf(stderr, "%u verificacoes falharam\n", Fails);
+    return 1;
+  }//end if
+  printf("metrics ok\n");
+  return 0;
+}//end main
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,401 @@
+//=======================================================================================================
+//
+//   Title: Network uplink fan-out against localhost clients.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Uso: lora_netsim [--samples=n] [--rate=hz] [--slow-bps=n]
+//
+//   Roda o netout.c do firmware no host, com o produtor (push + poll, como a task de rede) na thread
+//   principal e quatro clientes em threads: TCP rapido, TCP lento (le --slow-bps bytes/s), WebSocket
+//   e um receptor UDP. Cada registro recebido e decodificado e comparado com a amostra gerada para o
+//   seu 'rec', entao um byte fora do lugar (cursor, pend, frame WS, volta do anel) aparece como erro.
+//   Sai com erro se algum registro vier errado, se o TCP rapido ou o WebSocket perderem registros ou
+//   se o cliente lento nao for pulado (ele deveria perder registros, nao segurar o produtor).
+//   O tempo maximo de push + poll(0) mostra que o cliente lento nao bloqueia o produtor.
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "netout.h"
+
+//=======================================================================================================
+//--- Types ---
+typedef enum{
+    CLI_TCP = 0,
+    CLI_SLOW,
+    CLI_WS,
+    CLI_UDP,
+    CLI_COUNT
+}cli_kind_t;
+
+typedef struct{
+    cli_kind_t kind;
+    uint16_t   port;
+    int        fd;
+    uint32_t   slow_bps;
+    // Resultado
+    uint32_t   records;
+    uint32_t   gaps;                          // Registros pulados (diferenca de rec)
+    uint32_t   errors;                        // Registro decodificado diferente do gerado
+    int32_t    first, last;
+}client_t;
+
+//=======================================================================================================
+//--- Variaveis ---
+static const char *Name[CLI_COUNT] = {"tcp", "tcp_slow", "websocket", "udp"};
+static volatile bool Done;                    // Fim da producao: o cliente lento drena sem esperar
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- now_us ---
+static int64_t now_us(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (int64_t)t.tv_sec * 1000000 + t.tv_nsec / 1000;
+}//end now_us
+
+//=======================================================================================================
+//--- gen ---
+// Amostra deterministica por indice: o cliente refaz a mesma a partir do rec recebido.
+static void gen(uint32_t i, telemetry_sample_t *s)
+{
+  memset(s, 0, sizeof(*s));
+  s->anglePitchDeg = (float)i * 0.5f;
+  s->angleRollDeg  = -(float)(i % 360);
+  s->temp          = 20.0f + (float)(i % 100) / 10.0f;
+  s->pressure_bmp  = 101325 + i;
+  s->lat_e7        = -235000000 + (int32_t)i * 7;
+  s->lon_e7        = -466000000 - (int32_t)i * 3;
+  s->altitude      = (float)i;
+  s->speed         = (float)(i % 50);
+  s->range_m       = (float)i * 2.0f;
+  s->bearing_deg   = (float)(i % 360);
+  s->elevation_deg = (float)(i % 90);
+  s->t_sample_us   = (int64_t)i * 1000;
+  s->t_rx_us       = s->t_sample_us + (int64_t)(i % 400) * 1000;
+  s->t_parse_us    = s->t_rx_us + (i % 700);
+  s->rssi          = (int16_t)(-40 - (int)(i % 80));
+  s->node          = (uint8_t)(i % 16);
+  s->SNR           = (uint8_t)(i % 40);
+  s->flags         = (uint8_t)(i % 4);
+}//end gen
+
+//=======================================================================================================
+//--- check ---
+static void check(client_t *c, const uint8_t *rec)
+{
+  telemetry_sample_t got, want;
+  uint32_t           n;
+
+  if(!netout_decode(rec, &n, &got))
+  {
+    c->errors++;
+    return;
+  }//end if
+  gen(n, &want);
+  if(memcmp(&got, &want, sizeof(got)) != 0)
+    c->errors++;
+  if(c->records && (int32_t)(n - c->last) != 1)
+    c->gaps += (uint32_t)(n - c->last - 1);
+  if(!c->records)
+    c->first = (int32_t)n;
+  c->last = (int32_t)n;
+  c->records++;
+}//end check
+
+//=======================================================================================================
+//--- tcp_connect ---
+static int tcp_connect(uint16_t port, int rcvbuf)
+{
+  struct sockaddr_in a = {0};
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+  if(rcvbuf)
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+  a.sin_family      = AF_INET;
+  a.sin_port        = htons(port);
+  a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  if(connect(fd, (struct sockaddr *)&a, sizeof(a)) < 0)
+  {
+    close(fd);
+    return -1;
+  }//end if
+  return fd;
+}//end tcp_connect
+
+//=======================================================================================================
+//--- read_full ---
+static bool read_full(int fd, uint8_t *p, size_t len)
+{
+  while(len)
+  {
+    ssize_t n = recv(fd, p, len, 0);
+    if(n <= 0)
+      return false;
+    p   += n;
+    len -= (size_t)n;
+  }//end while
+  return true;
+}//end read_full
+
+//=======================================================================================================
+//--- ws_handshake ---
+// Chave e resposta do exemplo da RFC 6455 (secao 1.3).
+static bool ws_handshake(int fd)
+{
+  static const char req[] = "GET /telemetria HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\n"
+                            "Connection: Upgrade\r\nSec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+                            "Sec-WebSocket-Version: 13\r\n\r\n";
+  char resp[256];
+  size_t len = 0;
+
+  send(fd, req, sizeof(req) - 1, 0);
+  while(len < sizeof(resp) - 1)
+  {
+    ssize_t n = recv(fd, &resp[len], 1, 0);
+    if(n <= 0)
+      return false;
+    len += (size_t)n;
+    resp[len] = '\0';
+    if(strstr(resp, "\r\n\r\n"))
+      return strncmp(resp, "HTTP/1.1 101", 12) == 0 && strstr(resp, "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=") != NULL;
+  }//end while
+  return false;
+}//end ws_handshake
+
+//=======================================================================================================
+//--- client_run ---
+static void *client_run(void *p)
+{
+  client_t *c = p;
+  uint8_t   buf[8192];
+  uint8_t   rec[NET_REC_SIZE];
+  size_t    have = 0;
+
+  if(c->kind == CLI_UDP)
+  {
+    while(true)
+    {
+      ssize_t n = recv(c->fd, buf, sizeof(buf), 0);
+      if(n <= 0 || (n == 1 && buf[0] == 0))
+        break;                                              // Datagrama de 1 byte = fim do teste
+      if(n < NET_UDP_HDR || buf[0] != 'T' || buf[1] != 'L' || buf[2] != NET_UDP_VERSION ||
+         (size_t)n != NET_UDP_HDR + (size_t)buf[3] * NET_REC_SIZE || memcmp(&buf[4], &buf[NET_UDP_HDR], 4) != 0)
+      {
+        c->errors++;
+        continue;
+      }//end if
+      for(int i = 0; i < buf[3]; i++)
+        check(c, &buf[NET_UDP_HDR + i * NET_REC_SIZE]);
+    }//end while
+    return NULL;
+  }//end if
+
+  c->fd = tcp_connect(c->port, c->kind == CLI_SLOW ? 4096 : 0);
+  if(c->fd < 0 || (c->kind == CLI_WS && !ws_handshake(c->fd)))
+  {
+    c->errors++;
+    return NULL;
+  }//end if
+
+  while(true)
+  {
+    size_t want = sizeof(buf);
+    if(c->kind == CLI_WS)
+    {
+      uint8_t h[4];
+      if(!read_full(c->fd, h, 2))
+        break;
+      want = h[1] & 0x7F;
+      if(h[0] != 0x82 || (h[1] & 0x80) || want == 127)
+      {
+        c->errors++;
+        break;
+      }//end if
+      if(want == 126)
+      {
+        if(!read_full(c->fd, &h[2], 2))
+          break;
+        want = (size_t)h[2] << 8 | h[3];
+      }//end if
+      if(want > sizeof(buf) || !read_full(c->fd, buf, want))
+        break;
+    }//end if
+    else
+    {
+      if(c->kind == CLI_SLOW && !Done)
+      {
+        want = c->slow_bps / 100 ? c->slow_bps / 100 : 1;
+        usleep(10000);
+      }//end if
+      ssize_t n = recv(c->fd, buf, want, 0);
+      if(n <= 0)
+        break;
+      want = (size_t)n;
+    }//end else
+
+    // Registros podem atravessar leituras (e frames): remonta em rec
+    for(size_t i = 0; i < want; i++)
+    {
+      rec[have++] = buf[i];
+      if(have == NET_REC_SIZE)
+      {
+        check(c, rec);
+        have = 0;
+      }//end if
+    }//end for
+  }//end while
+  close(c->fd);
+  return NULL;
+}//end client_run
+
+//=======================================================================================================
+//--- free_port ---
+static uint16_t free_port(int type)
+{
+  struct sockaddr_in a = {0};
+  socklen_t          len = sizeof(a);
+  int                fd = socket(AF_INET, type, 0);
+
+  a.sin_family      = AF_INET;
+  a.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  bind(fd, (struct sockaddr *)&a, sizeof(a));
+  getsockname(fd, (struct sockaddr *)&a, &len);
+  close(fd);
+  return ntohs(a.sin_port);
+}//end free_port
+
+//=======================================================================================================
+//--- main ---
+int main(int argc, char **argv)
+{
+  unsigned    samples = 50000, rate = 20000, slowBps = 6400;
+  client_t    cli[CLI_COUNT];
+  pthread_t   th[CLI_COUNT];
+  net_config_t cfg;
+  net_stats_t st;
+
+  for(int i = 1; i < argc; i++)
+  {
+    if(sscanf(argv[i], "--samples=%u", &samples) == 1) continue;
+    if(sscanf(argv[i], "--rate=%u", &rate) == 1) continue;
+    if(sscanf(argv[i], "--slow-bps=%u", &slowBps) == 1) continue;
+    fprintf(stderr, "opcao desconhecida: %s\n", argv[i]);
+    return 2;
+  }//end for
+
+  memset(cli, 0, sizeof(cli));
+  uint16_t tcp = free_port(SOCK_STREAM), ws = free_port(SOCK_STREAM);
+  for(int k = 0; k < CLI_COUNT; k++)
+  {
+    cli[k].kind     = (cli_kind_t)k;
+    cli[k].port     = k == CLI_WS ? ws : tcp;
+    cli[k].slow_bps = slowBps;
+  }//end for
+
+  // Receptor UDP antes do servidor, com buffer grande: perda no UDP aqui seria do kernel
+  struct sockaddr_in ua = {0};
+  socklen_t          ulen = sizeof(ua);
+  int                big = 8 << 20;
+  cli[CLI_UDP].fd = socket(AF_INET, SOCK_DGRAM, 0);
+  setsockopt(cli[CLI_UDP].fd, SOL_SOCKET, SO_RCVBUF, &big, sizeof(big));
+  ua.sin_family      = AF_INET;
+  ua.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  bind(cli[CLI_UDP].fd, (struct sockaddr *)&ua, sizeof(ua));
+  getsockname(cli[CLI_UDP].fd, (struct sockaddr *)&ua, &ulen);
+
+  cfg.udp_dest = "127.0.0.1";
+  cfg.udp_port = ntohs(ua.sin_port);
+  cfg.tcp_port = tcp;
+  cfg.ws_port  = ws;
+  cfg.batch_ms = 20;
+  cfg.sndbuf   = 16384;                                     // Da ordem do TCP_SND_BUF do lwIP, nao dos MB do Linux
+  int err = netout_start(&cfg);
+  if(err)
+  {
+    fprintf(stderr, "netout_start: %s\n", strerror(-err));
+    return 1;
+  }//end if
+  for(int k = 0; k < CLI_COUNT; k++)
+    pthread_create(&th[k], NULL, client_run, &cli[k]);
+
+  // Espera os tres clientes TCP/WS entrarem (accept e handshake acontecem no poll)
+  int64_t deadline = now_us() + 2000000;
+  do
+  {
+    netout_poll(10, now_us());
+    netout_get(&st);
+  }while(st.clients < 3 && now_us() < deadline);
+  if(st.clients < 3)
+  {
+    fprintf(stderr, "so %u clientes conectaram\n", st.clients);
+    return 1;
+  }//end if
+
+  int64_t period = 1000000 / (rate ? rate : 1);
+  int64_t t0 = now_us(), next = t0, worst = 0, sum = 0;
+  for(uint32_t i = 0; i < samples; i++)
+  {
+    telemetry_sample_t s;
+    gen(i, &s);
+    while(now_us() < next)
+      ;
+    next += period;
+    int64_t a = now_us();
+    netout_push(&s, a);
+    netout_poll(0, a);
+    int64_t d = now_us() - a;
+    sum  += d;
+    worst = d > worst ? d : worst;
+  }//end for
+  int64_t elapsed = now_us() - t0;
+
+  // Drena o que ficou (lote UDP incompleto, buffers dos sockets) e fecha os clientes
+  for(deadline = now_us() + 500000; now_us() < deadline;)
+    netout_poll(5, now_us());
+  netout_get(&st);
+  Done = true;
+  netout_stop();
+  sendto(socket(AF_INET, SOCK_DGRAM, 0), "", 1, 0, (struct sockaddr *)&ua, sizeof(ua));
+  for(int k = 0; k < CLI_COUNT; k++)
+    pthread_join(th[k], NULL);
+
+  printf("samples,%u,rate_hz,%.0f,push_poll_mean_us,%.2f,push_poll_max_us,%lld\n", samples,
+         samples * 1e6 / (double)elapsed, (double)sum / samples, (long long)worst);
+  printf("server,datagrams,%u,udp_dropped,%u,accepted,%u,client_dropped,%u\n", st.datagrams, st.udp_dropped,
+         st.accepted, st.client_dropped);
+  printf("client,records,first,last,gaps,errors\n");
+  int bad = 0;
+  for(int k = 0; k < CLI_COUNT; k++)
+  {
+    client_t *c = &cli[k];
+    printf("%s,%u,%d,%d,%u,%u\n", Name[k], c->records, c->first, c->last, c->gaps, c->errors);
+    bad += c->errors != 0;
+    if((k == CLI_TCP || k == CLI_WS) && (c->records != samples || c->gaps))
+      bad++;
+    if(k == CLI_SLOW && c->gaps == 0)
+      bad++;
+  }//end for
+  if(bad)
+  {
+    fprintf(stderr, "falhou: ver tabela acima\n");
+    return 1;
+  }//end if
+  return 0;
+}//end main
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,184 @@
+//=======================================================================================================
+//
+//   Title: Packet pool checks (pktpool.c).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Uso: lora_pktcheck
+//
+//   Na ordem do firmware, numa thread so: o radio pega, publica e solta; os taps tiram e soltam.
+//     - Taps parados: cada um segura no maximo PKT_TAP_DEPTH pacotes, o resto e descartado para ele e
+//       o pool nunca esgota.
+//     - Radio sem devolver: o pool esgota, pktpool_get devolve NULL e conta em exhausted.
+//     - Depois de drenar tudo, todo buffer volta com refs = 0 e a mascara livre cheia.
+//   Sai com erro se alguma verificacao falhar.
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <string.h>
+#include "pktpool.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define CHECK(c) do{ if(!(c)){ printf("FALHA %s:%d: %s\n", __FILE__, __LINE__, #c); Fails++; } }while(0)
+
+//=======================================================================================================
+//--- Variaveis ---
+static unsigned   Fails;
+static pkt_buf_t *Seen[PKT_POOL_LEN];         // Todo buffer que o pool ja entregou
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- see ---
+static void see(pkt_buf_t *p)
+{
+  CHECK(p->idx < PKT_POOL_LEN);
+  Seen[p->idx] = p;
+}//end see
+
+//=======================================================================================================
+//--- refs_zero ---
+// Todos os buffers ja vistos sem referencia e o pool cheio.
+static void refs_zero(void)
+{
+  pkt_stats_t st;
+
+  for(int i = 0; i < PKT_POOL_LEN; i++)
+    CHECK(Seen[i] == NULL || atomic_load(&Seen[i]->refs) == 0);
+  pktpool_get_stats(&st);
+  CHECK(st.free == PKT_POOL_LEN);
+}//end refs_zero
+
+//=======================================================================================================
+//--- drain ---
+static unsigned drain(pkt_tap_t t)
+{
+  unsigned   n = 0;
+  pkt_buf_t *p;
+
+  while((p = pktpool_take(t)) != NULL)
+  {
+    CHECK(atomic_load(&p->refs) >= 1);
+    pktpool_put(p);
+    n++;
+  }//end while
+  return n;
+}//end drain
+
+//=======================================================================================================
+//--- check_stalled_taps ---
+static void check_stalled_taps(void)
+{
+  const unsigned n = 3 * PKT_POOL_LEN;
+  pkt_stats_t    st;
+
+  pktpool_init();
+  pktpool_tap(PKT_TAP_FLASHLOG, true);
+  pktpool_tap(PKT_TAP_CAPTURE, true);
+  for(unsigned i = 0; i < n; i++)
+  {
+    pkt_buf_t *p = pktpool_get();
+    CHECK(p != NULL);
+    if(p == NULL)
+      return;
+    see(p);
+    p->len = 1;
+    p->data[0] = (uint8_t)i;
+    pktpool_publish(p);
+    pktpool_put(p);                           // Radio decodificou
+  }//end for
+  pktpool_get_stats(&st);
+  CHECK(st.exhausted == 0 && st.received == n);
+  CHECK(st.free == PKT_POOL_LEN - PKT_TAP_DEPTH);
+  CHECK(st.dropped[PKT_TAP_FLASHLOG] == n - PKT_TAP_DEPTH && st.dropped[PKT_TAP_CAPTURE] == n - PKT_TAP_DEPTH);
+
+  // Os dois taps seguram os mesmos PKT_TAP_DEPTH primeiros: refs = 2
+  pkt_buf_t *p = pktpool_take(PKT_TAP_FLASHLOG);
+  CHECK(p != NULL && p->data[0] == 0 && atomic_load(&p->refs) == 2);
+  pktpool_put(p);
+  CHECK(atomic_load(&p->refs) == 1);
+  CHECK(drain(PKT_TAP_FLASHLOG) == PKT_TAP_DEPTH - 1);
+  pktpool_tap(PKT_TAP_CAPTURE, false);        // Desligado continua drenando
+  CHECK(drain(PKT_TAP_CAPTURE) == PKT_TAP_DEPTH);
+  refs_zero();
+}//end check_stalled_taps
+
+//=======================================================================================================
+//--- check_exhausted ---
+static void check_exhausted(void)
+{
+  pkt_buf_t  *held[PKT_POOL_LEN];
+  pkt_stats_t st;
+
+  pktpool_init();
+  pktpool_tap(PKT_TAP_CAPTURE, true);
+  for(int i = 0; i < PKT_POOL_LEN; i++)
+  {
+    held[i] = pktpool_get();
+    CHECK(held[i] != NULL);
+    if(held[i] == NULL)
+      return;
+    see(held[i]);
+    pktpool_publish(held[i]);                 // Tap cheio depois de PKT_TAP_DEPTH
+  }//end for
+  CHECK(pktpool_get() == NULL);
+  CHECK(pktpool_get() == NULL);
+  pktpool_get_stats(&st);
+  CHECK(st.free == 0 && st.min_free == 0 && st.exhausted == 2 && st.received == PKT_POOL_LEN);
+
+  // Um buffer devolvido volta a ser entregue
+  pktpool_put(held[PKT_POOL_LEN - 1]);
+  pkt_buf_t *p = pktpool_get();
+  CHECK(p == held[PKT_POOL_LEN - 1] && atomic_load(&p->refs) == 1);
+
+  for(int i = 0; i < PKT_POOL_LEN; i++)
+    pktpool_put(held[i]);
+  CHECK(drain(PKT_TAP_CAPTURE) == PKT_TAP_DEPTH);
+  refs_zero();
+}//end check_exhausted
+
+//=======================================================================================================
+//--- check_format ---
+static void check_format(void)
+{
+  char       line[PKT_LINE_MAX];
+  pkt_buf_t *p;
+
+  pktpool_init();
+  p = pktpool_get();
+  CHECK(p != NULL);
+  if(p == NULL)
+    return;
+  memcpy(p->data, "\x01\xAB\xff", 3);
+  p->len      = 3;
+  p->rssi     = -97;
+  p->snr      = 7;
+  p->t_pre_us = 123456;
+  CHECK(pktpool_format(p, line, sizeof(line)) == strlen(line));
+  CHECK(strcmp(line, "$RAW,1,123456,-97,7,3,01abff\n") == 0);
+  CHECK(pktpool_format(p, line, 20) == 0);
+  pktpool_put(p);
+}//end check_format
+
+//=======================================================================================================
+//--- main ---
+int main(void)
+{
+  check_stalled_taps();
+  check_exhausted();
+  check_format();
+  if(Fails)
+  {
+    fprintf(stderr, "%u verificacoes falharam\n", Fails);
+    return 1;
+  }//end if
+  printf("pktpool ok\n");
+  return 0;
+}//end main
+
+//=======================================================================================================
+//--- End of Program ---
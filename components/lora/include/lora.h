@@ -40,6 +40,7 @@
 #define REG_PKT_RSSI_VALUE 0x1a
 #define REG_MODEM_CONFIG_1 0x1d
 #define REG_MODEM_CONFIG_2 0x1e
+#define REG_SYMB_TIMEOUT_LSB 0x1f
 #define REG_PREAMBLE_MSB 0x20
 #define REG_PREAMBLE_LSB 0x21
 #define REG_PAYLOAD_LENGTH 0x22
@@ -60,6 +61,7 @@
 #define MODE_TX 0x03
 #define MODE_RX_CONTINUOUS 0x05
 #define MODE_RX_SINGLE 0x06
+#define MODE_CAD 0x07
 
 /*
  * PA configuration
@@ -69,21 +71,35 @@
 /*
  * IRQ masks
  */
+#define IRQ_CAD_DETECTED_MASK 0x01
+#define IRQ_CAD_DONE_MASK 0x04
 #define IRQ_TX_DONE_MASK 0x08
 #define IRQ_PAYLOAD_CRC_ERROR_MASK 0x20
 #define IRQ_RX_DONE_MASK 0x40
+#define IRQ_RX_TIMEOUT_MASK 0x80
 
 #define PA_OUTPUT_RFO_PIN 0
 #define PA_OUTPUT_PA_BOOST_PIN 1
 
 #define TIMEOUT_RESET 100
 
+/*
+ * SX1276 datasheet 7.2.2: NRESET low for at least 100 us, then 5 ms before the chip is ready.
+ */
+#define RESET_PULSE_US 100
+#define RESET_READY_US 5000
+#define RESET_POLL_US 100
+
 void lora_reset(void);
 void lora_explicit_header_mode(void);
 void lora_implicit_header_mode(int size);
 void lora_idle(void);
 void lora_sleep(void);
 void lora_receive(void);
+void lora_receive_single(int symb_timeout);
+void lora_cad(void);
+int lora_cad_result(void);
+int lora_rx_timeout(void);
 void lora_set_tx_power(int level);
 void lora_set_frequency(long frequency);
 void lora_set_spreading_factor(int sf);
@@ -91,13 +107,18 @@ void lora_set_bandwidth(long sbw);
 void lora_set_coding_rate(int denominator);
 void lora_set_preamble_length(long length);
 void lora_set_sync_word(int sw);
+void lora_set_low_data_rate_optimize(int enable);
 void lora_enable_crc(void);
 void lora_disable_crc(void);
 int lora_init(void);
+int lora_restart(void);
+int lora_op_mode(void);
+int lora_version(void);
 void lora_send_packet(uint8_t *buf, int size);
 int lora_end_packet(bool async);
 int lora_receive_packet(uint8_t *buf, int size);
 int lora_received(void);
+int lora_crc_errors(void);
 int lora_packet_rssi(void);
 float lora_packet_snr(void);
 void lora_close(void);
@@ -105,4 +126,11 @@ int lora_initialized(void);
 void lora_dump_registers(void);
 int lora_initialized(void);
 
+#ifdef CONFIG_LORA_SIM
+/*
+ * The simulator has no DIO0 pin: it calls this handler (from ISR context) on every RxDone.
+ */
+void lora_sim_attach_dio0(void (*isr)(void *), void *arg);
+#endif
+
 #endif
@@ -1,9 +1,11 @@
 #include "lora.h"
+#include "esp_rom_sys.h"
 
 static spi_device_handle_t __spi;
 
 static int __implicit;
 static long __frequency;
+static int __crc_errors;
 
 /**
  * Write a value to a register.
@@ -49,14 +51,15 @@ int lora_read_reg(int reg)
 }
 
 /**
- * Perform physical reset on the Lora chip
+ * Perform physical reset on the Lora chip.
+ * Busy-waits the datasheet minimums: a tick-based delay would round 1 ms down to nothing or 5 ms up to 10.
  */
 void lora_reset(void)
 {
    gpio_set_level(CONFIG_RST_GPIO, 0);
-   vTaskDelay(pdMS_TO_TICKS(1));
+   esp_rom_delay_us(RESET_PULSE_US);
    gpio_set_level(CONFIG_RST_GPIO, 1);
-   vTaskDelay(pdMS_TO_TICKS(10));
+   esp_rom_delay_us(RESET_READY_US);
 }
 
 /**
@@ -108,6 +111,63 @@ void lora_receive(void)
    lora_write_reg(REG_OP_MODE, MODE_LONG_RANGE_MODE | MODE_RX_CONTINUOUS);
 }
 
+/**
+ * Sets the radio transceiver in single receive mode.
+ * The radio goes back to standby after one packet (RxDone on DIO0) or after
+ * symb_timeout symbols without a preamble (RxTimeout on DIO1).
+ * @param symb_timeout 4-1023, preamble search window in symbols.
+ */
+void lora_receive_single(int symb_timeout)
+{
+   if (symb_timeout < 4)
+      symb_timeout = 4;
+   else if (symb_timeout > 1023)
+      symb_timeout = 1023;
+
+   lora_idle();
+   lora_write_reg(REG_DIO_MAPPING_1, 0x00); // DIO0 = RxDone, DIO1 = RxTimeout
+   lora_write_reg(REG_MODEM_CONFIG_2, (lora_read_reg(REG_MODEM_CONFIG_2) & 0xfc) | ((symb_timeout >> 8) & 0x03));
+   lora_write_reg(REG_SYMB_TIMEOUT_LSB, symb_timeout & 0xff);
+   lora_write_reg(REG_FIFO_ADDR_PTR, 0);    // Single mode does not rewind the FIFO by itself
+   lora_write_reg(REG_OP_MODE, MODE_LONG_RANGE_MODE | MODE_RX_SINGLE);
+}
+
+/**
+ * Start a channel activity detection (CAD).
+ * DIO0 signals CadDone and DIO1 CadDetected; read the outcome with lora_cad_result().
+ */
+void lora_cad(void)
+{
+   lora_idle();
+   lora_write_reg(REG_DIO_MAPPING_1, 0xa0); // DIO0 = CadDone, DIO1 = CadDetected
+   lora_write_reg(REG_IRQ_FLAGS, IRQ_CAD_DONE_MASK | IRQ_CAD_DETECTED_MASK);
+   lora_write_reg(REG_OP_MODE, MODE_LONG_RANGE_MODE | MODE_CAD);
+}
+
+/**
+ * Outcome of the last CAD. Clears the CAD flags once it is done.
+ * @return 1 if a preamble was detected, 0 if the channel is free, -1 if the CAD is still running.
+ */
+int lora_cad_result(void)
+{
+   int irq = lora_read_reg(REG_IRQ_FLAGS);
+   if ((irq & IRQ_CAD_DONE_MASK) == 0)
+      return -1;
+   lora_write_reg(REG_IRQ_FLAGS, IRQ_CAD_DONE_MASK | IRQ_CAD_DETECTED_MASK);
+   return (irq & IRQ_CAD_DETECTED_MASK) ? 1 : 0;
+}
+
+/**
+ * Returns non-zero (and clears the flag) if the single receive window expired without a packet.
+ */
+int lora_rx_timeout(void)
+{
+   if ((lora_read_reg(REG_IRQ_FLAGS) & IRQ_RX_TIMEOUT_MASK) == 0)
+      return 0;
+   lora_write_reg(REG_IRQ_FLAGS, IRQ_RX_TIMEOUT_MASK);
+   return 1;
+}
+
 /**
  * Configure power level for transmission
  * @param level 2-17, from least to most power
@@ -227,6 +287,16 @@ void lora_set_sync_word(int sw)
    lora_write_reg(REG_SYNC_WORD, sw);
 }
 
+/**
+ * Enable/disable LowDataRateOptimize (mandatory when the symbol time exceeds 16 ms).
+ * @param enable Non-zero to set the flag.
+ */
+void lora_set_low_data_rate_optimize(int enable)
+{
+   int reg = lora_read_reg(REG_MODEM_CONFIG_3);
+   lora_write_reg(REG_MODEM_CONFIG_3, enable ? (reg | 0x08) : (reg & ~0x08));
+}
+
 /**
  * Enable appending/verifying packet CRC.
  */
@@ -243,8 +313,64 @@ void lora_disable_crc(void)
    lora_write_reg(REG_MODEM_CONFIG_2, lora_read_reg(REG_MODEM_CONFIG_2) & 0xfb);
 }
 
+/**
+ * Reset the chip and load the default configuration, without touching the SPI bus.
+ * Used by lora_init() and to recover a wedged radio; the caller reapplies frequency and modem settings.
+ * @return 1 if the chip answered with the SX1276 version, 0 otherwise.
+ */
+int lora_restart(void)
+{
+   /*
+    * Perform hardware reset.
+    */
+   lora_reset();
+
+   /*
+    * Check version.
+    */
+   uint8_t i = 0;
+   while (lora_read_reg(REG_VERSION) != 0x12)
+   {
+      if (++i >= TIMEOUT_RESET)
+         return 0;
+      esp_rom_delay_us(RESET_POLL_US);
+   }
+
+   /*
+    * Default configuration.
+    */
+   lora_sleep();
+   lora_write_reg(REG_FIFO_RX_BASE_ADDR, 0);
+   lora_write_reg(REG_FIFO_TX_BASE_ADDR, 0);
+   lora_write_reg(REG_LNA, lora_read_reg(REG_LNA) | 0x03);
+   lora_write_reg(REG_MODEM_CONFIG_3, 0x04);
+   lora_set_tx_power(17);
+   __implicit = 0; // the reset put the chip back in explicit header mode
+
+   lora_idle();
+
+   return 1;
+}
+
+/**
+ * Read back the operating mode (REG_OP_MODE).
+ */
+int lora_op_mode(void)
+{
+   return lora_read_reg(REG_OP_MODE);
+}
+
+/**
+ * Read back the silicon version (REG_VERSION), 0x12 on a responding SX1276.
+ */
+int lora_version(void)
+{
+   return lora_read_reg(REG_VERSION);
+}
+
 /**
  * Perform hardware initialization.
+ * @return 1 on success, 0 if the chip did not answer.
  */
 int lora_init(void)
 {
@@ -277,38 +403,7 @@ int lora_init(void)
 
    assert(ret == ESP_OK);
 
-   /*
-    * Perform hardware reset.
-    */
-   lora_reset();
-
-   /*
-    * Check version.
-    */
-   uint8_t version;
-   uint8_t i = 0;
-   while (i++ < TIMEOUT_RESET)
-   {
-      version = lora_read_reg(REG_VERSION);
-      if (version == 0x12)
-         break;
-      vTaskDelay(2);
-   }
-   assert(i <= TIMEOUT_RESET + 1); // at the end of the loop above, the max value i can reach is TIMEOUT_RESET + 1
-
-   /*
-    * Default configuration.
-    */
-   lora_sleep();
-   lora_write_reg(REG_FIFO_RX_BASE_ADDR, 0);
-   lora_write_reg(REG_FIFO_TX_BASE_ADDR, 0);
-   lora_write_reg(REG_LNA, lora_read_reg(REG_LNA) | 0x03);
-   lora_write_reg(REG_MODEM_CONFIG_3, 0x04);
-   lora_set_tx_power(17);
-
-   lora_idle();
-
-   return 1;
+   return lora_restart();
 }
 
 /**
@@ -382,8 +477,10 @@ int lora_receive_packet(uint8_t *buf, int size)
    lora_write_reg(REG_IRQ_FLAGS, irq);
    if ((irq & IRQ_RX_DONE_MASK) == 0)
       return 0;
-   if (irq & IRQ_PAYLOAD_CRC_ERROR_MASK)
+   if (irq & IRQ_PAYLOAD_CRC_ERROR_MASK) {
+      __crc_errors++;
       return 0;
+   }
 
    /*
     * Find packet size.
@@ -406,6 +503,14 @@ int lora_receive_packet(uint8_t *buf, int size)
    return len;
 }
 
+/**
+ * Number of packets discarded by lora_receive_packet() because of a payload CRC error.
+ */
+int lora_crc_errors(void)
+{
+   return __crc_errors;
+}
+
 /**
  * Returns non-zero if there is data to read (packet received).
  */
@@ -0,0 +1,284 @@
+#include "lora.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+
+/*
+ * Simulated SX1276 for QEMU / bench runs (CONFIG_LORA_SIM).
+ *
+ * Implements the same lora_* API without SPI. An esp_timer (ISR dispatch) plays the
+ * transmitter: it "receives" a frame at the configured rate, raises RX_DONE and calls the
+ * DIO0 handler registered with lora_sim_attach_dio0(). Like the real chip there is a single
+ * FIFO packet: a frame arriving while the previous one was not read yet, or while the radio
+ * is not in RX mode, is lost and counted as an overrun.
+ *
+ * The injected frames use the transmitter format with the sequence number in the pressure
+ * field, so the uplink CSV can be checked for gaps. After each rate step a line
+ *    $SIM,step,rate_hz,first_seq,sent,overrun
+ * is printed, and "$SIM,END" after the last one (see tools/qemu_e2e.py).
+ *
+ * With CONFIG_LORA_SIM_WEDGE_STEP the radio wedges at the start of that step the way a browned-out
+ * SX1276 does: it falls back to FSK standby and ignores mode changes until lora_restart(). Frames
+ * sent meanwhile are counted as overruns, so the $SIM line shows how long the recovery took.
+ */
+
+#define SIM_SEQ_DIGITS 8
+
+static const char *TAG = "lora_sim";
+
+static const char SIM_TEMPLATE[] = "1.50!-2.25@24.80#00000000C2332.12345AS&04638.12345*W(812.50)12.345B9E";
+
+static portMUX_TYPE __mux = portMUX_INITIALIZER_UNLOCKED;
+static esp_timer_handle_t __timer;
+static void (*__dio0_isr)(void *);
+static void *__dio0_arg;
+
+static uint8_t __fifo[sizeof(SIM_TEMPLATE)];
+static int __fifo_len;
+static int __irq;
+static int __mode;
+static volatile int __wedged;
+static int __seq_offset;
+static long __frequency;
+
+static volatile uint32_t __seq;
+static volatile uint32_t __step_left;
+static volatile uint32_t __overrun;
+static StackType_t __task_stack[3072];
+static StaticTask_t __task_tcb;
+
+static void sim_rx_cb(void *arg)
+{
+   uint32_t seq = __seq++;
+   int stored = 0;
+
+   portENTER_CRITICAL_ISR(&__mux);
+   if (__mode == MODE_CAD)
+   {
+      __irq |= IRQ_CAD_DONE_MASK | IRQ_CAD_DETECTED_MASK;
+      __overrun++; // the frame itself is gone; the CAD only saw its preamble
+      stored = 1;
+   }
+   else if ((__mode != MODE_RX_CONTINUOUS && __mode != MODE_RX_SINGLE) || (__irq & IRQ_RX_DONE_MASK))
+   {
+      __overrun++;
+   }
+   else
+   {
+      memcpy(__fifo, SIM_TEMPLATE, sizeof(SIM_TEMPLATE) - 1);
+      for (int i = SIM_SEQ_DIGITS - 1; i >= 0; i--, seq /= 10)
+         __fifo[__seq_offset + i] = '0' + (seq % 10);
+      __fifo_len = sizeof(SIM_TEMPLATE) - 1;
+      __irq |= IRQ_RX_DONE_MASK;
+      stored = 1;
+   }
+   portEXIT_CRITICAL_ISR(&__mux);
+
+   if (stored && __dio0_isr)
+      __dio0_isr(__dio0_arg);
+
+   if (--__step_left == 0)
+      esp_timer_stop(__timer);
+}
+
+static void sim_task(void *p)
+{
+   // Give the application time to finish booting before the first step
+   vTaskDelay(pdMS_TO_TICKS(2000));
+
+   for (int step = 0; step < CONFIG_LORA_SIM_STEPS; step++)
+   {
+      if (step + 1 == CONFIG_LORA_SIM_WEDGE_STEP)
+      {
+         __wedged = 1;
+         __mode = MODE_SLEEP;
+         ESP_LOGW(TAG, "step %d: radio wedged", step);
+      }
+      uint32_t rate = CONFIG_LORA_SIM_RATE_START_HZ + step * CONFIG_LORA_SIM_RATE_STEP_HZ;
+      uint32_t first = __seq;
+      uint32_t ovr = __overrun;
+
+      __step_left = CONFIG_LORA_SIM_FRAMES_PER_STEP;
+      esp_timer_start_periodic(__timer, 1000000 / rate);
+      while (__step_left)
+         vTaskDelay(pdMS_TO_TICKS(50));
+      vTaskDelay(pdMS_TO_TICKS(500)); // drain: let the pipeline flush before reporting
+
+      printf("$SIM,%d,%lu,%lu,%d,%lu\n", step, (unsigned long)rate, (unsigned long)first,
+             CONFIG_LORA_SIM_FRAMES_PER_STEP, (unsigned long)(__overrun - ovr));
+   }
+   printf("$SIM,END\n");
+   vTaskDelete(NULL);
+}
+
+void lora_sim_attach_dio0(void (*isr)(void *), void *arg)
+{
+   __dio0_arg = arg;
+   __dio0_isr = isr;
+}
+
+static void sim_mode(int mode)
+{
+   if (!__wedged)
+      __mode = mode;
+}
+
+void lora_reset(void) {}
+void lora_explicit_header_mode(void) {}
+void lora_implicit_header_mode(int size) {}
+
+void lora_idle(void)
+{
+   sim_mode(MODE_STDBY);
+}
+
+void lora_sleep(void)
+{
+   sim_mode(MODE_SLEEP);
+}
+
+void lora_receive(void)
+{
+   sim_mode(MODE_RX_CONTINUOUS);
+}
+
+void lora_receive_single(int symb_timeout)
+{
+   sim_mode(MODE_RX_SINGLE);
+}
+
+void lora_cad(void)
+{
+   sim_mode(MODE_CAD);
+}
+
+int lora_cad_result(void)
+{
+   int irq;
+
+   portENTER_CRITICAL(&__mux);
+   irq = __irq;
+   __irq &= ~(IRQ_CAD_DONE_MASK | IRQ_CAD_DETECTED_MASK);
+   portEXIT_CRITICAL(&__mux);
+   if ((irq & IRQ_CAD_DONE_MASK) == 0)
+      return -1; // no frame during the CAD: the caller times out and treats the channel as free
+   return (irq & IRQ_CAD_DETECTED_MASK) ? 1 : 0;
+}
+
+int lora_rx_timeout(void)
+{
+   return 0;
+}
+
+void lora_set_tx_power(int level) {}
+
+void lora_set_frequency(long frequency)
+{
+   __frequency = frequency;
+}
+
+void lora_set_spreading_factor(int sf) {}
+void lora_set_bandwidth(long sbw) {}
+void lora_set_coding_rate(int denominator) {}
+void lora_set_preamble_length(long length) {}
+void lora_set_sync_word(int sw) {}
+void lora_set_low_data_rate_optimize(int enable) {}
+void lora_enable_crc(void) {}
+void lora_disable_crc(void) {}
+
+int lora_init(void)
+{
+   const esp_timer_create_args_t args = {
+       .callback = sim_rx_cb,
+       .dispatch_method = ESP_TIMER_ISR,
+       .name = "lora_sim"};
+
+   __seq_offset = strchr(SIM_TEMPLATE, '#') - SIM_TEMPLATE + 1;
+   if (esp_timer_create(&args, &__timer) != ESP_OK)
+      return 0;
+   xTaskCreateStatic(sim_task, "lora_sim", sizeof(__task_stack), NULL, 1, __task_stack, &__task_tcb);
+   ESP_LOGW(TAG, "simulated radio: %d steps from %d Hz (+%d Hz), %d frames each",
+            CONFIG_LORA_SIM_STEPS, CONFIG_LORA_SIM_RATE_START_HZ, CONFIG_LORA_SIM_RATE_STEP_HZ,
+            CONFIG_LORA_SIM_FRAMES_PER_STEP);
+   lora_idle();
+   return 1;
+}
+
+int lora_restart(void)
+{
+   __wedged = 0;
+   lora_idle();
+   return 1;
+}
+
+int lora_op_mode(void)
+{
+   return __wedged ? MODE_STDBY | 0x08 : MODE_LONG_RANGE_MODE | __mode; // 0x09 = FSK standby after a reset
+}
+
+int lora_version(void)
+{
+   return 0x12;
+}
+
+void lora_send_packet(uint8_t *buf, int size)
+{
+   ESP_LOGD(TAG, "tx %d bytes", size);
+}
+
+int lora_end_packet(bool async)
+{
+   return 1;
+}
+
+int lora_receive_packet(uint8_t *buf, int size)
+{
+   int len = 0;
+
+   portENTER_CRITICAL(&__mux);
+   if (__irq & IRQ_RX_DONE_MASK)
+   {
+      len = __fifo_len < size ? __fifo_len : size;
+      memcpy(buf, __fifo, len);
+   }
+   __irq = 0;
+   sim_mode(MODE_STDBY); // lora_receive_packet() leaves the real chip in standby too
+   portEXIT_CRITICAL(&__mux);
+   return len;
+}
+
+int lora_received(void)
+{
+   return (__irq & IRQ_RX_DONE_MASK) ? 1 : 0;
+}
+
+int lora_crc_errors(void)
+{
+   return 0;
+}
+
+int lora_packet_rssi(void)
+{
+   return -60;
+}
+
+float lora_packet_snr(void)
+{
+   return 9.5;
+}
+
+void lora_close(void)
+{
+   esp_timer_stop(__timer);
+   lora_sleep();
+}
+
+void lora_dump_registers(void)
+{
+   printf("lora_sim: mode=%d irq=%02X seq=%lu overrun=%lu\n", __mode, __irq,
+          (unsigned long)__seq, (unsigned long)__overrun);
+}
+
+int lora_initialized(void)
+{
+   return __timer != NULL;
+}
@@ -0,0 +1,418 @@
+//=======================================================================================================
+//
+//   Title: Alarm rules evaluated per sample, with debounced events.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "alarm.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define EVENT_MASK (ALARM_EVENT_LEN - 1)
+
+_Static_assert((ALARM_EVENT_LEN & EVENT_MASK) == 0, "ALARM_EVENT_LEN deve ser potencia de 2");
+_Static_assert(ALARM_RULE_MAX <= 16, "ALARM_RULE_MAX cabe em telemetry_sample_t.alarms");
+_Static_assert(sizeof(alarm_rule_t) == 16, "alarm_rule_t e o formato da NVS");
+
+typedef enum{
+    T_F32 = 0,
+    T_U32,
+    T_I16,
+    T_U8
+}field_type_t;
+
+static const struct{
+    const char *name;
+    uint16_t    at;                           // offsetof na telemetry_sample_t
+    uint8_t     type;
+    uint8_t     need;                         // Flags exigidos na amostra (campo valido)
+}Fields[ALARM_F_COUNT] = {
+  [ALARM_F_TEMP]     = {"temp",   offsetof(telemetry_sample_t, temp),          T_F32, 0},
+  [ALARM_F_ALT]      = {"alt",    offsetof(telemetry_sample_t, altitude),      T_F32, 0},
+  [ALARM_F_SPEED]    = {"speed",  offsetof(telemetry_sample_t, speed),         T_F32, 0},
+  [ALARM_F_VZ]       = {"vz",     offsetof(telemetry_sample_t, vspeed),        T_F32, 0},
+  [ALARM_F_PITCH]    = {"pitch",  offsetof(telemetry_sample_t, anglePitchDeg), T_F32, 0},
+  [ALARM_F_ROLL]     = {"roll",   offsetof(telemetry_sample_t, angleRollDeg),  T_F32, 0},
+  [ALARM_F_PRESSURE] = {"pressao",offsetof(telemetry_sample_t, pressure_bmp),  T_U32, 0},
+  [ALARM_F_RSSI]     = {"rssi",   offsetof(telemetry_sample_t, rssi),          T_I16, 0},
+  [ALARM_F_SNR]      = {"snr",    offsetof(telemetry_sample_t, SNR),           T_U8,  0},
+  [ALARM_F_RANGE]    = {"range",  offsetof(telemetry_sample_t, range_m),       T_F32, TELEM_FLAG_GEO},
+  [ALARM_F_LINK]     = {"link",   0,                                           T_F32, 0},
+};
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    float    on;                              // Limiar de disparo (intervalos para o enlace)
+    float    off;                             // Limiar de retorno (histerese aplicada)
+    int64_t  hold_us;
+    uint16_t at;
+    uint8_t  type;
+    uint8_t  need;
+    uint8_t  rule;                            // Bit em alarms
+    uint8_t  field;
+    uint8_t  node;
+    bool     gt;
+}entry_t;
+
+typedef struct{
+    entry_t  eval[ALARM_RULE_MAX];            // Regras de amostra, na ordem da lista
+    entry_t  link[ALARM_RULE_MAX];            // Regras do watchdog
+    uint8_t  n_eval;
+    uint8_t  n_link;
+    uint16_t link_mask;
+    uint32_t gen;
+}table_t;
+
+typedef struct{
+    atomic_uint   seq;                        // Indice+1 do evento armazenado, 0 durante a escrita
+    alarm_event_t e;
+}event_slot_t;
+
+//=======================================================================================================
+//--- Variaveis ---
+static alarm_rule_t Rules[ALARM_RULE_MAX];    // Lista fonte (console)
+static size_t       NRules;
+static table_t      Tables[2];
+static atomic_uint  Cur;                      // Tabela em uso pelo radio
+static event_slot_t Events[ALARM_EVENT_LEN];
+static atomic_uint  Head;
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static float Value(const telemetry_sample_t *s, const entry_t *e);
+static void  Post(uint8_t node, const entry_t *e, float value, bool on, int64_t t_us);
+static void  Sync(alarm_state_t *a, const table_t *t);
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- alarm_set_rules ---
+bool alarm_set_rules(const alarm_rule_t *rules, size_t n)
+{
+  if(n > ALARM_RULE_MAX)
+    return false;
+  for(size_t i = 0; i < n; i++)
+  {
+    const alarm_rule_t *r = &rules[i];
+    if(r->field >= ALARM_F_COUNT || r->op >= ALARM_OP_COUNT || !isfinite(r->threshold) || !isfinite(r->hyst) ||
+       r->hyst < 0.0f || (r->field == ALARM_F_LINK && r->threshold <= 0.0f))
+      return false;
+  }//end for
+
+  uint32_t cur = atomic_load_explicit(&Cur, memory_order_relaxed);
+  table_t *t   = &Tables[cur ^ 1];
+  uint32_t gen = Tables[cur].gen + 1;
+
+  memmove(Rules, rules, n * sizeof(*rules));
+  NRules = n;
+  memset(t, 0, sizeof(*t));
+  for(size_t i = 0; i < n; i++)
+  {
+    const alarm_rule_t *r  = &Rules[i];
+    bool                gt = r->op == ALARM_GT;
+    entry_t             e  = {
+      .on      = r->threshold,
+      .off     = gt ? r->threshold - r->hyst : r->threshold + r->hyst,
+      .hold_us = (int64_t)r->hold_ms * 1000,
+      .at      = Fields[r->field].at,
+      .type    = Fields[r->field].type,
+      .need    = Fields[r->field].need,
+      .rule    = (uint8_t)i,
+      .field   = r->field,
+      .node    = r->node,
+      .gt      = gt,
+    };
+    if(r->field == ALARM_F_LINK)
+    {
+      t->link[t->n_link++] = e;
+      t->link_mask        |= (uint16_t)(1u << i);
+    }//end if
+    else
+      t->eval[t->n_eval++] = e;
+  }//end for
+  t->gen = gen;
+  atomic_store_explicit(&Cur, cur ^ 1, memory_order_release);
+  return true;
+}//end alarm_set_rules
+
+//=======================================================================================================
+//--- alarm_get_rules ---
+size_t alarm_get_rules(alarm_rule_t *out)
+{
+  memcpy(out, Rules, NRules * sizeof(*out));
+  return NRules;
+}//end alarm_get_rules
+
+//=======================================================================================================
+//--- alarm_eval ---
+// Sem regra alem do limiar o laco so le e compara; pending/since/eventos so mudam nas transicoes.
+void alarm_eval(alarm_state_t *a, telemetry_sample_t *s)
+{
+  const table_t *t = &Tables[atomic_load_explicit(&Cur, memory_order_acquire)];
+  Sync(a, t);
+  uint16_t active = a->active;
+
+  for(uint8_t i = 0; i < t->n_eval; i++)
+  {
+    const entry_t *e   = &t->eval[i];
+    uint16_t       bit = (uint16_t)(1u << e->rule);
+    if((e->node != ALARM_NODE_ANY && e->node != s->node) || (s->flags & e->need) != e->need)
+      continue;
+    float v = Value(s, e);
+    if(active & bit)
+    {
+      if(e->gt ? v < e->off : v > e->off)
+      {
+        active &= (uint16_t)~bit;
+        Post(s->node, e, v, false, s->t_rx_us);
+      }//end if
+    }//end if
+    else if(e->gt ? v > e->on : v < e->on)
+    {
+      if(!(a->pending & bit))
+      {
+        a->pending        |= bit;
+        a->since[e->rule]  = s->t_rx_us;
+      }//end if
+      if(s->t_rx_us - a->since[e->rule] >= e->hold_us)
+      {
+        a->pending &= (uint16_t)~bit;
+        active     |= bit;
+        Post(s->node, e, v, true, s->t_rx_us);
+      }//end if
+    }//end else if
+    else
+      a->pending &= (uint16_t)~bit;
+  }//end for
+
+  if(active & t->link_mask)                   // Amostra chegou: o enlace voltou
+  {
+    for(uint8_t i = 0; i < t->n_link; i++)
+    {
+      uint16_t bit = (uint16_t)(1u << t->link[i].rule);
+      if(active & bit)
+      {
+        active &= (uint16_t)~bit;
+        Post(s->node, &t->link[i], 0.0f, false, s->t_rx_us);
+      }//end if
+    }//end for
+  }//end if
+  a->active = active;
+  s->alarms = active;
+  if(active)
+    s->flags |= TELEM_FLAG_ALARM;
+}//end alarm_eval
+
+//=======================================================================================================
+//--- alarm_link ---
+bool alarm_link(alarm_state_t *a, uint8_t node, int64_t silent_us, uint32_t period_us, int64_t now_us)
+{
+  const table_t *t     = &Tables[atomic_load_explicit(&Cur, memory_order_acquire)];
+  bool           fired = false;
+
+  if(t->n_link == 0 || period_us == 0)        // Sem intervalo medido ainda nao ha o que esperar
+    return false;
+  Sync(a, t);
+  float periods = (float)silent_us / (float)period_us;
+  for(uint8_t i = 0; i < t->n_link; i++)
+  {
+    const entry_t *e   = &t->link[i];
+    uint16_t       bit = (uint16_t)(1u << e->rule);
+    if((a->active & bit) || (e->node != ALARM_NODE_ANY && e->node != node) || periods <= e->on)
+      continue;
+    a->active |= bit;
+    Post(node, e, periods, true, now_us);
+    fired = true;
+  }//end for
+  return fired;
+}//end alarm_link
+
+//=======================================================================================================
+//--- alarm_reader_init ---
+void alarm_reader_init(alarm_reader_t *rd)
+{
+  rd->tail    = atomic_load_explicit(&Head, memory_order_acquire);
+  rd->dropped = 0;
+}//end alarm_reader_init
+
+//=======================================================================================================
+//--- alarm_pop ---
+// Mesmo protocolo do sample_ring_pop: leitor atrasado pula para o mais antigo valido.
+bool alarm_pop(alarm_reader_t *rd, alarm_event_t *out)
+{
+  while(true)
+  {
+    uint32_t head = atomic_load_explicit(&Head, memory_order_acquire);
+    if(rd->tail == head)
+      return false;
+    if(head - rd->tail > ALARM_EVENT_LEN)
+    {
+      rd->dropped += head - rd->tail - ALARM_EVENT_LEN;
+      rd->tail     = head - ALARM_EVENT_LEN;
+    }//end if
+
+    event_slot_t *slot = &Events[rd->tail & EVENT_MASK];
+    uint32_t      seq  = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    if(seq == rd->tail + 1)
+    {
+      *out = slot->e;
+      atomic_thread_fence(memory_order_acquire);
+      if(atomic_load_explicit(&slot->seq, memory_order_relaxed) == seq)
+      {
+        rd->tail++;
+        return true;
+      }//end if
+    }//end if
+    rd->dropped++;
+    rd->tail++;
+  }//end while
+}//end alarm_pop
+
+//=======================================================================================================
+//--- alarm_format ---
+size_t alarm_format(const alarm_event_t *e, char *buf, size_t size)
+{
+  int w = snprintf(buf, size, "$ALM,%u,%u,%s,%s,%.2f,%lld\n", e->node, e->rule, alarm_field_name(e->field),
+                   e->on ? "on" : "off", e->value, (long long)e->t_us);
+  return w > 0 && (size_t)w < size ? (size_t)w : 0;
+}//end alarm_format
+
+//=======================================================================================================
+//--- alarm_format_rule ---
+size_t alarm_format_rule(uint8_t idx, const alarm_rule_t *r, char *buf, size_t size)
+{
+  char node[4] = "*";
+  if(r->node != ALARM_NODE_ANY)
+    snprintf(node, sizeof(node), "%u", r->node);
+  int w = snprintf(buf, size, "$ALR,%u,%s,%c,%.2f,%.2f,%u,%s\n", idx, alarm_field_name(r->field),
+                   r->op == ALARM_GT ? '>' : '<', r->threshold, r->hyst, r->hold_ms, node);
+  return w > 0 && (size_t)w < size ? (size_t)w : 0;
+}//end alarm_format_rule
+
+//=======================================================================================================
+//--- alarm_parse_rule ---
+// argv: campo, ">" ou "<", limiar e opcionais histerese, hold_ms, no ("*" = todos).
+int alarm_parse_rule(int argc, char **argv, alarm_rule_t *out)
+{
+  char *end;
+
+  if(argc < 3)
+    return -1;
+  memset(out, 0, sizeof(*out));
+  out->node  = ALARM_NODE_ANY;
+  out->field = ALARM_F_COUNT;
+  for(uint8_t f = 0; f < ALARM_F_COUNT; f++)
+  {
+    if(strcmp(argv[0], Fields[f].name) == 0)
+      out->field = f;
+  }//end for
+  if(out->field == ALARM_F_COUNT)
+    return -1;
+  if(strcmp(argv[1], ">") == 0)
+    out->op = ALARM_GT;
+  else if(strcmp(argv[1], "<") == 0)
+    out->op = ALARM_LT;
+  else
+    return -1;
+  out->threshold = strtof(argv[2], &end);
+  if(*end)
+    return -1;
+  if(argc > 3)
+  {
+    out->hyst = strtof(argv[3], &end);
+    if(*end)
+      return -1;
+  }//end if
+  if(argc > 4)
+  {
+    unsigned long ms = strtoul(argv[4], &end, 10);
+    if(*end || ms > UINT16_MAX)
+      return -1;
+    out->hold_ms = (uint16_t)ms;
+  }//end if
+  if(argc > 5 && strcmp(argv[5], "*") != 0)
+  {
+    unsigned long node = strtoul(argv[5], &end, 10);
+    if(*end || node >= ALARM_NODE_ANY)
+      return -1;
+    out->node = (uint8_t)node;
+  }//end if
+  return 0;
+}//end alarm_parse_rule
+
+//=======================================================================================================
+//--- alarm_field_name ---
+const char *alarm_field_name(uint8_t field)
+{
+  return field < ALARM_F_COUNT ? Fields[field].name : "?";
+}//end alarm_field_name
+
+//=======================================================================================================
+//--- Value ---
+static float Value(const telemetry_sample_t *s, const entry_t *e)
+{
+  const uint8_t *p = (const uint8_t *)s + e->at;
+  switch(e->type)
+  {
+    case T_U32:
+    {
+      uint32_t v;
+      memcpy(&v, p, sizeof(v));
+      return (float)v;
+    }
+    case T_I16:
+    {
+      int16_t v;
+      memcpy(&v, p, sizeof(v));
+      return (float)v;
+    }
+    case T_U8:
+      return (float)*p;
+    default:
+    {
+      float v;
+      memcpy(&v, p, sizeof(v));
+      return v;
+    }
+  }//end switch
+}//end Value
+
+//=======================================================================================================
+//--- Post ---
+// Um produtor (task do radio), como o sample_ring_push.
+static void Post(uint8_t node, const entry_t *e, float value, bool on, int64_t t_us)
+{
+  uint32_t      idx  = atomic_load_explicit(&Head, memory_order_relaxed);
+  event_slot_t *slot = &Events[idx & EVENT_MASK];
+
+  atomic_store_explicit(&slot->seq, 0, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  slot->e = (alarm_event_t){t_us, value, node, e->rule, e->field, on};
+  atomic_store_explicit(&slot->seq, idx + 1, memory_order_release);
+  atomic_store_explicit(&Head, idx + 1, memory_order_release);
+}//end Post
+
+//=======================================================================================================
+//--- Sync ---
+// Tabela trocada pelo console: o estado do no recomeca (os bits mudaram de significado).
+static void Sync(alarm_state_t *a, const table_t *t)
+{
+  if(a->gen == t->gen)
+    return;
+  memset(a, 0, sizeof(*a));
+  a->gen = t->gen;
+}//end Sync
+
+//=======================================================================================================
+//--- End of Program ---
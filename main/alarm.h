@@ -0,0 +1,117 @@
+//=======================================================================================================
+//
+//   Title: Alarm rules evaluated per sample, with debounced events.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Cada regra (alarm_rule_t, gravada na NVS pelo console) diz: campo, comparador, limiar, histerese,
+//   tempo minimo acima do limiar (hold) e no (ou todos). alarm_set_rules compila a lista numa tabela
+//   plana com o offset e o tipo do campo na telemetry_sample_t ja resolvidos; o ReceiveLoraData chama
+//   alarm_eval em cada amostra, que para cada regra faz uma leitura e uma comparacao com o limiar do
+//   estado atual (disparo ou retorno). So uma transicao escreve alguma coisa.
+//
+//   Regras de enlace (ALARM_F_LINK) nao olham amostras: alarm_link e chamado pelo watchdog da task do
+//   radio e dispara quando o no ficou mudo por mais de 'limiar' intervalos medios entre as telemetrias
+//   dele (node_period), entao o limiar nao depende da taxa nem do perfil de radio; a proxima amostra do
+//   no encerra o alarme.
+//
+//   Disparos e retornos viram eventos num anel de um produtor (radio) e varios leitores, com o mesmo
+//   seqlock por slot do SampleRing: o DataExcel escreve uma linha $ALM no uplink e o MenuDisp
+//   interrompe a tela atual. As amostras levam a mascara das regras ativas do no (alarms) e
+//   TELEM_FLAG_ALARM.
+//
+//   Uma tabela nova e escrita na copia que o radio nao esta usando e publicada com um store atomico;
+//   o estado de cada no recomeca na primeira avaliacao com ela. Duas trocas seguidas estao a um comando
+//   de console de distancia, bem mais que uma avaliacao.
+//=======================================================================================================
+
+#ifndef ALARM_h
+#define ALARM_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "telemetry.h"
+
+//=======================================================================================================
+//--- Macros and Constants ---
+#define ALARM_RULE_MAX   16                   // Bits de telemetry_sample_t.alarms
+#define ALARM_NODE_ANY   0xFF
+#define ALARM_EVENT_LEN  16                   // Potencia de 2
+#define ALARM_LINE_MAX   96                   // "$ALM,..."
+
+//=======================================================================================================
+//--- Types ---
+
+typedef enum{
+    ALARM_F_TEMP = 0,
+    ALARM_F_ALT,
+    ALARM_F_SPEED,
+    ALARM_F_VZ,
+    ALARM_F_PITCH,
+    ALARM_F_ROLL,
+    ALARM_F_PRESSURE,
+    ALARM_F_RSSI,
+    ALARM_F_SNR,
+    ALARM_F_RANGE,
+    ALARM_F_LINK,                             // Limiar = intervalos do no sem pacote (watchdog)
+    ALARM_F_COUNT
+}alarm_field_t;
+
+typedef enum{
+    ALARM_GT = 0,                             // Dispara acima do limiar, volta abaixo de limiar - hist
+    ALARM_LT,                                 // Dispara abaixo do limiar, volta acima de limiar + hist
+    ALARM_OP_COUNT
+}alarm_op_t;
+
+typedef struct{                               // Formato gravado na NVS
+    float    threshold;
+    float    hyst;
+    uint16_t hold_ms;                         // Tempo continuo alem do limiar antes de disparar
+    uint8_t  field;                           // alarm_field_t
+    uint8_t  op;                              // alarm_op_t
+    uint8_t  node;                            // ALARM_NODE_ANY = todos
+    uint8_t  rsv[3];
+}alarm_rule_t;
+
+typedef struct{                               // Por no (node_state_t), so o radio escreve
+    uint32_t gen;                             // Tabela com que o estado foi montado
+    uint16_t active;                          // Regras disparadas
+    uint16_t pending;                         // Alem do limiar, esperando o hold
+    int64_t  since[ALARM_RULE_MAX];           // Inicio do pending
+}alarm_state_t;
+
+typedef struct{
+    int64_t t_us;
+    float   value;                            // Valor que cruzou (intervalos para ALARM_F_LINK)
+    uint8_t node;
+    uint8_t rule;
+    uint8_t field;
+    bool    on;                               // Disparo (true) ou retorno
+}alarm_event_t;
+
+typedef struct{
+    uint32_t tail;
+    uint32_t dropped;
+}alarm_reader_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+bool        alarm_set_rules(const alarm_rule_t *rules, size_t n);   // Valida, guarda e compila (false = regra invalida)
+size_t      alarm_get_rules(alarm_rule_t *out);                     // Copia a lista atual (ate ALARM_RULE_MAX)
+void        alarm_eval(alarm_state_t *a, telemetry_sample_t *s);    // Preenche alarms/flags e publica transicoes
+bool        alarm_link(alarm_state_t *a, uint8_t node, int64_t silent_us, uint32_t period_us, int64_t now_us);  // Disparou?
+void        alarm_reader_init(alarm_reader_t *rd);                  // Cursor a partir do evento atual
+bool        alarm_pop(alarm_reader_t *rd, alarm_event_t *out);
+size_t      alarm_format(const alarm_event_t *e, char *buf, size_t size);  // $ALM,no,regra,campo,on|off,valor,t_us
+size_t      alarm_format_rule(uint8_t idx, const alarm_rule_t *r, char *buf, size_t size);  // $ALR,idx,campo,op,...
+int         alarm_parse_rule(int argc, char **argv, alarm_rule_t *out);  // "campo >|< limiar [hist] [hold_ms] [no]"; 0 ou -1
+const char *alarm_field_name(uint8_t field);
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,132 @@
+//=======================================================================================================
+//
+//   Title: Selective-ACK reliable channel for critical frames.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include "arq.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define SLOT(seq) ((seq) % ARQ_WINDOW)        // Slots fixos por sequencia: deslizar nao copia dados
+#define BACK_MIN  (256 - ARQ_WINDOW)          // dist >= BACK_MIN: ate ARQ_WINDOW antes da base (retransmissao)
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- arq_reset ---
+void arq_reset(arq_state_t *a)
+{
+  memset(a, 0, sizeof(*a));
+}//end arq_reset
+
+//=======================================================================================================
+//--- arq_rx ---
+// Sessao nova com frames ainda guardados devolve ARQ_FAR: o chamador libera a sessao velha e repete.
+int arq_rx(arq_state_t *a, uint8_t seq, const uint8_t *p, size_t len, const link_rx_t *rx, int64_t now_us)
+{
+  if(len > ARQ_FRAME_MAX)
+    return ARQ_BIG;
+
+  uint8_t dist = (uint8_t)(seq - a->base);
+  if(a->synced && (now_us - a->last_us >= ARQ_IDLE_US || (dist >= 128 && dist < BACK_MIN)))
+  {
+    if(a->have)
+      return ARQ_FAR;
+    a->synced = false;                        // Transmissor reiniciou (salto para tras) ou ficou mudo
+    if(seq != a->base)
+      a->resync++;
+  }//end if
+  if(!a->synced)
+  {
+    a->synced = true;
+    a->base   = seq;
+    a->top    = seq;
+    dist      = 0;
+  }//end if
+  a->last_us = now_us;
+
+  if(dist >= BACK_MIN)
+  {
+    a->dup++;                                 // Antes da base: ja liberado (ACK perdido)
+    return ARQ_DUP;
+  }//end if
+  if(dist >= ARQ_WINDOW)
+  {
+    if(a->have)
+      return ARQ_FAR;                         // Libera o que esta guardado antes de deslizar
+    a->given_up += (uint8_t)(seq - a->base);  // Janela vazia: ressincroniza na sequencia nova
+    a->base = seq;
+    a->top  = seq;
+    dist    = 0;
+  }//end if
+  if(a->have & (1u << dist))
+  {
+    a->dup++;
+    return ARQ_DUP;
+  }//end if
+
+  a->rx[SLOT(seq)] = *rx;
+  if((uint8_t)(a->top - seq - 1) < 128)      // Abaixo do maior ja visto: era uma lacuna
+  {
+    a->recovered++;
+    a->rx[SLOT(seq)].late = true;             // Retransmissao: a medida e mais velha que o RxDone
+  }//end if
+  else
+    a->top = (uint8_t)(seq + 1);
+  memcpy(a->buf[SLOT(seq)], p, len);
+  a->len[SLOT(seq)] = (uint8_t)len;
+  a->have |= (uint16_t)(1u << dist);
+  if(!(a->have & 1u) && a->gap_us == 0)
+    a->gap_us = now_us;
+  return ARQ_NEW;
+}//end arq_rx
+
+//=======================================================================================================
+//--- arq_pop ---
+// Libera a base se ela chegou; com a base faltando, so pula depois do timeout (ou com flush).
+bool arq_pop(arq_state_t *a, uint8_t *out, size_t *len, link_rx_t *rx, int64_t now_us, bool flush)
+{
+  while(a->have)
+  {
+    if(a->have & 1u)
+    {
+      *len = a->len[SLOT(a->base)];
+      *rx  = a->rx[SLOT(a->base)];
+      memcpy(out, a->buf[SLOT(a->base)], *len);
+      a->base++;
+      a->have >>= 1;
+      a->gap_us = (a->have && !(a->have & 1u)) ? now_us : 0;   // Nova lacuna comeca a contar agora
+      return true;
+    }//end if
+    if(!flush && now_us - a->gap_us < ARQ_GAP_TIMEOUT_US)
+      return false;
+    a->given_up++;                            // Desiste desta sequencia
+    a->base++;
+    a->have >>= 1;
+  }//end while
+  a->gap_us = 0;
+  return false;
+}//end arq_pop
+
+//=======================================================================================================
+//--- arq_ack_encode ---
+size_t arq_ack_encode(const arq_state_t *a, uint8_t node, uint8_t *buf, size_t size)
+{
+  if(size < ARQ_ACK_LEN)
+    return 0;
+  uint16_t sack = (uint16_t)(a->have >> 1);   // Bit 0 de 'have' e sempre a base faltando
+  uint8_t *p = buf + link_encode_hdr(buf, LINK_T_ACK, node, 0, a->base);
+  p[0] = (uint8_t)sack;
+  p[1] = (uint8_t)(sack >> 8);
+  return ARQ_ACK_LEN;
+}//end arq_ack_encode
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,79 @@
+//=======================================================================================================
+//
+//   Title: Selective-ACK reliable channel for critical frames.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Frames com LINK_F_REL no cabecalho (eventos: apogeu, falha...) usam uma sequencia propria por no.
+//   O receptor guarda ate ARQ_WINDOW frames fora de ordem e os libera em ordem; apos cada frame
+//   confiavel responde, logo depois do RxDone (janela de virada do transmissor), com um LINK_T_ACK:
+//
+//     cabecalho: no = destino, seq = base (tudo antes de base ja foi recebido)
+//     payload:   [mapa lo][mapa hi]   bit i = frame base+1+i ja recebido (SACK); zeros abaixo do
+//                                     maior bit ligado sao NACKs implicitos
+//
+//   O transmissor reenvia so o que faltar. Uma lacuna que nao se fecha em ARQ_GAP_TIMEOUT_US e
+//   abandonada e os frames seguintes sao liberados.
+//
+//   Reinicio do transmissor (sequencia volta a 0): so ate ARQ_WINDOW sequencias antes da base podem ser
+//   retransmissoes legitimas (o transmissor nao tem mais que isso sem ACK). Uma sequencia mais atras,
+//   ou qualquer frame depois de ARQ_IDLE_US sem nada do no, comeca uma sessao nova na sequencia
+//   recebida. Cada frame guardado leva o seu link_rx_t (RSSI e instantes), devolvido pelo arq_pop.
+//=======================================================================================================
+
+#ifndef ARQ_h
+#define ARQ_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "link.h"
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+#define ARQ_WINDOW          8                 // Frames fora de ordem guardados por no (= janela do transmissor)
+#define ARQ_FRAME_MAX       128               // Maior payload confiavel
+#define ARQ_GAP_TIMEOUT_US  3000000           // Espera por uma retransmissao antes de desistir
+#define ARQ_IDLE_US         10000000          // Sem frame confiavel do no por mais que isso: sessao nova
+#define ARQ_ACK_LEN         (LINK_HDR_LEN + 2)
+
+enum{
+  ARQ_NEW = 0,                                // Guardado; chame arq_pop
+  ARQ_DUP,                                    // Ja recebido (ACK perdido): so reconfirmar
+  ARQ_FAR,                                    // Alem da janela: arq_pop(flush) e tentar de novo
+  ARQ_BIG                                     // Payload maior que ARQ_FRAME_MAX (descartado, sem ACK)
+};
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    bool     synced;
+    uint8_t  base;                            // Proxima sequencia a liberar
+    uint8_t  top;                             // Maior sequencia vista + 1
+    uint16_t have;                            // bit i = base+i guardado
+    int64_t  gap_us;                          // Desde quando a base esta faltando (0 = sem lacuna)
+    int64_t  last_us;                         // Ultimo frame aceito (ARQ_IDLE_US)
+    uint32_t recovered;                       // Lacunas preenchidas (chegaram fora de ordem)
+    uint32_t dup;
+    uint32_t given_up;                        // Lacunas abandonadas por timeout/salto
+    uint32_t resync;                          // Sessoes novas (transmissor reiniciou ou ficou mudo)
+    uint8_t  len[ARQ_WINDOW];
+    link_rx_t rx[ARQ_WINDOW];
+    uint8_t  buf[ARQ_WINDOW][ARQ_FRAME_MAX];
+}arq_state_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void   arq_reset(arq_state_t *a);
+int    arq_rx(arq_state_t *a, uint8_t seq, const uint8_t *p, size_t len, const link_rx_t *rx, int64_t now_us);  // ARQ_*
+bool   arq_pop(arq_state_t *a, uint8_t *out, size_t *len, link_rx_t *rx, int64_t now_us, bool flush);  // Proximo em ordem
+size_t arq_ack_encode(const arq_state_t *a, uint8_t node, uint8_t *buf, size_t size);    // LINK_T_ACK
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
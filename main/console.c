@@ -0,0 +1,391 @@
+//=======================================================================================================
+//
+//   Title: UART command console.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/uart.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+#include "console.h"
+#include "instr.h"
+#include "radio.h"
+#include "settings.h"
+#include "flashlog.h"
+#include "transport.h"
+#include "pktpool.h"
+#include "alarm.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define CONSOLE_UART  CONFIG_ESP_CONSOLE_UART_NUM
+#define CONSOLE_LINE  64
+#define CONSOLE_ARGS  8                       // "alarm add campo > limiar hist hold no"
+#define TPUT_LINE     100                     // Tamanho de uma linha CSV tipica do uplink
+#define TPUT_MAX_KB   4096                    // ~6 min a 115200; tambem evita a volta do kB * 1024
+static const char *TAG6 = "CONSOLE";
+
+//=======================================================================================================
+//--- Types ---
+typedef struct{
+    const char *name;
+    void      (*run)(int argc, char **argv);
+    const char *help;
+}console_cmd_t;
+
+//=======================================================================================================
+//--- Variaveis ---
+static const console_ops_t *Ops;
+static volatile uplink_fmt_t Uplink = UPLINK_CSV;      // Lido pelo DataExcel a cada amostra
+static uint8_t               Profile;
+static StackType_t           ConsoleStack[CONFIG_STACK_CONSOLE];
+static StaticTask_t          ConsoleTcb;
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static void ConsoleTask(void *p);
+static void Exec(char *line);
+static void Reply(const char *cmd, bool ok, const char *msg);
+static void CmdHelp(int argc, char **argv);
+static void CmdProfile(int argc, char **argv);
+static void CmdRegs(int argc, char **argv);
+static void CmdStats(int argc, char **argv);
+static void CmdLog(int argc, char **argv);
+static void CmdUplink(int argc, char **argv);
+static void CmdTput(int argc, char **argv);
+static void CmdCapture(int argc, char **argv);
+static void CmdAlarm(int argc, char **argv);
+
+static const console_cmd_t Cmds[] = {
+  {"help",    CmdHelp,    "lista os comandos"},
+  {"profile", CmdProfile, "[longo|padrao|rapido] perfil de radio"},
+  {"regs",    CmdRegs,    "registradores do SX1276"},
+  {"stats",   CmdStats,   "relatorio de instrumentacao"},
+  {"log",     CmdLog,     "start [raw]|stop|dump|erase|status log em flash"},
+  {"uplink",  CmdUplink,  "[csv|json] formato do uplink"},
+  {"tput",    CmdTput,    "[kB] vazao da porta do uplink"},
+  {"capture", CmdCapture, "[on|off] pacotes brutos ($RAW) no uplink"},
+  {"alarm",   CmdAlarm,   "[add campo >|< limiar [hist] [hold_ms] [no]|del n|clear] regras de alarme"},
+};
+#define NCMDS (sizeof(Cmds) / sizeof(Cmds[0]))
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- console_start ---
+void console_start(const console_ops_t *ops, uint8_t profile)
+{
+  Ops     = ops;
+  Profile = profile;
+  // Com o uplink na UART o driver ja esta instalado (com RX); senao so o RX passa pelo driver e o
+  // stdout continua escrevendo direto no FIFO (VFS)
+  if(!uart_is_driver_installed(CONSOLE_UART) && uart_driver_install(CONSOLE_UART, 256, 0, 0, NULL, 0) != ESP_OK)
+  {
+    ESP_LOGE(TAG6, "UART%d indisponivel: console desligado", CONSOLE_UART);
+    return;
+  }//end if
+  xTaskCreateStaticPinnedToCore(ConsoleTask,"Console",sizeof(ConsoleStack),NULL,CONFIG_PRIO_CONSOLE,ConsoleStack,&ConsoleTcb,CONFIG_APP_CORE);
+}//end console_start
+
+//=======================================================================================================
+//--- console_uplink ---
+uplink_fmt_t console_uplink(void)
+{
+  return Uplink;
+}//end console_uplink
+
+//=======================================================================================================
+//--- ConsoleTask ---
+// Espera o primeiro byte (acorda assim que ele chega) e pega o resto do que ja esta no buffer.
+static void ConsoleTask(void *p)
+{
+  char    line[CONSOLE_LINE];
+  size_t  len = 0;
+  bool    overflow = false;
+  uint8_t rx[32];
+
+  while(true)
+  {
+    int n = uart_read_bytes(CONSOLE_UART, rx, 1, portMAX_DELAY);
+    if(n > 0)
+    {
+      size_t more = 0;
+      uart_get_buffered_data_len(CONSOLE_UART, &more);
+      if(more)
+        n += uart_read_bytes(CONSOLE_UART, rx + 1, more < sizeof(rx) - 1 ? more : sizeof(rx) - 1, 0);
+    }//end if
+
+    for(int i = 0; i < n; i++)
+    {
+      char c = (char)rx[i];
+      if(c == '\r' || c == '\n')
+      {
+        if(overflow)
+          Reply("?", false, "linha longa demais");
+        else if(len)
+        {
+          int64_t t0 = esp_timer_get_time();
+          line[len] = '\0';
+          Exec(line);
+          instr_latency(INSTR_LAT_CMD, esp_timer_get_time() - t0);
+        }//end else if
+        len      = 0;
+        overflow = false;
+      }//end if
+      else if(len < sizeof(line) - 1)
+        line[len++] = c;
+      else
+        overflow = true;
+    }//end for
+  }//end while
+}//end ConsoleTask
+
+//=======================================================================================================
+//--- Exec ---
+static void Exec(char *line)
+{
+  char *argv[CONSOLE_ARGS];
+  int   argc = 0;
+  char *save;
+
+  for(char *tok = strtok_r(line, " \t", &save); tok && argc < CONSOLE_ARGS; tok = strtok_r(NULL, " \t", &save))
+    argv[argc++] = tok;
+  if(argc == 0)
+    return;
+  for(size_t i = 0; i < NCMDS; i++)
+  {
+    if(strcmp(argv[0], Cmds[i].name) == 0)
+    {
+      Cmds[i].run(argc, argv);
+      return;
+    }//end if
+  }//end for
+  Reply(argv[0], false, "comando desconhecido (help)");
+}//end Exec
+
+//=======================================================================================================
+//--- Reply ---
+static void Reply(const char *cmd, bool ok, const char *msg)
+{
+  printf("$CMD,%s,%s,%s\n", cmd, ok ? "ok" : "erro", msg);
+}//end Reply
+
+//=======================================================================================================
+//--- CmdHelp ---
+static void CmdHelp(int argc, char **argv)
+{
+  for(size_t i = 0; i < NCMDS; i++)
+    printf("$CMD,help,%s,%s\n", Cmds[i].name, Cmds[i].help);
+}//end CmdHelp
+
+//=======================================================================================================
+//--- CmdProfile ---
+static void CmdProfile(int argc, char **argv)
+{
+  if(argc < 2)
+  {
+    Reply("profile", true, radio_profile(Profile)->name);
+    return;
+  }//end if
+  for(uint8_t id = 0; id < RADIO_PROFILE_COUNT; id++)
+  {
+    if(strcmp(argv[1], radio_profile(id)->name) != 0)
+      continue;
+    if(!Ops->radio_profile(id))
+    {
+      Reply("profile", false, "radio nao respondeu");
+      return;
+    }//end if
+    Profile = id;
+    settings_save_radio_profile(id);
+    Reply("profile", true, radio_profile(id)->name);
+    return;
+  }//end for
+  Reply("profile", false, "perfil desconhecido");
+}//end CmdProfile
+
+//=======================================================================================================
+//--- CmdRegs ---
+static void CmdRegs(int argc, char **argv)
+{
+  Reply("regs", Ops->radio_dump(), "");
+}//end CmdRegs
+
+//=======================================================================================================
+//--- CmdStats ---
+static void CmdStats(int argc, char **argv)
+{
+  instr_report();
+  Reply("stats", true, "");
+}//end CmdStats
+
+//=======================================================================================================
+//--- CmdLog ---
+static void CmdLog(int argc, char **argv)
+{
+  const char *sub = argc > 1 ? argv[1] : "status";
+  esp_err_t   ret = ESP_OK;
+
+  if(strcmp(sub, "start") == 0)
+    ret = flashlog_start(argc > 2 && strcmp(argv[2], "raw") == 0);
+  else if(strcmp(sub, "stop") == 0)
+    flashlog_stop();
+  else if(strcmp(sub, "dump") == 0)
+    ret = flashlog_dump();
+  else if(strcmp(sub, "erase") == 0)
+    ret = flashlog_erase();
+  else if(strcmp(sub, "status") != 0)
+  {
+    Reply("log", false, "use start [raw]|stop|dump|erase|status");
+    return;
+  }//end else if
+
+  if(ret != ESP_OK)
+  {
+    Reply("log", false, esp_err_to_name(ret));
+    return;
+  }//end if
+  uint32_t used, size, dropped;
+  flashlog_status(&used, &size, &dropped);
+  printf("$CMD,log,ok,%s,%s,%lu,%lu,%lu\n", flashlog_active() ? "gravando" : "parado", flashlog_raw() ? "raw" : "csv",
+         (unsigned long)used, (unsigned long)size, (unsigned long)dropped);
+}//end CmdLog
+
+//=======================================================================================================
+//--- CmdUplink ---
+static void CmdUplink(int argc, char **argv)
+{
+  if(argc > 1)
+  {
+    uplink_fmt_t fmt = UPLINK_FMT_COUNT;
+    for(int f = 0; f < UPLINK_FMT_COUNT; f++)
+    {
+      if(strcmp(argv[1], uplink_format_name((uplink_fmt_t)f)) == 0)
+        fmt = (uplink_fmt_t)f;
+    }//end for
+    if(fmt == UPLINK_FMT_COUNT)
+    {
+      Reply("uplink", false, "formato desconhecido");
+      return;
+    }//end if
+    Uplink = fmt;
+  }//end if
+  Reply("uplink", true, uplink_format_name(Uplink));
+}//end CmdUplink
+
+//=======================================================================================================
+//--- CmdTput ---
+// Escreve linhas '$TPUT' (ignoradas pelo PC como as outras '$') pela porta do uplink o mais rapido
+// possivel e espera o buffer esvaziar. tools/uplink_tput.py mede o mesmo fluxo do lado do PC.
+static void CmdTput(int argc, char **argv)
+{
+  char          line[TPUT_LINE + 1];
+  unsigned long kb   = argc > 1 ? strtoul(argv[1], NULL, 10) : 64;
+  uint32_t      sent = 0;
+
+  if(kb == 0 || kb > TPUT_MAX_KB)
+  {
+    Reply("tput", false, "tamanho invalido");
+    return;
+  }//end if
+  uint32_t total = (uint32_t)kb * 1024;
+  int64_t t0 = esp_timer_get_time();
+  for(uint32_t i = 0; sent < total; i++)
+  {
+    int w = snprintf(line, sizeof(line), "$TPUT,%lu,", (unsigned long)i);
+    memset(&line[w], 'x', TPUT_LINE - 1 - w);
+    line[TPUT_LINE - 1] = '\n';
+    if(transport_write(line, TPUT_LINE) < TPUT_LINE)
+      break;                                                // Porta parada: mede o que saiu
+    sent += TPUT_LINE;
+  }//end for
+  esp_err_t ret = transport_flush(5000);
+  int64_t   us  = esp_timer_get_time() - t0;
+
+  printf("$CMD,tput,%s,%s,%lu,%lu,%lu\n", ret == ESP_OK ? "ok" : "enfileirado", transport_name(),
+         (unsigned long)sent, (unsigned long)(us / 1000), (unsigned long)(us > 0 ? sent * 1000ULL / us : 0));
+}//end CmdTput
+
+//=======================================================================================================
+//--- CmdCapture ---
+// Liga o tap de captura do pktpool; o DataExcel escreve as linhas $RAW entre as amostras.
+static void CmdCapture(int argc, char **argv)
+{
+  if(argc > 1)
+  {
+    if(strcmp(argv[1], "on") != 0 && strcmp(argv[1], "off") != 0)
+    {
+      Reply("capture", false, "use on|off");
+      return;
+    }//end if
+    pktpool_tap(PKT_TAP_CAPTURE, strcmp(argv[1], "on") == 0);
+  }//end if
+  Reply("capture", true, pktpool_tapped(PKT_TAP_CAPTURE) ? "on" : "off");
+}//end CmdCapture
+
+//=======================================================================================================
+//--- CmdAlarm ---
+// Edita a lista, grava na NVS e recompila a tabela do radio; responde com a lista inteira ($ALR).
+static void CmdAlarm(int argc, char **argv)
+{
+  alarm_rule_t rules[ALARM_RULE_MAX];
+  size_t       n   = alarm_get_rules(rules);
+  const char  *sub = argc > 1 ? argv[1] : "list";
+  char         line[ALARM_LINE_MAX];
+
+  if(strcmp(sub, "add") == 0)
+  {
+    if(n == ALARM_RULE_MAX || alarm_parse_rule(argc - 2, &argv[2], &rules[n]) != 0)
+    {
+      Reply("alarm", false, n == ALARM_RULE_MAX ? "lista cheia" : "use add campo >|< limiar [hist] [hold_ms] [no]");
+      return;
+    }//end if
+    n++;
+  }//end if
+  else if(strcmp(sub, "del") == 0)
+  {
+    unsigned long i = argc > 2 ? strtoul(argv[2], NULL, 10) : n;
+    if(i >= n)
+    {
+      Reply("alarm", false, "regra inexistente");
+      return;
+    }//end if
+    memmove(&rules[i], &rules[i + 1], (n - i - 1) * sizeof(rules[0]));
+    n--;
+  }//end else if
+  else if(strcmp(sub, "clear") == 0)
+    n = 0;
+  else if(strcmp(sub, "list") != 0)
+  {
+    Reply("alarm", false, "use add|del|clear");
+    return;
+  }//end else if
+
+  if(strcmp(sub, "list") != 0)
+  {
+    if(!alarm_set_rules(rules, n))
+    {
+      Reply("alarm", false, "regra invalida");
+      return;
+    }//end if
+    settings_save_alarms(rules, n);
+  }//end if
+  for(size_t i = 0; i < n; i++)
+    fputs(alarm_format_rule((uint8_t)i, &rules[i], line, sizeof(line)) ? line : "", stdout);
+  snprintf(line, sizeof(line), "%u", (unsigned)n);
+  Reply("alarm", true, line);
+}//end CmdAlarm
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,52 @@
+//=======================================================================================================
+//
+//   Title: UART command console.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Comandos de uma linha na mesma UART do uplink. As respostas saem com prefixo '$CMD', como as
+//   linhas '$' do instr, para o PC separa-las do CSV:
+//     help                             lista os comandos
+//     profile [longo|padrao|rapido]    mostra/troca o perfil de radio (gravado na NVS)
+//     regs                             registradores do SX1276
+//     stats                            relatorio de instrumentacao ($TSK/$LAT/$NODE/$LINK/$PWR)
+//     log start [raw]|stop|dump|erase|status
+//                                      log das amostras (ou dos pacotes brutos) na particao "tlog"
+//     uplink [csv|json]                formato das amostras na serial
+//     tput [kB]                        vazao da porta do uplink: $CMD,tput,ok,porta,bytes,ms,kB_s
+//                                      ("enfileirado" quando a porta nao sabe esperar o buffer esvaziar)
+//     capture [on|off]                 pacotes brutos no uplink, uma linha $RAW cada (ver pktpool.h)
+//     alarm [add campo >|< limiar [hist] [hold_ms] [no]|del n|clear]
+//                                      regras de alarme (gravadas na NVS); lista como
+//                                      $ALR,n,campo,op,limiar,hist,hold_ms,no (ver alarm.h)
+//   A task roda com prioridade baixa no nucleo de aplicacao e nunca toca no SPI: o que mexe no radio
+//   e repassado a task do radio (console_ops_t), que aplica entre dois frames. O tempo de cada
+//   comando entra no histograma $LAT,cmd.
+//=======================================================================================================
+
+#ifndef CONSOLE_h
+#define CONSOLE_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include "uplink.h"
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    bool (*radio_profile)(uint8_t id);        // Troca o perfil na task do radio; false = sem resposta
+    bool (*radio_dump)(void);                 // lora_dump_registers na task do radio
+}console_ops_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void         console_start(const console_ops_t *ops, uint8_t profile);  // UART RX + task do console
+uplink_fmt_t console_uplink(void);                                      // Formato do uplink serial
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,220 @@
+//=======================================================================================================
+//
+//   Title: Delta/varint telemetry frames.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <math.h>
+#include <string.h>
+#include "delta.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define MASK_FIX     0x01
+#define MASK_ABS_POS 0x02
+#define MASK_TIME    0x04
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static void     quantize(const telemetry_sample_t *s, int32_t *v);
+static void     dequantize(const int32_t *v, bool fix, telemetry_sample_t *s);
+static uint8_t *put_varint(uint8_t *p, int32_t v);
+static bool     get_varint(const uint8_t **p, const uint8_t *end, int32_t *v);
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- delta_reset ---
+void delta_reset(delta_state_t *d)
+{
+  memset(d, 0, sizeof(*d));
+}//end delta_reset
+
+//=======================================================================================================
+//--- delta_decode ---
+bool delta_decode(delta_state_t *d, const link_frame_t *f, telemetry_sample_t *out)
+{
+  const uint8_t *p   = f->payload;
+  const uint8_t *end = f->payload + f->plen;
+  bool           key = (f->type == LINK_T_KEY);
+  int32_t        v[DF_COUNT];
+
+  if(!f->has_hdr || (!key && f->type != LINK_T_DELTA))
+    return false;
+  if(!key)
+  {
+    if(p >= end || !d->valid || *p != d->key_seq)
+    {
+      d->resync_drops++;                      // Keyframe perdido: espera o proximo
+      return false;
+    }//end if
+    p++;
+  }//end if
+  if(p >= end)
+    return false;
+
+  uint8_t mask = *p++;
+  bool    fix  = (mask & MASK_FIX) != 0;
+  int     n    = fix ? DF_COUNT : DF_LAT;
+  for(int i = 0; i < n; i++)
+  {
+    if(!get_varint(&p, end, &v[i]))
+      return false;
+  }//end for
+  int32_t t = 0;
+  if((mask & MASK_TIME) && !get_varint(&p, end, &t))
+    return false;
+  if(p != end)
+    return false;
+
+  if(key)
+  {
+    memcpy(d->ref, v, sizeof(v));
+    d->valid   = true;
+    d->fix     = fix;
+    d->key_seq = f->seq;
+    d->ref_t   = (mask & MASK_TIME) ? (uint32_t)t : 0;
+    d->keys++;
+  }//end if
+  else
+  {
+    for(int i = 0; i < DF_LAT; i++)
+      v[i] += d->ref[i];
+    if(fix && !(mask & MASK_ABS_POS))
+    {
+      v[DF_LAT] += d->ref[DF_LAT];
+      v[DF_LON] += d->ref[DF_LON];
+    }//end if
+    d->deltas++;
+  }//end else
+  dequantize(v, fix, out);
+  if(mask & MASK_TIME)
+  {
+    out->t_tx_us = key ? (uint32_t)t : d->ref_t + (uint32_t)t;
+    out->flags  |= TELEM_FLAG_TTX;
+  }//end if
+  return true;
+}//end delta_decode
+
+//=======================================================================================================
+//--- delta_enc_reset ---
+void delta_enc_reset(delta_enc_t *e)
+{
+  memset(e, 0, sizeof(*e));
+}//end delta_enc_reset
+
+//=======================================================================================================
+//--- delta_encode ---
+size_t delta_encode(delta_enc_t *e, const telemetry_sample_t *s, uint8_t node, uint8_t seq,
+                    uint8_t *buf, size_t size)
+{
+  int32_t  v[DF_COUNT];
+  bool     fix = (s->flags & TELEM_FLAG_FIX) != 0;
+  bool     key = !e->ref.valid || (e->n % DELTA_KEY_INTERVAL) == 0;
+  uint8_t  tm  = (s->flags & TELEM_FLAG_TTX) ? MASK_TIME : 0;
+  uint8_t *p;
+
+  if(size < DELTA_FRAME_MAX)
+    return 0;
+  quantize(s, v);
+  p = buf + link_encode_hdr(buf, key ? LINK_T_KEY : LINK_T_DELTA, node, 0, seq);
+  if(key)
+  {
+    *p++ = (uint8_t)((fix ? MASK_FIX : 0) | tm);
+    memcpy(e->ref.ref, v, sizeof(v));
+    e->ref.valid   = true;
+    e->ref.fix     = fix;
+    e->ref.key_seq = seq;
+    e->ref.ref_t   = tm ? s->t_tx_us : 0;
+  }//end if
+  else
+  {
+    bool absPos = fix && !e->ref.fix;
+    *p++ = e->ref.key_seq;
+    *p++ = (uint8_t)((fix ? MASK_FIX : 0) | (absPos ? MASK_ABS_POS : 0) | tm);
+    for(int i = 0; i < DF_COUNT; i++)
+    {
+      if(i < DF_LAT || !absPos)
+        v[i] -= e->ref.ref[i];
+    }//end for
+  }//end else
+  for(int i = 0; i < (fix ? DF_COUNT : DF_LAT); i++)
+    p = put_varint(p, v[i]);
+  if(tm)
+    p = put_varint(p, (int32_t)(key ? s->t_tx_us : s->t_tx_us - e->ref.ref_t));
+  e->n++;
+  return (size_t)(p - buf);
+}//end delta_encode
+
+//=======================================================================================================
+//--- quantize / dequantize ---
+// Mesma resolucao do frame ASCII do transmissor (%.2f / %.3f): a conversao nao perde informacao.
+static void quantize(const telemetry_sample_t *s, int32_t *v)
+{
+  v[DF_PITCH]    = (int32_t)lrintf(s->anglePitchDeg * 100.0f);
+  v[DF_ROLL]     = (int32_t)lrintf(s->angleRollDeg * 100.0f);
+  v[DF_TEMP]     = (int32_t)lrintf(s->temp * 100.0f);
+  v[DF_PRESSURE] = (int32_t)s->pressure_bmp;
+  v[DF_ALT]      = (int32_t)lrintf(s->altitude * 100.0f);
+  v[DF_SPEED]    = (int32_t)lrintf(s->speed * 1000.0f);
+  v[DF_SNR]      = s->SNR;
+  v[DF_LAT]      = s->lat_e7;
+  v[DF_LON]      = s->lon_e7;
+}//end quantize
+
+static void dequantize(const int32_t *v, bool fix, telemetry_sample_t *s)
+{
+  memset(s, 0, sizeof(*s));
+  s->anglePitchDeg = (float)v[DF_PITCH] / 100.0f;
+  s->angleRollDeg  = (float)v[DF_ROLL] / 100.0f;
+  s->temp          = (float)v[DF_TEMP] / 100.0f;
+  s->pressure_bmp  = (uint32_t)v[DF_PRESSURE];
+  s->altitude      = (float)v[DF_ALT] / 100.0f;
+  s->speed         = (float)v[DF_SPEED] / 1000.0f;
+  s->SNR           = (uint8_t)v[DF_SNR];
+  s->lat_e7        = fix ? v[DF_LAT] : TELEM_COORD_INVALID;
+  s->lon_e7        = fix ? v[DF_LON] : TELEM_COORD_INVALID;
+  if(fix)
+    s->flags |= TELEM_FLAG_FIX;
+}//end dequantize
+
+//=======================================================================================================
+//--- put_varint / get_varint ---
+// zig-zag: 0,-1,1,-2... -> 0,1,2,3...; depois 7 bits por byte, bit 7 = continua
+static uint8_t *put_varint(uint8_t *p, int32_t v)
+{
+  uint32_t z = ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+  while(z >= 0x80)
+  {
+    *p++ = (uint8_t)(z | 0x80);
+    z >>= 7;
+  }//end while
+  *p++ = (uint8_t)z;
+  return p;
+}//end put_varint
+
+static bool get_varint(const uint8_t **p, const uint8_t *end, int32_t *v)
+{
+  uint32_t z = 0;
+  for(int shift = 0; shift < 35; shift += 7)
+  {
+    if(*p >= end)
+      return false;
+    uint8_t b = *(*p)++;
+    z |= (uint32_t)(b & 0x7F) << shift;
+    if(!(b & 0x80))
+    {
+      *v = (int32_t)(z >> 1) ^ -(int32_t)(z & 1);
+      return true;
+    }//end if
+  }//end for
+  return false;
+}//end get_varint
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,72 @@
+//=======================================================================================================
+//
+//   Title: Delta/varint telemetry frames.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Alternativa binaria ao frame ASCII. Os campos sao quantizados na mesma resolucao que o ASCII
+//   usa (angulos/temperatura/altitude em 0.01, velocidade em 0.001, pressao em Pa, lat/lon em 1e-7
+//   graus), entao nada se perde. Um keyframe (LINK_T_KEY) leva os valores absolutos; os frames
+//   seguintes (LINK_T_DELTA) levam a diferenca contra o ultimo keyframe:
+//
+//     LINK_T_KEY:   [mascara][v0]...[vn]          seq do cabecalho = identificador do keyframe
+//     LINK_T_DELTA: [seq do keyframe][mascara][d0]...[dn]
+//
+//   Todo valor e zig-zag + varint LEB128 (1 byte para |d| < 64). Mascara: bit 0 = lat/lon presentes,
+//   bit 1 = lat/lon absolutos (o keyframe nao tinha fix), bit 2 = relogio do transmissor na medida
+//   (us, ultimo valor; no delta, diferenca mod 2^32 contra o do keyframe). Um delta cujo keyframe nao
+//   chegou e descartado ate o proximo keyframe (ressincronizacao).
+//=======================================================================================================
+
+#ifndef DELTA_h
+#define DELTA_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "link.h"
+#include "telemetry.h"
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+#define DELTA_KEY_INTERVAL 16                 // Keyframe a cada N frames no codificador
+#define DELTA_FRAME_MAX    (LINK_HDR_LEN + 2 + 10 * 5)
+
+enum{
+  DF_PITCH = 0, DF_ROLL, DF_TEMP, DF_PRESSURE, DF_ALT, DF_SPEED, DF_SNR, DF_LAT, DF_LON, DF_COUNT
+};
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    bool     valid;                           // Ha keyframe de referencia
+    bool     fix;                             // O keyframe tinha lat/lon
+    uint8_t  key_seq;
+    int32_t  ref[DF_COUNT];
+    uint32_t ref_t;                           // Relogio do transmissor no keyframe (0 sem tempo)
+    uint32_t keys;
+    uint32_t deltas;
+    uint32_t resync_drops;                    // Deltas sem o keyframe correspondente
+}delta_state_t;
+
+typedef struct{
+    uint32_t n;                               // Frames codificados
+    delta_state_t ref;                        // Mesmo estado que o receptor mantem
+}delta_enc_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void   delta_reset(delta_state_t *d);
+bool   delta_decode(delta_state_t *d, const link_frame_t *f, telemetry_sample_t *out);   // KEY ou DELTA -> amostra
+void   delta_enc_reset(delta_enc_t *e);
+size_t delta_encode(delta_enc_t *e, const telemetry_sample_t *s, uint8_t node, uint8_t seq,
+                    uint8_t *buf, size_t size);                                        // Frame completo (com cabecalho)
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,180 @@
+//=======================================================================================================
+//
+//   Title: Character display layer (cell framebuffer, widgets and display drivers).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include "display.h"
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+//=======================================================================================================
+//--- Const and Macro ---
+#if defined CONFIG_DISPLAY_SSD1306
+#define DISPLAY_OPS DisplaySsd1306
+#else
+#define DISPLAY_OPS DisplayHd44780
+#endif
+
+// Niveis do sparkline: '_' e a linha de baixo da fonte, entao o minimo ainda aparece
+static const uint8_t SparkLevel[] = {'_', DISP_G_VBAR, DISP_G_VBAR + 1, DISP_G_VBAR + 2, DISP_FULL};
+#define SPARK_LEVELS (sizeof(SparkLevel) - 1)
+
+//=======================================================================================================
+//--- Variaveis ---
+// So a task do menu usa o display
+static const display_ops_t *Drv = &DISPLAY_OPS;
+static uint8_t  Fb[DISP_ROWS_MAX][DISP_COLS_MAX];     // O que as telas querem
+static uint8_t  Shown[DISP_ROWS_MAX][DISP_COLS_MAX];  // O que o display tem
+static bool     Synced;                               // Shown vale (falso depois de uma escrita direta)
+static uint32_t BusBytes;
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- disp_Start ---
+esp_err_t disp_Start(void)
+{
+  esp_err_t err = Drv->init();
+
+  memset(Fb, ' ', sizeof(Fb));
+  memset(Shown, ' ', sizeof(Shown));
+  Synced = err == ESP_OK;
+  return err;
+}//end disp_Start
+
+//=======================================================================================================
+//--- disp_Cols ---
+uint8_t disp_Cols(void)
+{
+  return Drv->cols;
+}//end disp_Cols
+
+//=======================================================================================================
+//--- disp_Rows ---
+uint8_t disp_Rows(void)
+{
+  return Drv->rows;
+}//end disp_Rows
+
+//=======================================================================================================
+//--- disp_Name ---
+const char *disp_Name(void)
+{
+  return Drv->name;
+}//end disp_Name
+
+//=======================================================================================================
+//--- disp_Invalidate ---
+void disp_Invalidate(void)
+{
+  Synced = false;
+}//end disp_Invalidate
+
+//=======================================================================================================
+//--- disp_FbClear ---
+void disp_FbClear(void)
+{
+  memset(Fb, ' ', sizeof(Fb));
+}//end disp_FbClear
+
+//=======================================================================================================
+//--- disp_FbPutc ---
+void disp_FbPutc(uint8_t row, uint8_t col, uint8_t chr)
+{
+  if(row < Drv->rows && col < Drv->cols)
+    Fb[row][col] = chr;
+}//end disp_FbPutc
+
+//=======================================================================================================
+//--- disp_FbPuts ---
+void disp_FbPuts(uint8_t row, uint8_t col, const char *s)
+{
+  if(row >= Drv->rows)
+    return;
+  while(*s && col < Drv->cols)
+    Fb[row][col++] = (uint8_t)*s++;
+}//end disp_FbPuts
+
+//=======================================================================================================
+//--- disp_FbBar ---
+void disp_FbBar(uint8_t row, uint8_t col, uint8_t cells, float frac)
+{
+  if(!(frac > 0.0f))                    // Tambem pega NaN
+    frac = 0.0f;
+  else if(frac > 1.0f)
+    frac = 1.0f;
+  int steps = (int)(frac * cells * 5 + 0.5f);
+  for(uint8_t i = 0; i < cells; i++, steps -= 5)
+    disp_FbPutc(row, col + i, steps >= 5 ? DISP_FULL : steps <= 0 ? ' ' : DISP_G_HBAR + steps - 1);
+}//end disp_FbBar
+
+//=======================================================================================================
+//--- disp_FbSpark ---
+// Escala entre o minimo e o maximo da propria serie: mostra a forma, nao o valor.
+void disp_FbSpark(uint8_t row, uint8_t col, const float *v, uint8_t n)
+{
+  float lo = v[0], hi = v[0];
+
+  for(uint8_t i = 1; i < n; i++)
+  {
+    if(v[i] < lo)
+      lo = v[i];
+    if(v[i] > hi)
+      hi = v[i];
+  }//end for
+  for(uint8_t i = 0; i < n; i++)
+  {
+    int k = hi > lo ? (int)((v[i] - lo) / (hi - lo) * SPARK_LEVELS + 0.5f) : 0;
+    disp_FbPutc(row, col + i, SparkLevel[k < 0 ? 0 : k > (int)SPARK_LEVELS ? (int)SPARK_LEVELS : k]);
+  }//end for
+}//end disp_FbSpark
+
+//=======================================================================================================
+//--- disp_Flush ---
+// Cada sequencia de celulas diferentes numa linha vira um blit; o driver junta tudo numa transferencia.
+// Uma tela igual a anterior nao gera trafego.
+uint32_t disp_Flush(void)
+{
+  for(uint8_t r = 0; r < Drv->rows; r++)
+  {
+    uint8_t c = 0;
+    while(c < Drv->cols)
+    {
+      if(Synced && Fb[r][c] == Shown[r][c])
+      {
+        c++;
+        continue;
+      }//end if
+      uint8_t start = c;
+      while(c < Drv->cols && !(Synced && Fb[r][c] == Shown[r][c]))
+      {
+        Shown[r][c] = Fb[r][c];
+        c++;
+      }//end while
+      Drv->blit(r, start, &Fb[r][start], c - start);
+    }//end while
+  }//end for
+  Synced = true;
+
+  uint32_t sent = Drv->flush();
+  BusBytes += sent;
+  return sent;
+}//end disp_Flush
+
+//=======================================================================================================
+//--- disp_BusBytes ---
+uint32_t disp_BusBytes(void)
+{
+  return BusBytes;
+}//end disp_BusBytes
+
+//=======================================================================================================
+//--- End of Program ---
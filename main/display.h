@@ -0,0 +1,78 @@
+//=======================================================================================================
+//
+//   Title: Character display layer (cell framebuffer, widgets and display drivers).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   As telas desenham num quadro de celulas (um byte por caractere) do tamanho do display escolhido no
+//   menuconfig e chamam disp_Flush. O flush compara com o que o display ja tem e passa ao driver so as
+//   sequencias de celulas que mudaram (blit); o flush do driver manda a regiao suja numa transferencia:
+//     - HD44780 16x2 ou 20x4 atras de um PCF8574: endereco da DDRAM + caracteres, um I2C por flush.
+//     - SSD1306 128x64: cada celula vira 6 colunas de 8 pontos (fonte 5x7) num quadro de 1 KB; por
+//       pagina so a faixa de colunas sujas vai pelo I2C. 21x8 celulas.
+//   Os codigos DISP_G_* sao os mesmos em todos os drivers (CGRAM no HD44780, bitmaps no SSD1306), entao
+//   uma tela nao sabe para qual display esta desenhando; so disp_Cols/disp_Rows mudam.
+//=======================================================================================================
+
+#ifndef DISPLAY_h
+#define DISPLAY_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#ifdef ESP_PLATFORM
+#include "esp_err.h"
+#else
+typedef int esp_err_t;                        // Bench no host (bench/displaycheck.c)
+#define ESP_OK 0
+#endif
+
+//=======================================================================================================
+//--- Macros and Constants ---
+#define DISP_COLS_MAX   21                    // SSD1306: 128 / 6 pontos
+#define DISP_ROWS_MAX   8                     // SSD1306: 64 / 8 pontos
+
+// Caracteres graficos. Os codigos 0x08-0x0F espelham a CGRAM 0x00-0x07 do HD44780, entao cabem numa
+// string C sem o terminador no meio.
+#define DISP_G_HBAR     0x08                  // +0..3: barra horizontal de 1 a 4 quintos (da esquerda)
+#define DISP_G_VBAR     0x0C                  // +0..2: coluna de 2, 4 e 6 linhas (de baixo)
+#define DISP_G_BELL     0x0F                  // Alarme ativo
+#define DISP_FULL       0xFF                  // Bloco cheio (ROM A00 do HD44780)
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    const char *name;                                           // "hd44780", "ssd1306"
+    uint8_t     cols, rows;                                     // Celulas (<= DISP_COLS_MAX x DISP_ROWS_MAX)
+    esp_err_t (*init)(void);                                    // Barramento + controlador; termina com a tela vazia
+    void      (*blit)(uint8_t row, uint8_t col, const uint8_t *cells, uint8_t n);  // Regiao para o quadro do driver
+    uint32_t  (*flush)(void);                                   // Manda a regiao suja; devolve os bytes no barramento
+}display_ops_t;
+
+//=======================================================================================================
+//--- Backends ---
+
+extern const display_ops_t DisplayHd44780;                      // lcd_jr.c (16x2 ou 20x4 pelo menuconfig)
+extern const display_ops_t DisplaySsd1306;                      // ssd1306.c
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+esp_err_t   disp_Start(void);                                                  // Driver do menuconfig, tela vazia
+uint8_t     disp_Cols(void);
+uint8_t     disp_Rows(void);
+const char *disp_Name(void);
+void        disp_Invalidate(void);                                             // Escrita fora do quadro: redesenha tudo
+void        disp_FbClear(void);                                                // Quadro com espacos
+void        disp_FbPutc(uint8_t row, uint8_t col, uint8_t chr);
+void        disp_FbPuts(uint8_t row, uint8_t col, const char *s);              // Corta no fim da linha
+void        disp_FbBar(uint8_t row, uint8_t col, uint8_t cells, float frac);   // Barra de 0..1, 5 passos por celula
+void        disp_FbSpark(uint8_t row, uint8_t col, const float *v, uint8_t n); // Uma celula por valor, mais antigo primeiro
+uint32_t    disp_Flush(void);                                                  // Devolve os bytes enviados
+uint32_t    disp_BusBytes(void);                                               // Total desde o boot
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,140 @@
+//=======================================================================================================
+//
+//   Title: Packet-level XOR parity (FEC) across groups of frames.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include "fec.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define GROUP(seq)  ((uint8_t)((seq) & ~(FEC_K - 1)))
+#define ALL_MASK    ((uint8_t)((1u << FEC_K) - 1))
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static void xor_into(uint8_t *acc, uint8_t *accLen, const uint8_t *p, size_t len);
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- fec_reset ---
+void fec_reset(fec_state_t *fs)
+{
+  memset(fs, 0, sizeof(*fs));
+}//end fec_reset
+
+//=======================================================================================================
+//--- fec_data ---
+void fec_data(fec_state_t *fs, uint8_t seq, const uint8_t *p, size_t len)
+{
+  if(len > FEC_FRAME_MAX)
+    return;
+  if(!fs->active || GROUP(seq) != fs->base)
+  {
+    // Grupo novo; se a paridade do anterior se perdeu, suas faltas ja foram contadas em node->lost
+    fs->active  = true;
+    fs->base    = GROUP(seq);
+    fs->have    = 0;
+    fs->acc_len = 0;
+    memset(fs->acc, 0, sizeof(fs->acc));
+  }//end if
+  uint8_t bit = (uint8_t)(1u << (seq - fs->base));
+  if(fs->have & bit)
+    return;                                   // Duplicata nao pode entrar duas vezes no XOR
+  fs->have |= bit;
+  xor_into(fs->acc, &fs->acc_len, p, len);
+}//end fec_data
+
+//=======================================================================================================
+//--- fec_parity ---
+size_t fec_parity(fec_state_t *fs, uint8_t seq, const uint8_t *p, size_t len, uint8_t *out, uint8_t *out_seq)
+{
+  if(len < 1 + FEC_K || p[0] != FEC_K || GROUP(seq) != seq)
+    return 0;
+  if(!fs->active || fs->base != seq)
+  {
+    // Nenhum dado deste grupo chegou: nao da para refazer nada
+    fs->unrecoverable += FEC_K;
+    return 0;
+  }//end if
+
+  uint8_t missing = (uint8_t)(ALL_MASK & ~fs->have);
+  fs->active = false;                         // Grupo fechado: frames atrasados nao entram mais
+  if(missing == 0)
+    return 0;
+  if(missing & (missing - 1))
+  {
+    for(; missing; missing &= (uint8_t)(missing - 1))
+      fs->unrecoverable++;
+    return 0;
+  }//end if
+
+  uint8_t idx = 0;
+  while(!(missing & (1u << idx)))
+    idx++;
+  const uint8_t *lens = p + 1;
+  const uint8_t *xr   = p + 1 + FEC_K;
+  size_t         xlen = len - 1 - FEC_K;
+  size_t         mlen = lens[idx];
+  if(mlen > xlen || mlen > FEC_FRAME_MAX)
+    return 0;
+
+  for(size_t i = 0; i < mlen; i++)
+    out[i] = (uint8_t)(xr[i] ^ fs->acc[i]);   // acc ja tem zeros alem do acc_len
+  *out_seq = (uint8_t)(seq + idx);
+  fs->recovered++;
+  return mlen;
+}//end fec_parity
+
+//=======================================================================================================
+//--- fec_enc_reset ---
+void fec_enc_reset(fec_enc_t *e)
+{
+  memset(e, 0, sizeof(*e));
+}//end fec_enc_reset
+
+//=======================================================================================================
+//--- fec_enc_add ---
+bool fec_enc_add(fec_enc_t *e, const uint8_t *p, size_t len)
+{
+  if(len > FEC_FRAME_MAX)
+    len = FEC_FRAME_MAX;
+  e->len[e->n++] = (uint8_t)len;
+  xor_into(e->acc, &e->acc_len, p, len);
+  return e->n == FEC_K;
+}//end fec_enc_add
+
+//=======================================================================================================
+//--- fec_enc_parity ---
+size_t fec_enc_parity(fec_enc_t *e, uint8_t *buf, size_t size)
+{
+  size_t len = 1 + FEC_K + e->acc_len;
+
+  if(size < len)
+    return 0;
+  buf[0] = FEC_K;
+  memcpy(buf + 1, e->len, FEC_K);
+  memcpy(buf + 1 + FEC_K, e->acc, e->acc_len);
+  fec_enc_reset(e);
+  return len;
+}//end fec_enc_parity
+
+//=======================================================================================================
+//--- xor_into ---
+static void xor_into(uint8_t *acc, uint8_t *accLen, const uint8_t *p, size_t len)
+{
+  for(size_t i = 0; i < len; i++)
+    acc[i] ^= p[i];
+  if(len > *accLen)
+    *accLen = (uint8_t)len;
+}//end xor_into
+
+//=======================================================================================================
+//--- End of Program ---
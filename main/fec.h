@@ -0,0 +1,81 @@
+//=======================================================================================================
+//
+//   Title: Packet-level XOR parity (FEC) across groups of frames.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   O transmissor agrupa FEC_K frames de dados consecutivos (seq alinhada em FEC_K) e, depois do
+//   ultimo, envia um LINK_T_PARITY com seq = primeiro frame do grupo e payload:
+//
+//     [k][len 0]...[len k-1][XOR dos k frames, completados com zeros ate o maior]
+//
+//   O XOR cobre o frame inteiro (cabecalho de enlace incluido), entao o frame refeito volta pelo
+//   despacho normal qualquer que seja o tipo (ASCII, keyframe, delta).
+//
+//   O receptor so acumula o XOR dos frames que chegaram (um buffer por no, sem guardar os frames).
+//   Se faltar exatamente um frame do grupo quando a paridade chega, ele e reconstruido sem
+//   retransmissao: faltante = paridade ^ acumulado. Custo: 1/K de tempo no ar a mais.
+//=======================================================================================================
+
+#ifndef FEC_h
+#define FEC_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "link.h"
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+#ifdef CONFIG_FEC_K
+#define FEC_K CONFIG_FEC_K
+#else
+#define FEC_K 4
+#endif
+#define FEC_K_MAX     8
+#define FEC_FRAME_MAX 128                     // Maior frame protegido
+#define FEC_PARITY_MAX (1 + FEC_K_MAX + FEC_FRAME_MAX)
+
+_Static_assert(FEC_K >= 2 && FEC_K <= FEC_K_MAX && (FEC_K & (FEC_K - 1)) == 0, "FEC_K deve ser 2, 4 ou 8");
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    bool     active;
+    uint8_t  base;                            // seq do primeiro frame do grupo corrente
+    uint8_t  have;                            // bit i = frame base+i recebido
+    uint8_t  acc_len;                         // Maior frame acumulado
+    uint8_t  acc[FEC_FRAME_MAX];              // XOR dos frames recebidos
+    uint32_t recovered;                       // Frames reconstruidos pela paridade
+    uint32_t unrecoverable;                   // Frames perdidos em grupos com 2+ faltas
+}fec_state_t;
+
+typedef struct{
+    uint8_t  n;                               // Frames ja no grupo
+    uint8_t  acc_len;
+    uint8_t  len[FEC_K_MAX];
+    uint8_t  acc[FEC_FRAME_MAX];
+}fec_enc_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void   fec_reset(fec_state_t *fs);
+void   fec_data(fec_state_t *fs, uint8_t seq, const uint8_t *p, size_t len);            // Frame de dados recebido
+size_t fec_parity(fec_state_t *fs, uint8_t seq, const uint8_t *p, size_t len,
+                  uint8_t *out, uint8_t *out_seq);                                      // Paridade: devolve o frame refeito (0 = nada)
+
+void   fec_enc_reset(fec_enc_t *e);
+bool   fec_enc_add(fec_enc_t *e, const uint8_t *p, size_t len);                         // true = grupo completo
+size_t fec_enc_parity(fec_enc_t *e, uint8_t *buf, size_t size);                         // Payload da paridade; reinicia o grupo
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,403 @@
+//=======================================================================================================
+//
+//   Title: Sample log on a flash partition.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "sdkconfig.h"
+#include "flashlog.h"
+#include "uplink.h"
+#include "pktpool.h"
+#include "transport.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define LOG_LABEL   "tlog"
+#define LOG_SUBTYPE 0x40                      // Dados "custom" (ver partitions.csv)
+#define LOG_SECTOR  4096
+#define LOG_AHEAD   4                         // Setores apagados a frente da escrita (16 KB de folga)
+#define LOG_CHUNK   256                       // Leitura do dump
+#define LOG_PREFIX  "$LOG,"                   // Linhas do dump na porta do uplink
+#define LOG_PREFIX_LEN (sizeof(LOG_PREFIX) - 1)
+#define LOG_DUMP_TRIES 10                     // Escritas recusadas seguidas (100 ms cada) antes de desistir
+static const char *TAG5 = "FLASHLOG";
+
+//=======================================================================================================
+//--- Types ---
+typedef enum{
+    REQ_NONE = 0,
+    REQ_START,
+    REQ_START_RAW,
+    REQ_STOP,
+    REQ_ERASE
+}req_t;
+
+//=======================================================================================================
+//--- Variaveis ---
+static const esp_partition_t *Part;
+static sample_ring_t         *Ring;
+static sample_reader_t        Reader;
+static bool                   Active;
+static bool                   Raw;            // Pacotes brutos do pool em vez das amostras
+static uint32_t               Pos;            // Setor de escrita (sempre apagado)
+static uint32_t               Ahead;          // Setores apagados a partir de Pos (>= 1)
+static uint32_t               Used;           // Setores com dados
+static uint32_t               Fill;           // Bytes em Sector
+static uint8_t                Sector[LOG_SECTOR];
+static char                   Line[PKT_LINE_MAX];
+
+// Toda gravacao e apagamento e feito pela task do log; o console so pede e espera
+static TaskHandle_t           Task;
+static volatile uint8_t       Req;            // req_t
+static esp_err_t              ReqRet;
+static SemaphoreHandle_t      ReqDone;
+static StaticSemaphore_t      ReqDoneBuf;
+static StackType_t            TaskStack[CONFIG_STACK_FLASHLOG];
+static StaticTask_t           TaskTcb;
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static void      FlashLogTask(void *p);
+static esp_err_t Request(req_t req);
+static esp_err_t Serve(req_t req);
+static void      Poll(void);
+static void      EraseAhead(void);
+static bool      SectorEmpty(uint32_t sec);
+static uint32_t  Sectors(void);
+static void      Flush(void);
+static void      Append(const char *line, size_t len);
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- flashlog_init ---
+esp_err_t flashlog_init(sample_ring_t *ring)
+{
+  Ring = ring;
+  Part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, LOG_SUBTYPE, LOG_LABEL);
+  if(Part == NULL)
+  {
+    ESP_LOGW(TAG5, "Sem particao '%s': log em flash indisponivel", LOG_LABEL);
+    return ESP_ERR_NOT_FOUND;
+  }//end if
+
+  // Fim do log = setor apagado logo depois de um com dados. Depois de uma volta o primeiro apagado pelo
+  // indice pode ser a folga a frente de setores antigos; o que vale e o comeco da sequencia de apagados.
+  // Tudo apagado comeca do zero; nenhum apagado (particao nova, nunca apagada) tambem.
+  uint32_t n    = Sectors();
+  bool     prev = n ? SectorEmpty(n - 1) : true;
+  Pos  = n;
+  Used = 0;
+  for(uint32_t s = 0; s < n; s++)
+  {
+    bool empty = SectorEmpty(s);
+    if(empty && !prev && Pos == n)
+      Pos = s;
+    if(!empty)
+      Used++;
+    prev = empty;
+  }//end for
+  if(Pos == n && Used == 0)
+    Pos = 0;
+  else if(Pos == n)
+  {
+    Pos  = 0;
+    Used = n - 1;                                           // Sem setor apagado: tratado como cheio
+    esp_partition_erase_range(Part, 0, LOG_SECTOR);
+  }//end if
+  for(Ahead = 1; Ahead < n && SectorEmpty((Pos + Ahead) % n); Ahead++);
+  if(Used > n - Ahead)
+    Used = n - Ahead;
+
+  ReqDone = xSemaphoreCreateBinaryStatic(&ReqDoneBuf);
+  Task    = xTaskCreateStaticPinnedToCore(FlashLogTask,"FlashLog",sizeof(TaskStack),NULL,CONFIG_PRIO_FLASHLOG,TaskStack,&TaskTcb,CONFIG_APP_CORE);
+  ESP_LOGI(TAG5, "Log em flash: %lu de %lu setores usados", (unsigned long)Used, (unsigned long)n);
+  return ESP_OK;
+}//end flashlog_init
+
+//=======================================================================================================
+//--- flashlog_start ---
+esp_err_t flashlog_start(bool raw)
+{
+  return Request(raw ? REQ_START_RAW : REQ_START);
+}//end flashlog_start
+
+//=======================================================================================================
+//--- flashlog_stop ---
+void flashlog_stop(void)
+{
+  Request(REQ_STOP);
+}//end flashlog_stop
+
+//=======================================================================================================
+//--- flashlog_active ---
+bool flashlog_active(void)
+{
+  return Active;
+}//end flashlog_active
+
+//=======================================================================================================
+//--- flashlog_dump ---
+// Setor a setor, do seguinte ao de escrita (o mais antigo) ate o anterior; cada setor termina no
+// primeiro 0xFF. Cada linha sai inteira pela porta do uplink com o prefixo $LOG (transport_write),
+// entao nao se mistura com as amostras que o DataExcel escreve durante o dump. Cede a CPU a cada
+// bloco; com a porta parada por mais de LOG_DUMP_TRIES escritas o dump desiste.
+esp_err_t flashlog_dump(void)
+{
+  static char buf[LOG_CHUNK];
+  static char line[LOG_PREFIX_LEN + PKT_LINE_MAX] = LOG_PREFIX;
+  uint32_t    n   = Sectors();
+  uint32_t    pos = Pos;                                    // A escrita pode andar durante o dump
+
+  if(Part == NULL)
+    return ESP_ERR_NOT_FOUND;
+  for(uint32_t i = 1; i <= n; i++)
+  {
+    uint32_t sec  = (pos + i) % n;
+    size_t   len  = LOG_PREFIX_LEN;                         // Append nunca parte uma linha entre setores
+    bool     over = false;
+    if(sec == pos)
+      break;
+    for(uint32_t off = 0; off < LOG_SECTOR; off += sizeof(buf))
+    {
+      esp_partition_read(Part, sec * LOG_SECTOR + off, buf, sizeof(buf));
+      char *end = memchr(buf, 0xFF, sizeof(buf));
+      size_t got = end ? (size_t)(end - buf) : sizeof(buf);
+      for(size_t k = 0; k < got; k++)
+      {
+        if(len < sizeof(line))
+          line[len++] = buf[k];
+        else
+          over = true;
+        if(buf[k] != '\n')
+          continue;
+        if(!over)                                           // Maior que o buffer (setor estragado): fica de fora
+        {
+          int tries = 0;
+          while(transport_write(line, len) == 0)
+          {
+            if(++tries >= LOG_DUMP_TRIES)
+              return ESP_ERR_TIMEOUT;
+          }//end while
+        }//end if
+        len  = LOG_PREFIX_LEN;
+        over = false;
+      }//end for
+      vTaskDelay(1);
+      if(end)
+        break;
+    }//end for
+  }//end for
+  return ESP_OK;
+}//end flashlog_dump
+
+//=======================================================================================================
+//--- flashlog_erase ---
+esp_err_t flashlog_erase(void)
+{
+  return Request(REQ_ERASE);
+}//end flashlog_erase
+
+//=======================================================================================================
+//--- flashlog_raw ---
+bool flashlog_raw(void)
+{
+  return Raw;
+}//end flashlog_raw
+
+//=======================================================================================================
+//--- flashlog_status ---
+// No modo bruto os descartados sao os pacotes que nao couberam no tap.
+void flashlog_status(uint32_t *used, uint32_t *size, uint32_t *dropped)
+{
+  pkt_stats_t ps;
+
+  pktpool_get_stats(&ps);
+  *used    = Used * LOG_SECTOR + Fill;
+  *size    = Part ? Sectors() * LOG_SECTOR : 0;
+  *dropped = Raw ? ps.dropped[PKT_TAP_FLASHLOG] : Reader.dropped;
+}//end flashlog_status
+
+//=======================================================================================================
+//--- FlashLogTask ---
+// Drena o anel (50 ms gravando: o SampleRing nao da a volta), atende o pedido do console e, gravando,
+// repoe os setores apagados a frente da escrita, um por volta. Na prioridade mais baixa o apagamento
+// so acontece quando nenhuma outra task do nucleo tem o que fazer.
+static void FlashLogTask(void *p)
+{
+  while(true)
+  {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(Active ? 50 : 500));
+    req_t req = (req_t)Req;
+    if(req != REQ_NONE)
+    {
+      ReqRet = Serve(req);
+      Req    = REQ_NONE;
+      xSemaphoreGive(ReqDone);
+    }//end if
+    Poll();
+    if(Active && Ahead < LOG_AHEAD && Ahead < Sectors())   // Parado, o mais antigo fica para o dump
+      EraseAhead();
+  }//end while
+}//end FlashLogTask
+
+//=======================================================================================================
+//--- Request ---
+// So o console pede, um pedido por vez.
+static esp_err_t Request(req_t req)
+{
+  if(Part == NULL)
+    return ESP_ERR_NOT_FOUND;
+  Req = (uint8_t)req;
+  xTaskNotifyGive(Task);
+  xSemaphoreTake(ReqDone, portMAX_DELAY);
+  return ReqRet;
+}//end Request
+
+//=======================================================================================================
+//--- Serve ---
+static esp_err_t Serve(req_t req)
+{
+  switch(req)
+  {
+    case REQ_START:
+    case REQ_START_RAW:
+      if(!Active)
+      {
+        Poll();                                             // Solta pacotes que ficaram no tap do log anterior
+        sample_ring_reader_init(Ring, &Reader);
+        Fill   = 0;
+        Raw    = req == REQ_START_RAW;
+        Active = true;
+        pktpool_tap(PKT_TAP_FLASHLOG, Raw);
+      }//end if
+      return ESP_OK;
+    case REQ_STOP:
+      if(Active)
+      {
+        pktpool_tap(PKT_TAP_FLASHLOG, false);
+        Poll();
+        if(Fill)
+          Flush();                                          // O resto do setor fica em 0xFF
+        Active = false;
+      }//end if
+      return ESP_OK;
+    case REQ_ERASE:
+      // Um setor por vez: cada apagamento para o cache, entao o radio tem folga entre eles
+      if(Active)
+        return ESP_ERR_INVALID_STATE;
+      for(uint32_t s = 0; s < Sectors(); s++)
+      {
+        esp_err_t ret = esp_partition_erase_range(Part, s * LOG_SECTOR, LOG_SECTOR);
+        if(ret != ESP_OK)
+          return ret;
+        vTaskDelay(1);
+      }//end for
+      Pos   = 0;
+      Ahead = Sectors();
+      Used  = 0;
+      return ESP_OK;
+    default:
+      return ESP_ERR_INVALID_ARG;
+  }//end switch
+}//end Serve
+
+//=======================================================================================================
+//--- Poll ---
+// O tap e drenado sempre, mesmo com o log parado: o radio pode ter publicado enquanto ele desligava.
+static void Poll(void)
+{
+  telemetry_sample_t s;
+  pkt_buf_t         *pkt;
+
+  while((pkt = pktpool_take(PKT_TAP_FLASHLOG)) != NULL)
+  {
+    if(Active && Raw)
+      Append(Line, pktpool_format(pkt, Line, sizeof(Line)));
+    pktpool_put(pkt);
+  }//end while
+  if(!Active || Raw)
+    return;
+  while(sample_ring_pop(Ring, &Reader, &s))
+    Append(Line, uplink_format_csv(&s, Line, sizeof(Line)));
+}//end Poll
+
+//=======================================================================================================
+//--- EraseAhead ---
+// Apaga o setor logo depois da folga; se ele tinha dados, era o mais antigo do log.
+static void EraseAhead(void)
+{
+  uint32_t n   = Sectors();
+  uint32_t sec = (Pos + Ahead) % n;
+
+  if(esp_partition_erase_range(Part, sec * LOG_SECTOR, LOG_SECTOR) != ESP_OK)
+    return;
+  Ahead++;
+  if(Used > n - Ahead)
+    Used = n - Ahead;
+}//end EraseAhead
+
+//=======================================================================================================
+//--- Append ---
+static void Append(const char *line, size_t len)
+{
+  if(len == 0)
+    return;
+  if(Fill + len > LOG_SECTOR)
+    Flush();
+  memcpy(&Sector[Fill], line, len);
+  Fill += len;
+}//end Append
+
+//=======================================================================================================
+//--- Flush ---
+// Grava o setor em RAM no setor de escrita (ja apagado). O seguinte normalmente ja esta apagado pela
+// folga; so se a task nao teve tempo de repor a folga o apagamento acontece aqui.
+static void Flush(void)
+{
+  uint32_t n = Sectors();
+
+  memset(&Sector[Fill], 0xFF, LOG_SECTOR - Fill);
+  if(esp_partition_write(Part, Pos * LOG_SECTOR, Sector, LOG_SECTOR) != ESP_OK)
+    ESP_LOGE(TAG5, "Falha gravando setor %lu", (unsigned long)Pos);
+  Pos = (Pos + 1) % n;
+  if(Ahead > 1)
+    Ahead--;
+  else
+    esp_partition_erase_range(Part, Pos * LOG_SECTOR, LOG_SECTOR);
+  if(Used < n - Ahead)
+    Used++;
+  Fill = 0;
+}//end Flush
+
+//=======================================================================================================
+//--- SectorEmpty ---
+static bool SectorEmpty(uint32_t sec)
+{
+  uint32_t w[4];
+
+  esp_partition_read(Part, sec * LOG_SECTOR, w, sizeof(w));
+  return (w[0] & w[1] & w[2] & w[3]) == 0xFFFFFFFF;
+}//end SectorEmpty
+
+//=======================================================================================================
+//--- Sectors ---
+static uint32_t Sectors(void)
+{
+  return Part ? Part->size / LOG_SECTOR : 0;
+}//end Sectors
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,45 @@
+//=======================================================================================================
+//
+//   Title: Sample log on a flash partition.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Grava as amostras do SampleRing (linhas CSV do uplink) na particao de dados "tlog", como um anel
+//   de setores (no modo bruto, os pacotes do pktpool como linhas $RAW). As linhas vao para um setor
+//   em RAM e o setor inteiro e gravado quando enche, num setor ja apagado: a frente da escrita ficam
+//   alguns setores apagados de folga, repostos fora do caminho da gravacao. O setor apagado logo depois
+//   de um com dados marca o fim do log, entao depois de um reboot o log continua de onde parou e o dump
+//   sabe onde comecar (depois da folga) e onde parar.
+//
+//   Gravar/apagar a flash para o cache nos dois nucleos (um setor apagado leva dezenas de ms). Com a
+//   ISR do DIO0 fora da IRAM o carimbo do RxDone atrasa, mas o FIFO do radio segura o frame; o efeito
+//   aparece no $LAT,rx_parse. Por isso toda gravacao e apagamento fica numa task propria, na menor
+//   prioridade (CONFIG_PRIO_FLASHLOG); start/stop/erase do console sao pedidos a ela. O dump so le,
+//   cede a CPU a cada bloco e manda cada linha inteira pelo uplink como "$LOG,<linha>".
+//=======================================================================================================
+
+#ifndef FLASHLOG_h
+#define FLASHLOG_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "sample_ring.h"
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+esp_err_t flashlog_init(sample_ring_t *ring);                   // Acha a particao e o fim do log, cria a task
+esp_err_t flashlog_start(bool raw);                             // Passa a gravar as amostras (ou pacotes) novas
+void      flashlog_stop(void);                                  // Grava o setor parcial e para
+bool      flashlog_active(void);
+bool      flashlog_raw(void);                                   // Modo do ultimo start
+esp_err_t flashlog_dump(void);                                  // Linhas $LOG pelo uplink, do mais antigo ao mais novo
+esp_err_t flashlog_erase(void);                                 // Apaga a particao inteira (log parado)
+void      flashlog_status(uint32_t *used, uint32_t *size, uint32_t *dropped);
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,93 @@
+//=======================================================================================================
+//
+//   Title: Ground-station geometry (range/bearing/elevation).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <math.h>
+#include "geo.h"
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define EARTH_RADIUS_M  6371008.8f
+#define DEG2RAD         0.017453292519943295f
+#define RAD2DEG         57.29577951308232f
+#define E7_TO_M         (EARTH_RADIUS_M * DEG2RAD * 1e-7f)   // ~0.0111 m por unidade de 1e-7 grau
+#define E7_FULL_TURN    3600000000LL
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- geo_set_station ---
+void geo_set_station(geo_station_t *st, int32_t lat_e7, int32_t lon_e7, float alt_m)
+{
+  st->lat_e7 = lat_e7;
+  st->lon_e7 = lon_e7;
+  st->alt_m  = alt_m;
+  st->mLat   = E7_TO_M;
+  st->mLon   = E7_TO_M * cosf((float)lat_e7 * 1e-7f * DEG2RAD);
+}//end geo_set_station
+
+//=======================================================================================================
+//--- geo_update ---
+void geo_update(const geo_station_t *st, telemetry_sample_t *s)
+{
+  if(!(s->flags & TELEM_FLAG_FIX))
+  {
+    s->flags &= ~TELEM_FLAG_GEO;
+    return;
+  }//end if
+
+  int64_t dLon = (int64_t)s->lon_e7 - st->lon_e7;
+  if(dLon >  E7_FULL_TURN / 2) dLon -= E7_FULL_TURN;          // Cruzamento do antimeridiano
+  if(dLon < -E7_FULL_TURN / 2) dLon += E7_FULL_TURN;
+
+  float east  = (float)dLon * st->mLon;
+  float north = (float)((int64_t)s->lat_e7 - st->lat_e7) * st->mLat;
+  float range = sqrtf(east * east + north * north);
+
+  float brg = geo_atan2(east, north);
+  s->range_m       = range;
+  s->bearing_deg   = brg < 0.0f ? brg + 360.0f : brg;
+  s->elevation_deg = geo_atan2(s->altitude - st->alt_m, range);
+  s->flags |= TELEM_FLAG_GEO;
+}//end geo_update
+
+//=======================================================================================================
+//--- geo_atan2 ---
+// Caminho rapido: reduz para |z| <= 1 e aplica um polinomio minimax de grau 11 (erro ~1e-5 rad).
+// Evita a chamada a libm, que em float no Xtensa custa varias vezes mais.
+float geo_atan2(float y, float x)
+{
+#ifdef CONFIG_GEO_FAST_TRIG
+  float ax = fabsf(x);
+  float ay = fabsf(y);
+
+  if(ax == 0.0f && ay == 0.0f)
+    return 0.0f;
+
+  bool  swap = ay > ax;
+  float z  = swap ? ax / ay : ay / ax;
+  float z2 = z * z;
+  float a  = z * (0.99997726f + z2 * (-0.33262347f + z2 * (0.19354346f +
+                 z2 * (-0.11643287f + z2 * (0.05265332f + z2 * -0.01172120f)))));
+
+  if(swap) a = 1.57079633f - a;
+  if(x < 0.0f) a = 3.14159265f - a;
+  if(y < 0.0f) a = -a;
+  return a * RAD2DEG;
+#else
+  return atan2f(y, x) * RAD2DEG;
+#endif
+}//end geo_atan2
+
+//=======================================================================================================
+//--- End of Program ---
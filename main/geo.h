@@ -0,0 +1,41 @@
+//=======================================================================================================
+//
+//   Title: Ground-station geometry (range/bearing/elevation).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Aproximacao equiretangular em torno da estacao: os fatores metro/unidade sao calculados uma vez
+//   quando a estacao muda, e cada amostra custa apenas algumas multiplicacoes, um sqrtf e dois atan2.
+//   Erro < 0.1% ate algumas dezenas de km, suficiente para o alcance do enlace LoRa.
+//   Com CONFIG_GEO_FAST_TRIG o atan2f da libm e trocado por um polinomio (erro < 0.001 grau).
+//=======================================================================================================
+
+#ifndef GEO_h
+#define GEO_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include "telemetry.h"
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    int32_t lat_e7;                           // Posicao da estacao em 1e-7 graus
+    int32_t lon_e7;
+    float   alt_m;                            // Altitude da antena (mesma referencia da altitude do frame)
+    float   mLat;                             // Metros por 1e-7 grau de latitude
+    float   mLon;                             // Metros por 1e-7 grau de longitude (escalado por cos(lat))
+}geo_station_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void  geo_set_station(geo_station_t *st, int32_t lat_e7, int32_t lon_e7, float alt_m);  // Define a estacao e recalcula os fatores
+void  geo_update(const geo_station_t *st, telemetry_sample_t *s);                       // Preenche range/bearing/elevation da amostra
+float geo_atan2(float y, float x);                                                      // atan2 em graus (rapido ou libm)
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,285 @@
+//=======================================================================================================
+//
+//   Title: Receiver instrumentation (tasks, stacks, pipeline latency).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include "instr.h"
+#include "nodes.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "lora.h"
+#include "integrity.h"
+#include "power.h"
+#include "transport.h"
+#include "netout.h"
+#include "pktpool.h"
+#include "radiosup.h"
+#include "display.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define INSTR_MAX_TASKS 20
+static const char *TAG4 = "INSTR";
+
+static const char *LatName[INSTR_LAT_COUNT] = {"rx_parse","parse_uplink","parse_lcd","cmd","tx_parse"};
+
+//=======================================================================================================
+//--- Variaveis ---
+static lat_hist_t        LatHist[INSTR_LAT_COUNT];
+static int64_t           BootUs[INSTR_BOOT_COUNT];          // Cada etapa e escrita por uma unica task
+static SemaphoreHandle_t InstrMutex;                        // Protege TaskStat/PrevRun (relatorio x LCD)
+static StaticSemaphore_t InstrMutexBuf;
+#if CONFIG_INSTR_REPORT_MS > 0
+static StackType_t       InstrStack[CONFIG_STACK_INSTR];
+static StaticTask_t      InstrTcb;
+#endif
+static TaskStatus_t      TaskStat[INSTR_MAX_TASKS];
+static TaskHandle_t      PrevHandle[INSTR_MAX_TASKS];
+static uint32_t          PrevRun[INSTR_MAX_TASKS];
+static uint32_t          PrevTotal;
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static void InstrTask(void *p);
+static uint32_t PrevRunOf(TaskHandle_t h);
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- instr_start ---
+void instr_start(void)
+{
+  for(int i = 0; i < INSTR_LAT_COUNT; i++)
+    lat_hist_reset(&LatHist[i]);
+  InstrMutex = xSemaphoreCreateMutexStatic(&InstrMutexBuf);
+
+#if CONFIG_INSTR_REPORT_MS > 0
+  xTaskCreateStaticPinnedToCore(InstrTask,"Instr",sizeof(InstrStack),NULL,CONFIG_PRIO_INSTR,InstrStack,&InstrTcb,CONFIG_APP_CORE);
+#endif
+}//end instr_start
+
+//=======================================================================================================
+//--- instr_latency ---
+void instr_latency(instr_lat_t which, int64_t us)
+{
+  lat_hist_add(&LatHist[which], us);
+}//end instr_latency
+
+//=======================================================================================================
+//--- instr_get_latency ---
+void instr_get_latency(instr_lat_t which, lat_hist_t *out)
+{
+  *out = LatHist[which];
+}//end instr_get_latency
+
+//=======================================================================================================
+//--- instr_latency_name ---
+const char *instr_latency_name(instr_lat_t which)
+{
+  return LatName[which];
+}//end instr_latency_name
+
+//=======================================================================================================
+//--- instr_boot ---
+void instr_boot(instr_boot_t stage)
+{
+  if(BootUs[stage] == 0)
+    BootUs[stage] = esp_timer_get_time();
+}//end instr_boot
+
+//=======================================================================================================
+//--- instr_boot_us ---
+int64_t instr_boot_us(instr_boot_t stage)
+{
+  return BootUs[stage];
+}//end instr_boot_us
+
+//=======================================================================================================
+//--- instr_min_stack ---
+bool instr_min_stack(char *name, size_t len, uint32_t *bytes)
+{
+  bool found = false;
+
+  if(!xSemaphoreTake(InstrMutex, portMAX_DELAY))
+    return false;
+  UBaseType_t n = uxTaskGetSystemState(TaskStat, INSTR_MAX_TASKS, NULL);
+  for(UBaseType_t i = 0; i < n; i++)
+  {
+    if(strncmp(TaskStat[i].pcTaskName, "IDLE", 4) == 0)
+      continue;                                             // IDLE sempre tem folga minima configurada
+    if(!found || TaskStat[i].usStackHighWaterMark < *bytes)
+    {
+      *bytes = TaskStat[i].usStackHighWaterMark;
+      snprintf(name, len, "%s", TaskStat[i].pcTaskName);
+      found = true;
+    }//end if
+  }//end for
+  xSemaphoreGive(InstrMutex);
+  return found;
+}//end instr_min_stack
+
+//=======================================================================================================
+//--- instr_report ---
+void instr_report(void)
+{
+  char     line[128];
+  uint32_t total;
+
+  if(!xSemaphoreTake(InstrMutex, portMAX_DELAY))
+    return;
+
+  UBaseType_t n = uxTaskGetSystemState(TaskStat, INSTR_MAX_TASKS, &total);
+  uint32_t dTotal = total - PrevTotal;
+
+  // Layout de nucleos em vigor, para comparar relatorios de configuracoes diferentes
+  int w = snprintf(line, sizeof(line), "$CFG,%d,%d\n", CONFIG_RADIO_CORE, CONFIG_APP_CORE);
+  fwrite(line, 1, (size_t)w, stdout);
+  w = snprintf(line, sizeof(line), "$BOOT,%lu,%lu,%lu,%lu,%lu\n", (unsigned long)(BootUs[INSTR_BOOT_RADIO] / 1000),
+               (unsigned long)(BootUs[INSTR_BOOT_RX] / 1000), (unsigned long)(BootUs[INSTR_BOOT_LCD] / 1000),
+               (unsigned long)(BootUs[INSTR_BOOT_READY] / 1000), (unsigned long)(BootUs[INSTR_BOOT_PACKET] / 1000));
+  fwrite(line, 1, (size_t)w, stdout);
+
+  for(UBaseType_t i = 0; i < n; i++)
+  {
+    TaskStatus_t *t = &TaskStat[i];
+    uint32_t cpu = dTotal ? (uint32_t)((uint64_t)(t->ulRunTimeCounter - PrevRunOf(t->xHandle)) * 1000 / dTotal) : 0;
+#ifdef CONFIG_FREERTOS_VTASKLIST_INCLUDE_COREID
+    int core = t->xCoreID == tskNO_AFFINITY ? -1 : (int)t->xCoreID;
+#else
+    int core = -1;
+#endif
+    w = snprintf(line, sizeof(line), "$TSK,%s,%d,%u,%lu,%lu\n", t->pcTaskName, core,
+                     (unsigned)t->uxCurrentPriority, (unsigned long)cpu, (unsigned long)t->usStackHighWaterMark);
+    fwrite(line, 1, (size_t)w < sizeof(line) ? (size_t)w : sizeof(line) - 1, stdout);
+  }//end for
+
+  // Guarda os contadores para o proximo intervalo
+  for(UBaseType_t i = 0; i < n; i++)
+  {
+    PrevHandle[i] = TaskStat[i].xHandle;
+    PrevRun[i]    = TaskStat[i].ulRunTimeCounter;
+  }//end for
+  for(UBaseType_t i = n; i < INSTR_MAX_TASKS; i++)
+    PrevHandle[i] = NULL;
+  PrevTotal = total;
+  xSemaphoreGive(InstrMutex);
+
+  for(int i = 0; i < INSTR_LAT_COUNT; i++)
+  {
+    lat_hist_t h = LatHist[i];
+    w = snprintf(line, sizeof(line), "$LAT,%s,%lu,%lu,%lu,%lu,%lu,%lu\n", LatName[i], (unsigned long)h.count,
+                     (unsigned long)(h.count ? h.min_us : 0), (unsigned long)lat_hist_mean(&h),
+                     (unsigned long)lat_hist_percentile(&h, 50), (unsigned long)lat_hist_percentile(&h, 99),
+                     (unsigned long)h.max_us);
+    fwrite(line, 1, (size_t)w < sizeof(line) ? (size_t)w : sizeof(line) - 1, stdout);
+  }//end for
+
+  // Estatisticas de enlace por no (so os que ja transmitiram)
+  int64_t now = esp_timer_get_time();
+  for(uint8_t id = 0; id < NODE_MAX; id++)
+  {
+    const node_state_t *nd = node_get(id);
+    if(nd->rx == 0)
+      continue;
+    w = snprintf(line, sizeof(line), "$NODE,%u,%lu,%lu,%lu,%d,%lu,%lu,%lu,%lu,%lu\n", id, (unsigned long)nd->rx,
+                 (unsigned long)nd->bad, (unsigned long)nd->lost, nd->rssi,
+                 (unsigned long)((now - nd->last_rx_us) / 1000),
+                 (unsigned long)nd->arq.recovered, (unsigned long)nd->arq.given_up,
+                 (unsigned long)nd->fec.recovered, (unsigned long)nd->fec.unrecoverable);
+    fwrite(line, 1, (size_t)w < sizeof(line) ? (size_t)w : sizeof(line) - 1, stdout);
+    if(nd->sync.syncs == 0)
+      continue;
+    w = snprintf(line, sizeof(line), "$SYNC,%u,%lu,%lu,%ld,%ld\n", id, (unsigned long)nd->sync.syncs,
+                 (unsigned long)nd->sync.resets, (long)nd->sync.err_us, (long)nd->sync.skew_ppb);
+    fwrite(line, 1, (size_t)w < sizeof(line) ? (size_t)w : sizeof(line) - 1, stdout);
+  }//end for
+  w = snprintf(line, sizeof(line), "$LINK,%d,%lu\n", lora_crc_errors(), (unsigned long)integ_rejected());
+  fwrite(line, 1, (size_t)w < sizeof(line) ? (size_t)w : sizeof(line) - 1, stdout);
+
+  radiosup_stats_t rs;
+  radiosup_get(&rs);
+  w = snprintf(line, sizeof(line), "$RADIO,%lu,%lu,%s,%lu,%lu\n", (unsigned long)rs.recoveries,
+               (unsigned long)rs.failures, radiosup_reason_name(rs.last_reason), (unsigned long)rs.last_us,
+               (unsigned long)(rs.last_t_us ? (now - rs.last_t_us) / 1000 : 0));
+  fwrite(line, 1, (size_t)w < sizeof(line) ? (size_t)w : sizeof(line) - 1, stdout);
+
+  power_stats_t ps;
+  power_get(&ps, now);
+  w = snprintf(line, sizeof(line), "$PWR,%s,%lu,%lu,%lu,%lu,%lu,%lu,%lu,%lu\n", ps.duty ? "cad" : "rx",
+               (unsigned long)(ps.us[PWR_SLEEP] / 1000), (unsigned long)(ps.us[PWR_CAD] / 1000),
+               (unsigned long)(ps.us[PWR_RX] / 1000), (unsigned long)(ps.us[PWR_TX] / 1000),
+               (unsigned long)ps.cad, (unsigned long)ps.cad_hit, (unsigned long)ps.cad_false,
+               (unsigned long)power_avg_ua(&ps));
+  fwrite(line, 1, (size_t)w < sizeof(line) ? (size_t)w : sizeof(line) - 1, stdout);
+
+  transport_stats_t ts;
+  transport_get(&ts);
+  w = snprintf(line, sizeof(line), "$UPL,%s,%lu,%lu,%lu\n", transport_name(), (unsigned long)ts.bytes,
+               (unsigned long)ts.dropped, (unsigned long)ts.log_dropped);
+  fwrite(line, 1, (size_t)w < sizeof(line) ? (size_t)w : sizeof(line) - 1, stdout);
+
+  w = snprintf(line, sizeof(line), "$DISP,%s,%lu\n", disp_Name(), (unsigned long)disp_BusBytes());
+  fwrite(line, 1, (size_t)w < sizeof(line) ? (size_t)w : sizeof(line) - 1, stdout);
+
+  pkt_stats_t ks;
+  pktpool_get_stats(&ks);
+  w = snprintf(line, sizeof(line), "$PKT,%u,%u,%u,%lu,%lu,%lu,%lu\n", ks.size, ks.free, ks.min_free,
+               (unsigned long)ks.received, (unsigned long)ks.exhausted, (unsigned long)ks.dropped[PKT_TAP_FLASHLOG],
+               (unsigned long)ks.dropped[PKT_TAP_CAPTURE]);
+  fwrite(line, 1, (size_t)w < sizeof(line) ? (size_t)w : sizeof(line) - 1, stdout);
+
+#ifdef CONFIG_NET_UPLINK
+  net_stats_t ns;
+  netout_get(&ns);
+  w = snprintf(line, sizeof(line), "$NET,%u,%lu,%lu,%lu,%lu,%lu\n", ns.clients, (unsigned long)ns.records,
+               (unsigned long)ns.datagrams, (unsigned long)ns.udp_dropped, (unsigned long)ns.accepted,
+               (unsigned long)ns.client_dropped);
+  fwrite(line, 1, (size_t)w < sizeof(line) ? (size_t)w : sizeof(line) - 1, stdout);
+#endif
+
+  w = snprintf(line, sizeof(line), "$MEM,%u,%u,%u\n", (unsigned)heap_caps_get_free_size(MALLOC_CAP_8BIT),
+               (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT),
+               (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+  fwrite(line, 1, (size_t)w < sizeof(line) ? (size_t)w : sizeof(line) - 1, stdout);
+}//end instr_report
+
+//=======================================================================================================
+//--- PrevRunOf ---
+static uint32_t PrevRunOf(TaskHandle_t h)
+{
+  for(int i = 0; i < INSTR_MAX_TASKS && PrevHandle[i]; i++)
+  {
+    if(PrevHandle[i] == h)
+      return PrevRun[i];
+  }//end for
+  return 0;                                                 // Task nova neste intervalo
+}//end PrevRunOf
+
+//=======================================================================================================
+//--- InstrTask ---
+static void InstrTask(void *p)
+{
+  ESP_LOGI(TAG4, "Relatorio a cada %d ms", CONFIG_INSTR_REPORT_MS);
+  TickType_t last = xTaskGetTickCount();
+  while(true)
+  {
+    vTaskDelayUntil(&last, pdMS_TO_TICKS(CONFIG_INSTR_REPORT_MS));
+    instr_report();
+  }//end while
+}//end InstrTask
+
+//=======================================================================================================
+//--- End of Program ---
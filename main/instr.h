@@ -0,0 +1,74 @@
+//=======================================================================================================
+//
+//   Title: Receiver instrumentation (tasks, stacks, pipeline latency).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Relatorio periodico na serial, uma linha por registro, prefixo '$' para nao confundir com as
+//   linhas CSV do uplink:
+//     $CFG,nucleo_radio,nucleo_app
+//     $BOOT,radio_ms,rx_ms,lcd_ms,pronto_ms,primeiro_pacote_ms
+//     $TSK,nome,nucleo,prioridade,cpu_por_mil,pilha_livre_bytes
+//     $LAT,trecho,n,min_us,media_us,p50_us,p99_us,max_us
+//     $NODE,no,rx,invalidos,perdidos,rssi_dbm,idade_ms,arq_recuperados,arq_abandonados,fec_refeitos,fec_irrecuperaveis
+//     $SYNC,no,sincronismos,reinicios,erro_us,deriva_ppb
+//     $LINK,erros_crc,rejeitados_integridade
+//     $RADIO,reinicios,falhas,motivo_ultimo,duracao_ultimo_us,idade_ultimo_ms
+//     $PWR,modo,sono_ms,cad_ms,rx_ms,tx_ms,cads,cads_positivos,cads_falsos,corrente_media_ua
+//     $UPL,porta,bytes,bytes_descartados,logs_descartados
+//     $DISP,driver,bytes_barramento
+//     $PKT,buffers,livres,minimo_livres,pacotes,pool_esgotado,descartados_log,descartados_captura
+//     $NET,clientes,registros,datagramas,udp_descartados,conexoes,registros_pulados_por_clientes_lentos
+//     $MEM,heap_livre,heap_minimo,maior_bloco
+//   Os percentis sao o limite superior do bucket log2 (ver lat_hist.h). A corrente e estimada (ver
+//   power.h); comparada com os perdidos do $NODE ela da a troca consumo x perda de cada modo.
+//   O $BOOT conta do inicio do esp_timer (fim do bootloader); 0 = etapa ainda nao alcancada.
+//   Depois do boot o $MEM deve ficar parado: tasks, filas e aneis sao estaticos (menu "Memory plan").
+//=======================================================================================================
+
+#ifndef INSTR_h
+#define INSTR_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "lat_hist.h"
+
+//=======================================================================================================
+//--- Types ---
+
+typedef enum{
+    INSTR_LAT_RX_PARSE = 0,                   // DIO0 RxDone -> amostra decodificada
+    INSTR_LAT_PARSE_UPLINK,                   // Amostra decodificada -> registro escrito no uplink
+    INSTR_LAT_PARSE_LCD,                      // Amostra decodificada -> primeira vez desenhada no LCD
+    INSTR_LAT_CMD,                            // Linha recebida no console -> resposta escrita
+    INSTR_LAT_TX_PARSE,                       // Medida no transmissor -> amostra decodificada (com timesync)
+    INSTR_LAT_COUNT
+}instr_lat_t;
+
+typedef enum{
+    INSTR_BOOT_RADIO = 0,                     // SX1276 configurado (setupLoRa)
+    INSTR_BOOT_RX,                            // ReceiveLoraData no laco de recepcao
+    INSTR_BOOT_LCD,                           // Splash desenhado
+    INSTR_BOOT_READY,                         // app_main terminou (botoes, uplink, console)
+    INSTR_BOOT_PACKET,                        // Primeiro frame valido
+    INSTR_BOOT_COUNT
+}instr_boot_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void        instr_start(void);                                         // Cria os histogramas e a task de relatorio
+void        instr_latency(instr_lat_t which, int64_t us);              // Registra um trecho (um escritor por trecho)
+void        instr_get_latency(instr_lat_t which, lat_hist_t *out);     // Copia do histograma
+const char *instr_latency_name(instr_lat_t which);                     // Nome curto do trecho
+bool        instr_min_stack(char *name, size_t len, uint32_t *bytes);  // Task com menor folga de pilha
+void        instr_boot(instr_boot_t stage);                            // Carimba a etapa do boot (so a primeira vez)
+int64_t     instr_boot_us(instr_boot_t stage);                         // 0 = ainda nao
+void        instr_report(void);                                        // Imprime o relatorio imediatamente
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
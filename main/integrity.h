@@ -0,0 +1,56 @@
+//=======================================================================================================
+//
+//   Title: End-to-end frame integrity (CRC-16 / SipHash MAC).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Frames com cabecalho de enlace levam um trailer sobre cabecalho + payload, conferido antes de
+//   qualquer decodificacao:
+//     CONFIG_LINK_INTEGRITY_CRC16:   2 bytes, CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), big-endian
+//     CONFIG_LINK_INTEGRITY_SIPHASH: 4 bytes, SipHash-2-4 truncado com chave de 128 bits da NVS; sem
+//                                    chave, integ_check rejeita tudo e integ_append recusa (0)
+//   O CRC do radio so protege contra ruido no ar; o trailer tambem descarta frames de outras redes
+//   no mesmo sync word e, no modo MAC, frames forjados. Frames legados (sem cabecalho) nao tem
+//   trailer e so passam com CONFIG_LINK_LEGACY_ASCII.
+//=======================================================================================================
+
+#ifndef INTEGRITY_h
+#define INTEGRITY_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+#define INTEG_KEY_LEN 16
+
+#if defined(CONFIG_LINK_INTEGRITY_SIPHASH)
+#define INTEG_TRAILER 4
+#elif defined(CONFIG_LINK_INTEGRITY_NONE)
+#define INTEG_TRAILER 0
+#else
+#define INTEG_TRAILER 2                       // CRC-16 (default)
+#endif
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void     integ_set_key(const uint8_t key[INTEG_KEY_LEN]);                    // Chave do modo MAC
+bool     integ_has_key(void);
+size_t   integ_check(const uint8_t *buf, size_t len);                        // Tamanho sem trailer; 0 = rejeitado
+size_t   integ_append(uint8_t *buf, size_t len, size_t size);                // Acrescenta o trailer; 0 = sem espaco/chave
+uint32_t integ_rejected(void);                                               // Frames descartados por integ_check
+
+uint16_t integ_crc16(const uint8_t *p, size_t len);                          // CRC-16/CCITT-FALSE por tabela
+uint64_t integ_siphash(const uint8_t key[INTEG_KEY_LEN], const uint8_t *p, size_t len);  // SipHash-2-4
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
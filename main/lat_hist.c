@@ -0,0 +1,72 @@
+//=======================================================================================================
+//
+//   Title: Latency histogram (log2 buckets, microseconds).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include "lat_hist.h"
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- lat_hist_reset ---
+void lat_hist_reset(lat_hist_t *h)
+{
+  memset(h, 0, sizeof(*h));
+  h->min_us = UINT32_MAX;
+}//end lat_hist_reset
+
+//=======================================================================================================
+//--- lat_hist_add ---
+void lat_hist_add(lat_hist_t *h, int64_t us)
+{
+  uint32_t v = us < 0 ? 0 : (us > UINT32_MAX ? UINT32_MAX : (uint32_t)us);
+  uint32_t b = v ? 32 - (uint32_t)__builtin_clz(v) : 0;       // Numero de bits significativos
+
+  if(b >= LAT_HIST_BUCKETS)
+    b = LAT_HIST_BUCKETS - 1;
+  h->bucket[b]++;
+  h->count++;
+  h->sum_us += v;
+  if(v < h->min_us) h->min_us = v;
+  if(v > h->max_us) h->max_us = v;
+}//end lat_hist_add
+
+//=======================================================================================================
+//--- lat_hist_percentile ---
+uint32_t lat_hist_percentile(const lat_hist_t *h, uint32_t pct)
+{
+  if(h->count == 0)
+    return 0;
+
+  uint64_t target = ((uint64_t)h->count * pct + 99) / 100;
+  uint64_t acc = 0;
+  for(uint32_t b = 0; b < LAT_HIST_BUCKETS; b++)
+  {
+    acc += h->bucket[b];
+    if(acc >= target)
+    {
+      if(b == LAT_HIST_BUCKETS - 1)
+        return h->max_us;                                   // O ultimo bucket nao tem limite superior
+      uint32_t upper = b ? (1u << b) - 1 : 0;
+      return upper < h->max_us ? upper : h->max_us;
+    }//end if
+  }//end for
+  return h->max_us;
+}//end lat_hist_percentile
+
+//=======================================================================================================
+//--- lat_hist_mean ---
+uint32_t lat_hist_mean(const lat_hist_t *h)
+{
+  return h->count ? (uint32_t)(h->sum_us / h->count) : 0;
+}//end lat_hist_mean
+
+//=======================================================================================================
+//--- End of Program ---
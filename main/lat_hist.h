@@ -0,0 +1,45 @@
+//=======================================================================================================
+//
+//   Title: Latency histogram (log2 buckets, microseconds).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Cada histograma tem um unico escritor (a task que fecha o trecho medido); leitores fazem uma
+//   copia e aceitam uma amostra em transito. Bucket i cobre [2^(i-1), 2^i) us; o ultimo acumula tudo
+//   acima de ~1 s.
+//=======================================================================================================
+
+#ifndef LAT_HIST_h
+#define LAT_HIST_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+#define LAT_HIST_BUCKETS 21
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    uint32_t bucket[LAT_HIST_BUCKETS];
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+}lat_hist_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void     lat_hist_reset(lat_hist_t *h);                       // Zera o histograma
+void     lat_hist_add(lat_hist_t *h, int64_t us);             // Registra uma medida (negativas contam como 0)
+uint32_t lat_hist_percentile(const lat_hist_t *h, uint32_t pct); // Limite superior do bucket do percentil
+uint32_t lat_hist_mean(const lat_hist_t *h);                  // Media em us
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -11,7 +11,7 @@
 
 //=======================================================================================================
 //
-//   Title: Display LCD 16x2 control, mode 4 bits.
+//   Title: Display LCD 16x2/20x4 control, mode 4 bits.
 //   Author: Joao Ricardo Chaves.
 //   Date: August,2024.
 //
@@ -20,17 +20,74 @@
 //=======================================================================================================
 //--- Bibliotecas ---
 #include "lcd_jr.h"
+#include "display.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
 
 //=======================================================================================================
 //--- Const and Macro ---
-#define LCD_ADDR 0x27
+#define LCD_ADDR CONFIG_DISPLAY_I2C_ADDR         // PCF8574 (0x27) ou PCF8574A (0x3F)
+#define LCD_LINK I2C_LINK_RECOMMENDED_SIZE(1)    // Um start..stop por comando; buffer na pilha, sem heap
 static const char *TAG1 = "I2C";
 
+// Esperas minimas do HD44780 (datasheet, fig. 24 e tabela 6). Cada nibble ja leva ~1 ms de I2C mais os
+// 500 us do pulso de enable, entao os comandos de 37 us nao precisam de espera propria.
+#define LCD_POWERUP_US  40000                    // Vcc acima de 2,7 V ate o primeiro comando
+#define LCD_INIT1_US    4100                     // Depois do primeiro 0x30
+#define LCD_INIT2_US    100                      // Depois do segundo 0x30
+#define LCD_CLEAR_US    1520                     // Clear display / return home
+#define LCD_GLYPHS      8
+#define LCD_CGRAM       0x40
+#define LCD_STREAM      512                      // Bytes do PCF8574 por transferencia (tela 20x4 inteira)
+#define LCD_EN          0x04
+
+// Linhas 3 e 4 do 20x4 continuam as linhas 1 e 2 na DDRAM
+static const uint8_t RowAddr[4] = {0x00, 0x40, 0x14, 0x54};
+
+// 5x8, bit 4 = coluna da esquerda
+static const uint8_t Glyph[LCD_GLYPHS][8] = {
+  {0x10,0x10,0x10,0x10,0x10,0x10,0x10,0x10},     // Barra horizontal, 1 coluna
+  {0x18,0x18,0x18,0x18,0x18,0x18,0x18,0x18},
+  {0x1C,0x1C,0x1C,0x1C,0x1C,0x1C,0x1C,0x1C},
+  {0x1E,0x1E,0x1E,0x1E,0x1E,0x1E,0x1E,0x1E},     // 4 colunas (5 = DISP_FULL)
+  {0x00,0x00,0x00,0x00,0x00,0x00,0x1F,0x1F},     // Coluna de 2 linhas
+  {0x00,0x00,0x00,0x00,0x1F,0x1F,0x1F,0x1F},
+  {0x00,0x00,0x1F,0x1F,0x1F,0x1F,0x1F,0x1F},     // 6 linhas
+  {0x04,0x0E,0x0E,0x0E,0x1F,0x00,0x04,0x00}      // Sino
+};
+
+//=======================================================================================================
+//--- Variaveis ---
+// So a task do menu usa o LCD. Cada nibble vira 3 bytes do PCF8574 (dado, EN alto, EN baixo) numa unica
+// transferencia I2C por flush: o byte seguinte leva ~150 us a 60 kHz, bem mais que o pulso de EN e os
+// 37 us de um comando.
+static DMA_ATTR uint8_t Stream[LCD_STREAM];
+static uint16_t StreamLen;
+static uint32_t StreamBytes;                     // Enviados desde o ultimo Hd44780Flush
+
 //=======================================================================================================
 //--- Functions prototypes ---
 void send_nibble(uint8_t nib, uint8_t rsel);          // Envia cada nibble separadamente
 void send_PulseEnable(uint8_t data);                  // Envia pulso de enable para o display
-esp_err_t I2C0_Init(void);                                 // Inicializa o modo I2C
+static void LcdCmd(uint8_t cmd);                      // Comando sem invalidar o quadro
+static void LcdChar(uint8_t chr);                     // Caractere sem invalidar o quadro
+static void LoadGlyphs(void);                         // CGRAM
+static void StreamByte(uint8_t byte, uint8_t rsel);   // Dois nibbles no Stream
+static void StreamSend(void);                         // Uma transferencia I2C
+static esp_err_t Hd44780Init(void);
+static void Hd44780Blit(uint8_t row, uint8_t col, const uint8_t *cells, uint8_t n);
+static uint32_t Hd44780Flush(void);
+
+//=======================================================================================================
+//--- Driver ---
+const display_ops_t DisplayHd44780 = {
+  .name  = "hd44780",
+  .cols  = LCD_COLS,
+  .rows  = LCD_ROWS,
+  .init  = Hd44780Init,
+  .blit  = Hd44780Blit,
+  .flush = Hd44780Flush,
+};
 
 //=======================================================================================================
 //--- Functions ---
@@ -46,7 +103,7 @@ esp_err_t I2C0_Init(void)
     .scl_io_num = I2C0_SCL,
     .sda_pullup_en = GPIO_PULLUP_ENABLE,
     .scl_pullup_en = GPIO_PULLUP_ENABLE,
-    .master.clk_speed = 60000
+    .master.clk_speed = I2C0_HZ
   };
   i2c_param_config(I2C_NUM_0,&i2cConfig);
   i2c_driver_install(I2C_NUM_0,I2C_MODE_MASTER,0,0,0); 
@@ -62,45 +119,44 @@ esp_err_t I2C0_Init(void)
 void disp_Init()
 {
   ESP_ERROR_CHECK(I2C0_Init());   // Inicializa o modo I2C
-  __Delay(100);                   // Delay de 50ms para garantir a inicialização do LCD
+  int64_t up = LCD_POWERUP_US - esp_timer_get_time();
+  if(up > 0)                      // O boot do ESP32 quase sempre ja passou dos 40 ms
+    __DelayUs((uint32_t)up);
 
   send_nibble(0x30, 0);           // Envia os 4 primeiros nibbles 0011 0000
-  __Delay(10);                    // Delay de 5 milisegundos
+  __DelayUs(LCD_INIT1_US);
   send_nibble(0x30, 0);           // Envia novamente os 4 primeiros nibbles
-  __DelayUs(200);                 // Delay de 150us
+  __DelayUs(LCD_INIT2_US);
   send_nibble(0x30, 0);           // Envia novamente os 4 primeiros nibbles
-  __Delay(10);
   send_nibble(0x20, 0);           // Envia o nibble 0010 para o modo 4-bits
-  __DelayUs(80);
-
-  disp_WriteCmd(0x28);            // 5x8 pontos por caractere, duas linhas
-  __DelayUs(80);
-  disp_WriteCmd(LCD_BACKLIGHT);  
-  __Delay(2);          
-  disp_WriteCmd(0x01);
-  __Delay(2);
-  disp_WriteCmd(0x06);
-  __Delay(1);
-  disp_WriteCmd(0x0C);
-  __Delay(1);
+
+  LcdCmd(0x28);                   // 5x8 pontos por caractere, duas linhas (o 20x4 tambem)
+  LcdCmd(LCD_BACKLIGHT);  
+  LcdCmd(0x01);
+  __DelayUs(LCD_CLEAR_US);
+  LcdCmd(0x06);
+  LcdCmd(0x0C);
+  LoadGlyphs();
+  disp_Invalidate();
 }//end disp_Init
    
 //=======================================================================================================
 //--- disp_Clear ---
 void disp_Clear()
 {
-  disp_WriteCmd(0x02);          // Retorna o cursor
-  __Delay(2);
-  disp_WriteCmd(0x01);          // Limpa o display
-  __Delay(2);
+  LcdCmd(0x02);                 // Retorna o cursor
+  __DelayUs(LCD_CLEAR_US);      // __Delay(2) com tick de 10 ms nao esperava nada
+  LcdCmd(0x01);                 // Limpa o display
+  __DelayUs(LCD_CLEAR_US);
+  disp_Invalidate();
 }//end disp_Clear 
 
 //=======================================================================================================
 //--- disp_Putc ---
 void disp_Putc(unsigned char chr)
 {
-  send_nibble(chr & 0xF0,1);           // Envia o char completo, enviando primeiro os 4 bits mais significativos
-  send_nibble((chr << 4) & 0xF0,1);    // Como e um envio de dados o Register select eh 1, caso fosse um comando
+  disp_Invalidate();
+  LcdChar(chr);
 }// end disp_Putc                        
 
 //=======================================================================================================
@@ -118,24 +174,111 @@ void disp_Puts(char *buffer)
 //=======================================================================================================
 //--- disp_WriteCmd ---
 void disp_WriteCmd(unsigned char cmd)
+{
+  disp_Invalidate();
+  LcdCmd(cmd);
+}//end disp_WriteCmd 
+
+//=======================================================================================================
+//--- LcdCmd ---
+static void LcdCmd(uint8_t cmd)
 {
   send_nibble(cmd & 0xF0,0);        // envia os 4 bits mais significativos limpando os menos 
   send_nibble((cmd<<4) & 0xF0,0);   // envia os 4 bits menos significativos realizando um deslocamento
                                     // e limpando os bits menos.
-}//end disp_WriteCmd 
+}//end LcdCmd
+
+//=======================================================================================================
+//--- LcdChar ---
+static void LcdChar(uint8_t chr)
+{
+  send_nibble(chr & 0xF0,1);           // Envia o char completo, enviando primeiro os 4 bits mais significativos
+  send_nibble((chr << 4) & 0xF0,1);    // Como e um envio de dados o Register select eh 1, caso fosse um comando
+}//end LcdChar
+
+//=======================================================================================================
+//--- LoadGlyphs ---
+// Uma vez por disp_Init: 8 x 8 bytes na CGRAM numa transferencia. Depois o endereco aponta para a CGRAM,
+// mas todo blit comeca com um endereco da DDRAM.
+static void LoadGlyphs(void)
+{
+  StreamByte(LCD_CGRAM, 0);
+  for(int g = 0; g < LCD_GLYPHS; g++)
+    for(int r = 0; r < 8; r++)
+      StreamByte(Glyph[g][r], 1);
+  StreamSend();
+  StreamBytes = 0;
+}//end LoadGlyphs
+
+//=======================================================================================================
+//--- StreamByte ---
+static void StreamByte(uint8_t byte, uint8_t rsel)
+{
+  if(StreamLen + 6 > LCD_STREAM)
+    StreamSend();
+  for(int i = 0; i < 2; i++, byte <<= 4)
+  {
+    uint8_t data = (byte & 0xF0) | LCD_BACKLIGHT | rsel;
+    Stream[StreamLen++] = data;
+    Stream[StreamLen++] = data | LCD_EN;
+    Stream[StreamLen++] = data;
+  }//end for
+}//end StreamByte
+
+//=======================================================================================================
+//--- StreamSend ---
+static void StreamSend(void)
+{
+  if(StreamLen == 0)
+    return;
+  ESP_ERROR_CHECK(i2c_master_write_to_device(I2C_NUM_0, LCD_ADDR, Stream, StreamLen, 1000 / portTICK_PERIOD_MS));
+  StreamBytes += StreamLen + 1;           // + endereco
+  StreamLen = 0;
+}//end StreamSend
+
+//=======================================================================================================
+//--- Hd44780Init ---
+static esp_err_t Hd44780Init(void)
+{
+  disp_Init();
+  return ESP_OK;
+}//end Hd44780Init
+
+//=======================================================================================================
+//--- Hd44780Blit ---
+// Entry mode 0x06: a DDRAM avanca sozinha depois de cada caractere, um endereco basta por sequencia.
+static void Hd44780Blit(uint8_t row, uint8_t col, const uint8_t *cells, uint8_t n)
+{
+  if(row >= LCD_ROWS)
+    return;
+  StreamByte(LCD_1POS | (RowAddr[row] + col), 0);
+  while(n--)
+    StreamByte(*cells++, 1);
+}//end Hd44780Blit
+
+//=======================================================================================================
+//--- Hd44780Flush ---
+static uint32_t Hd44780Flush(void)
+{
+  StreamSend();
+  uint32_t sent = StreamBytes;
+  StreamBytes = 0;
+  return sent;
+}//end Hd44780Flush
 
 //=======================================================================================================
 //--- send_nibble ---
 void send_nibble(uint8_t nib, uint8_t rsel)
 {
     uint8_t data = (nib & 0xF0) | LCD_BACKLIGHT | rsel;
+    uint8_t link[LCD_LINK];
 
-    i2c_cmd_handle_t cmd_handle = i2c_cmd_link_create();
+    i2c_cmd_handle_t cmd_handle = i2c_cmd_link_create_static(link, sizeof(link));
     ESP_ERROR_CHECK(i2c_master_start(cmd_handle));
     ESP_ERROR_CHECK(i2c_master_write_byte(cmd_handle, (LCD_ADDR << 1) | I2C_MASTER_WRITE, true));
     ESP_ERROR_CHECK(i2c_master_write_byte(cmd_handle, data, true));
     ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_NUM_0, cmd_handle, 1000 / portTICK_PERIOD_MS));
-    i2c_cmd_link_delete(cmd_handle);
+    i2c_cmd_link_delete_static(cmd_handle);
 
     send_PulseEnable(data);  // Envio do pulso de enable para o display
 }//end send_nibble
@@ -144,22 +287,24 @@ void send_nibble(uint8_t nib, uint8_t rsel)
 //--- send_PulseEnable ---
 void send_PulseEnable(uint8_t data)
 {
-    i2c_cmd_handle_t cmd_handle = i2c_cmd_link_create();
+    uint8_t link[LCD_LINK];
+
+    i2c_cmd_handle_t cmd_handle = i2c_cmd_link_create_static(link, sizeof(link));
     ESP_ERROR_CHECK(i2c_master_start(cmd_handle));
     ESP_ERROR_CHECK(i2c_master_write_byte(cmd_handle, (LCD_ADDR << 1) | I2C_MASTER_WRITE, true));
     ESP_ERROR_CHECK(i2c_master_write_byte(cmd_handle, data | 0x04, true));  // EN = 1
     ESP_ERROR_CHECK(i2c_master_stop(cmd_handle));
     ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_NUM_0, cmd_handle, 1000 / portTICK_PERIOD_MS));
-    i2c_cmd_link_delete(cmd_handle);
+    i2c_cmd_link_delete_static(cmd_handle);
     __DelayUs(1);  // EN HIGH
 
-    cmd_handle = i2c_cmd_link_create();
+    cmd_handle = i2c_cmd_link_create_static(link, sizeof(link));
     ESP_ERROR_CHECK(i2c_master_start(cmd_handle));
     ESP_ERROR_CHECK(i2c_master_write_byte(cmd_handle, (LCD_ADDR << 1) | I2C_MASTER_WRITE, true));
     ESP_ERROR_CHECK(i2c_master_write_byte(cmd_handle, data & ~0x04, true));  // EN = 0
     ESP_ERROR_CHECK(i2c_master_stop(cmd_handle));
     ESP_ERROR_CHECK(i2c_master_cmd_begin(I2C_NUM_0, cmd_handle, 1000 / portTICK_PERIOD_MS));
-    i2c_cmd_link_delete(cmd_handle);
+    i2c_cmd_link_delete_static(cmd_handle);
     __DelayUs(500);  // EN LOW
 }// end send_PulseEnable
 
@@ -11,7 +11,7 @@
 
 //=======================================================================================================
 //
-//   Title: Display LCD 16x2 control, mode 4 bits.
+//   Title: Display LCD 16x2/20x4 control, mode 4 bits.
 //   Author: Joao Ricardo Chaves.
 //   Date: August,2024.
 //  
@@ -25,6 +25,8 @@
 //=======================================================================================================
 //--- Libraries ---
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "driver/gpio.h"
@@ -39,6 +41,12 @@
 #define I2C0_SDA GPIO_NUM_4
 #define I2C0_SCL GPIO_NUM_15
 
+#if defined CONFIG_DISPLAY_SSD1306
+#define I2C0_HZ  400000                       // Fast mode do SSD1306
+#else
+#define I2C0_HZ  60000                        // PCF8574 (ate 100 kHz)
+#endif
+
 //=======================================================================================================
 //--- Macros and Constants ---
 
@@ -51,8 +59,18 @@
 #define LCD_HOME        0x02
 #define LCD_1POS        0x80
 #define LCD_2POS        0xC0
+#define LCD_3POS        0x94                  // 20x4
+#define LCD_4POS        0xD4
 #define LCD_NOCURSOR    0x0C
 
+#if defined CONFIG_DISPLAY_HD44780_20X4
+#define LCD_COLS        20
+#define LCD_ROWS        4
+#else
+#define LCD_COLS        16
+#define LCD_ROWS        2
+#endif
+
 //=======================================================================================================
 //--- Functions Prototypes ---
 
@@ -63,6 +81,10 @@ void disp_Puts(char *buffer);                         // Escreve uma string no L
 void disp_WriteCmd(unsigned char cmd);                // Envia um comando para o LCD
 void send_number(long int num);                       // Exibe um num inteiro de ate 5 digitos
 void disp_Putrs(const char *buffer);                  // Escreve uma string no LCD
+esp_err_t I2C0_Init(void);                            // Inicializa o modo I2C (tambem usado pelo SSD1306)
+
+// As telas usam o quadro do display.h (DisplayHd44780); as funcoes diretas acima forcam um redesenho
+// completo no proximo disp_Flush.
 
 #endif
 //=======================================================================================================
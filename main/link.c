@@ -0,0 +1,59 @@
+//=======================================================================================================
+//
+//   Title: LoRa link-layer header.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include "link.h"
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- link_decode ---
+bool link_decode(const uint8_t *buf, size_t len, link_frame_t *out)
+{
+  if(len == 0)
+    return false;
+
+  if((buf[0] & LINK_MAGIC_MASK) != LINK_MAGIC)
+  {
+    // Frame legado: tudo e payload ASCII do no 0
+    out->type    = LINK_T_ASCII;
+    out->node    = 0;
+    out->flags   = 0;
+    out->seq     = 0;
+    out->has_hdr = false;
+    out->payload = buf;
+    out->plen    = len;
+    return true;
+  }//end if
+
+  if(len < LINK_HDR_LEN)
+    return false;
+  out->type    = buf[0] & ~LINK_MAGIC_MASK;
+  out->node    = buf[1] >> 4;
+  out->flags   = buf[1] & 0x0F;
+  out->seq     = buf[2];
+  out->has_hdr = true;
+  out->payload = buf + LINK_HDR_LEN;
+  out->plen    = len - LINK_HDR_LEN;
+  return true;
+}//end link_decode
+
+//=======================================================================================================
+//--- link_encode_hdr ---
+size_t link_encode_hdr(uint8_t *buf, uint8_t type, uint8_t node, uint8_t flags, uint8_t seq)
+{
+  buf[0] = LINK_MAGIC | (type & 0x0F);
+  buf[1] = (uint8_t)((node << 4) | (flags & 0x0F));
+  buf[2] = seq;
+  return LINK_HDR_LEN;
+}//end link_encode_hdr
+
+//=======================================================================================================
+//--- End of Program ---
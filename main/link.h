@@ -0,0 +1,68 @@
+//=======================================================================================================
+//
+//   Title: LoRa link-layer header.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Frames novos comecam com um cabecalho binario de 3 bytes:
+//     [0] 0xA0 | tipo        [1] no << 4 | flags        [2] sequencia (mod 256)
+//   O frame ASCII antigo (sem cabecalho) comeca com digito/sinal, nunca com byte >= 0x80, e continua
+//   aceito como no 0 sem sequencia.
+//=======================================================================================================
+
+#ifndef LINK_h
+#define LINK_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+#define LINK_MAGIC      0xA0
+#define LINK_MAGIC_MASK 0xF0
+#define LINK_HDR_LEN    3
+#define LINK_NODE_MAX   16                    // 4 bits de endereco
+
+#define LINK_T_ASCII    0x0                   // Payload = frame ASCII de telemetria
+#define LINK_T_BEACON   0x1                   // Receptor -> transmissores: atribuicao de slots (tdma.h)
+#define LINK_T_ACK      0x2                   // Receptor -> transmissor: ACK seletivo (arq.h)
+#define LINK_T_PARITY   0x3                   // Paridade XOR de um grupo de frames (fec.h)
+#define LINK_T_KEY      0x4                   // Telemetria binaria absoluta (delta.h)
+#define LINK_T_DELTA    0x5                   // Telemetria binaria: deltas contra o ultimo keyframe
+#define LINK_T_TIME     0x6                   // Transmissor -> receptor: relogio no inicio do frame (timesync.h)
+
+#define LINK_F_REL      0x1                   // Frame do canal confiavel: seq propria, exige ACK
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    uint8_t        type;                      // LINK_T_*
+    uint8_t        node;
+    uint8_t        flags;
+    uint8_t        seq;
+    bool           has_hdr;                   // false = frame legado (no 0, sem sequencia)
+    const uint8_t *payload;
+    size_t         plen;
+}link_frame_t;
+
+typedef struct{                               // Recepcao de um frame; o ARQ guarda junto com o payload
+    int64_t t_rx_us;                          // esp_timer no RxDone
+    int64_t t_pre_us;                         // Fim do preambulo (instante da amostra sem timesync)
+    int16_t rssi;
+    bool    late;                             // Liberado depois de frames mais novos (ARQ) ou refeito (FEC)
+}link_rx_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+bool   link_decode(const uint8_t *buf, size_t len, link_frame_t *out);   // Separa cabecalho e payload
+size_t link_encode_hdr(uint8_t *buf, uint8_t type, uint8_t node, uint8_t flags, uint8_t seq); // Escreve o cabecalho
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
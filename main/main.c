@@ -23,6 +23,33 @@ Date: 2024, March.
 #include "freertos/semphr.h"
 #include "driver/i2c.h"
 #include "lcd_jr.h"
+#include "display.h"
+#include "telemetry.h"
+#include "geo.h"
+#include "settings.h"
+#include "sample_ring.h"
+#include "uplink.h"
+#include "instr.h"
+#include "link.h"
+#include "nodes.h"
+#include "radio.h"
+#include "tdma.h"
+#include "delta.h"
+#include "integrity.h"
+#include "power.h"
+#include "console.h"
+#include "flashlog.h"
+#include "transport.h"
+#include "wifi_uplink.h"
+#include "pktpool.h"
+#include "metrics.h"
+#include "alarm.h"
+#include "radiosup.h"
+#include "esp_timer.h"
+#ifdef CONFIG_POWER_RX_CAD
+#include "esp_pm.h"
+#include "esp_sleep.h"
+#endif
 #include <string.h>
 
 //==================================================================================================================================================================
@@ -31,19 +58,39 @@ volatile bool EnterPressed = false;
 volatile bool ExitPressed  = false;
 volatile bool UpPressed    = false;
 volatile bool DownPressed  = false;
-volatile int cont= 0;
+volatile int cont= 11;                        // Abre no Painel
 
-const char *Menu[]          = {"LoRa","Temperatura","MPU6050","Altitude","Velocidade","Pressao"};
-const char *MenuMPU6050[]   = {"Roll", "Pitch"};
-const char *MPUValues[2];
+const char *Menu[]          = {"LoRa","Temperatura","MPU6050","Altitude","Velocidade","Pressao","GPS","Antena","Diagnostico","Transmissor","Voo","Painel"};
+const char *MenuMPU6050[]   = {"Roll", "Pitch", "Roll m", "Pitch m"};   // "m" = media (metrics.h)
+const char *MPUValues[4];
 
-#define tamMenu 6
+#define tamMenu 12
+#define tamMPU  4
 
 //==================================================================================================================================================================
 //--- Handles para gerenciamento ---
 QueueHandle_t Queueintr;	// Cria a fila como variavel global
 SemaphoreHandle_t MutexMenu;
-SemaphoreHandle_t MutexLora;
+TaskHandle_t TaskDataExcel;
+TaskHandle_t TaskReceive;
+TaskHandle_t TaskMain;
+volatile int64_t RxDoneTime;              // Carimbo do ultimo RxDone (DIO0), 0 = consumido
+
+//==================================================================================================================================================================
+//--- Memoria das tasks e filas (estatica, tamanhos no menu "Memory plan") ---
+static StackType_t   RadioStack[CONFIG_STACK_RADIO];
+static StaticTask_t  RadioTcb;
+static StackType_t   ButtonStack[CONFIG_STACK_BUTTON];
+static StaticTask_t  ButtonTcb;
+#ifndef CONFIG_TELEMETRY_HEADLESS
+static StackType_t   MenuStack[CONFIG_STACK_MENU];
+static StaticTask_t  MenuTcb;
+#endif
+static StackType_t   UplinkStack[CONFIG_STACK_UPLINK];
+static StaticTask_t  UplinkTcb;
+static uint8_t       ButtonQueueBuf[CONFIG_BUTTON_QUEUE_LEN * sizeof(int)];
+static StaticQueue_t ButtonQueue;
+static StaticSemaphore_t MenuMutexBuf;
 
 //==================================================================================================================================================================
 //--- Variaveis Controle Push Button ---
@@ -54,31 +101,54 @@ SemaphoreHandle_t MutexLora;
 
 //==================================================================================================================================================================
 //--- Variaveis LoRa ---
-#define BUFFER 2024
 #define FREQUENCY 915e6
 #define BW 125e3
 static const char *TAG2 = "LoRa";
 
+// Bits de notificacao do ReceiveLoraData. A passagem entre nucleos e feita so por notificacao ou
+// pelo SampleRing; nenhum mutex e compartilhado com as tasks do nucleo de aplicacao.
+#define RX_NOTIFY_DIO0    0x01                // RxDone no DIO0
+#define RX_NOTIFY_STATION 0x02                // stationNew pronta para ser aplicada
+#define RX_NOTIFY_DIO1    0x04                // RxTimeout / CadDetected no DIO1 (modo CAD)
+#define RX_NOTIFY_PROFILE 0x08                // RadioProfileNew pedido pelo console
+#define RX_NOTIFY_REGS    0x10                // Dump dos registradores pedido pelo console
+#define RX_BURST_MAX      16                  // RxDone seguidos sem esperar; mais que isso nao cabe no ar
+
+#define ALERT_LCD_MS      3000                // Alerta de alarme na tela, se nenhum botao for apertado antes
+#define DASH_SPARK_MAX    (DISP_COLS_MAX - 11)  // Sparkline de altitude no Painel: o que sobra da linha 1
+#define DASH_SPARK_MS     2000                // Um ponto do sparkline a cada 2 s (5 celulas no 16x2 = 10 s)
+#define DASH_RSSI_MIN     -120                // Escala das barras do Painel
+#define DASH_RSSI_MAX     -40
+#define DASH_SNR_MIN      -20
+#define DASH_SNR_MAX      10
+
 //==================================================================================================================================================================
 //--- Structs ---
 typedef struct{
-    uint32_t pressure_bmp;
-    float temp;
-    float anglePitchDeg;
-    float angleRollDeg;
-    char lat[30];
-    char lat_dir[1];
-    char lon[30];
-    char lon_dir[1];
-    float altitude;
-    float speed;
-    char buf[BUFFER];
-    uint8_t packetLoRa[255];
-    uint8_t SNR;
-    int RSSI;
+    telemetry_sample_t tlm;                   // Copia da ultima amostra usada pelo MenuDisp
+    char buf[UPLINK_LINE_MAX];                // Uma linha CSV/JSON do uplink
 }variable;
 
 variable vars;
+geo_station_t station;                        // Origem para range/bearing/elevation (so o ReceiveLoraData usa)
+geo_station_t stationNew;                     // Estacao gravada pelo menu, aplicada via RX_NOTIFY_STATION
+sample_ring_t SampleRing;                     // Amostras decodificadas -> uplink
+telemetry_sample_t MenuNodes[NODE_MAX];       // Ultima amostra de cada no, vista pelo MenuDisp
+uint32_t MenuCount[NODE_MAX];                 // Amostras por no vistas pelo MenuDisp
+uint8_t MenuNode;                             // No exibido nas telas
+#ifdef CONFIG_TDMA
+tdma_t Tdma;                                  // Escalonador de slots (so o ReceiveLoraData usa)
+#endif
+bool RxDuty;                                  // Recepcao por ciclos de CAD em vigor (so o ReceiveLoraData usa)
+uint8_t RadioProfile = RADIO_PROFILE_ACTIVE;  // Perfil aplicado (so o ReceiveLoraData escreve depois do boot)
+uint8_t RadioProfileNew;                      // Perfil pedido, aplicado via RX_NOTIFY_PROFILE
+TaskHandle_t RadioRequester;                  // Task que espera o fim de um pedido ao radio
+#ifdef CONFIG_POWER_RX_CAD
+power_plan_t PowerPlan;                       // Tempos do ciclo CAD para o perfil ativo
+#endif
+int64_t RxLastUs;                             // Ultima telemetria valida de qualquer no (so o ReceiveLoraData usa)
+pkt_buf_t RxScratch;                          // FIFO lido aqui com o pool esgotado (decodificado, nao publicado)
+char RawLine[PKT_LINE_MAX];                   // Linha $RAW da captura (so o DataExcel usa)
 
 //==================================================================================================================================================================
 //--- Tasks prototipos ---
@@ -90,10 +160,45 @@ void ReceiveLoraData(void *p); // Recebe parametros LoRa.
 //==================================================================================================================================================================
 //--- Functions prototipos ---
 esp_err_t setupLoRa(void);
+static void RadioConfig(void);                       // Frequencia, potencia, sync word e perfil (boot e recuperacao)
+static void RadioApply(const radio_profile_t *prof);  // Modem SF/BW/CR/preambulo/CRC do perfil
+static bool RadioSupervise(int expect, bool force);  // Registros + silencio; true se o radio foi reiniciado
+static void RadioRecover(radiosup_reason_t why, int64_t t0);  // lora_restart + configuracao guardada, sem reboot
+static bool RadioRequest(uint32_t bit);              // Pedido do console a task do radio (espera o fim)
+static bool ConsoleProfile(uint8_t id);
+static bool ConsoleRegs(void);
+static void LcdShown(const telemetry_sample_t *t);   // Registra a latencia amostra -> LCD
+static void MenuSample(variable *v);                 // Drena o SampleRing por no e copia o no selecionado em v->tlm
+static bool MenuAlert(void);                         // Alarme disparado interrompe a tela atual
+static void MenuSplash(void);                        // LCD + splash no inicio do MenuDisp, em paralelo com o radio
+static void MenuCompose(const char *l1, const char *l2);  // Duas linhas no quadro do display, sem flush
+static void MenuShow(const char *l1, const char *l2);  // MenuCompose + um flush (so o que mudou vai pelo I2C)
+static void MenuList(void);                          // Item atual e os seguintes do Menu[], um por linha do display
+static void MenuDashboard(const telemetry_sample_t *t);  // Painel: altitude, vz, sparkline, fase, RSSI/SNR e distancia
+static void RxWatchdog(void);                        // Regras de enlace: nos mudos ha N intervalos
+static int  RxRead(void);                            // FIFO -> buffer do pool -> taps + RxFrame; devolve o tamanho lido
+static void RadioSend(uint8_t *buf, size_t len);     // TX bloqueante do receptor (beacon, ACK)
+static void RxFrame(const uint8_t *buf, size_t len, const link_rx_t *rx);  // Cabecalho -> no -> tipo
+static void RxPayload(node_state_t *node, uint8_t id, const uint8_t *p, size_t len, const link_rx_t *rx);
+static void RxSample(node_state_t *node, uint8_t id, telemetry_sample_t *s, const link_rx_t *rx);
+#ifdef CONFIG_ARQ
+static void RxReliable(node_state_t *node, const link_frame_t *f, const link_rx_t *rx);
+static void RxReliableTimeout(void);                 // Libera frames presos atras de lacunas vencidas
+#endif
+#ifdef CONFIG_POWER_RX_CAD
+static bool PowerSetup(void);                        // Plano do ciclo CAD, wakeup por DIO e light sleep
+static void RxDutyCycle(uint32_t *notify);  // Sleep -> CAD -> RX_SINGLE
+static void RxWaitUntil(int64_t deadline, uint32_t *notify);
+static void DioArm(void);                            // Religa as interrupcoes de nivel do DIO0/DIO1
+#endif
 
 //==================================================================================================================================================================
 //--- interrupcoes prototipos ---
 static void DataButton(void *args);  // interrupção para verificar qual botão foi acionado
+static void DioRxDone(void *args);   // interrupção do DIO0 (RxDone) para carimbar a recepção
+#ifdef CONFIG_POWER_RX_CAD
+static void DioWake(void *args);     // interrupção de nivel do DIO0/DIO1 no modo CAD
+#endif
 
 //==================================================================================================================================================================
 //--- Main Function ---
@@ -116,36 +221,68 @@ void app_main(void)
 	gpio_set_intr_type(ButtonUP,GPIO_INTR_NEGEDGE);
 	gpio_set_intr_type(ButtonDown,GPIO_INTR_NEGEDGE);
 
-  ESP_ERROR_CHECK(setupLoRa());                             // Inicializa LoRa.
+	gpio_set_direction(CONFIG_DIO0_GPIO,GPIO_MODE_INPUT);			// DIO0 = RxDone no modo RX (REG_DIO_MAPPING_1 = 0)
+	gpio_set_intr_type(CONFIG_DIO0_GPIO,GPIO_INTR_POSEDGE);
 
-	Queueintr = xQueueCreate(10,sizeof(int));							    // Cria a fila e passa seu tamanho junto com o tipo de dados
-  MutexMenu = xSemaphoreCreateMutex();
-  MutexLora = xSemaphoreCreateMutex();
-	xTaskCreate(ReadButton,"ReadButton",configMINIMAL_STACK_SIZE + 2000,NULL,3,NULL);		            // Cria uma task para Ler o botão com prioridade alta
-	xTaskCreate(MenuDisp,"menuDisp",configMINIMAL_STACK_SIZE + 2000,(void*)&vars,3,NULL);				    // Cria uma task para Manipular o menu e mostrar as informacoes no LCD
-	xTaskCreate(DataExcel,"DataExcel",configMINIMAL_STACK_SIZE+2000,(void*)&vars,2,NULL);		        // Cria uma task para receber os dados via LoRa
-  xTaskCreatePinnedToCore(ReceiveLoraData,"ReceiveLoraData",configMINIMAL_STACK_SIZE+2000,(void*)&vars,4,NULL,1);
+  transport_start();                                        // Porta do uplink e canal de log
+  ESP_ERROR_CHECK(settings_init());                         // NVS com a posicao da estacao
+  int32_t gsLat, gsLon, gsAlt;
+  settings_load_station(&gsLat, &gsLon, &gsAlt);
+  geo_set_station(&station, gsLat, gsLon, (float)gsAlt);
+#ifdef CONFIG_LINK_INTEGRITY_SIPHASH
+  uint8_t linkKey[INTEG_KEY_LEN];
+  if(settings_load_link_key(linkKey))
+    integ_set_key(linkKey);
+  else
+    ESP_LOGE(TAG2, "Sem chave de enlace na NVS: frames com cabecalho rejeitados, beacon e ACK nao transmitidos");
+#endif
+  settings_load_radio_profile(&RadioProfile);
+  if(radio_profile(RadioProfile) == NULL)
+    RadioProfile = RADIO_PROFILE_ACTIVE;
+  alarm_rule_t alarmRules[ALARM_RULE_MAX];
+  int nAlarms = settings_load_alarms(alarmRules);
+  if(nAlarms < 0)                                           // Nunca gravadas pelo console: watchdog de enlace do menuconfig
+  {
+    nAlarms = 0;
+    if(CONFIG_ALARM_LINK_PERIODS > 0)
+      alarmRules[nAlarms++] = (alarm_rule_t){.threshold = CONFIG_ALARM_LINK_PERIODS, .field = ALARM_F_LINK,
+                                             .op = ALARM_GT, .node = ALARM_NODE_ANY};
+  }//end if
+  if(!alarm_set_rules(alarmRules, (size_t)nAlarms))
+    ESP_LOGE(TAG2, "Regras de alarme invalidas na NVS: ignoradas");
+  sample_ring_init(&SampleRing);
+  pktpool_init();
+  flashlog_init(&SampleRing);
+  nodes_reset();
+  instr_start();                                            // Histogramas de latencia e relatorio periodico
 
-	gpio_install_isr_service(0);										          // Config. das interrupcoes p/ adicionar pinos individualmente.
+	Queueintr = xQueueCreateStatic(CONFIG_BUTTON_QUEUE_LEN,sizeof(int),ButtonQueueBuf,&ButtonQueue);	// Fila dos botoes, sem heap
+  MutexMenu = xSemaphoreCreateMutexStatic(&MenuMutexBuf);
+
+  // O radio (SPI + parse) fica sozinho no CONFIG_RADIO_CORE; LCD/I2C, botoes, uplink e relatorios
+  // ficam no CONFIG_APP_CORE. O ReceiveLoraData inicializa o SPI e o servico de ISR de GPIO no
+  // proprio nucleo, para que as interrupcoes do radio tambem caiam nele.
+  // Boot em paralelo: o radio sobe no seu nucleo enquanto o MenuDisp inicia o LCD e mostra o splash
+  // neste; so os handlers dos botoes precisam esperar o servico de ISR criado pelo radio.
+  TaskMain = xTaskGetCurrentTaskHandle();
+  TaskReceive = xTaskCreateStaticPinnedToCore(ReceiveLoraData,"ReceiveLoraData",sizeof(RadioStack),NULL,CONFIG_PRIO_RADIO,RadioStack,&RadioTcb,CONFIG_RADIO_CORE);
+	xTaskCreateStaticPinnedToCore(ReadButton,"ReadButton",sizeof(ButtonStack),NULL,CONFIG_PRIO_BUTTON,ButtonStack,&ButtonTcb,CONFIG_APP_CORE);		      // Cria uma task para Ler o botão com prioridade alta
+#ifndef CONFIG_TELEMETRY_HEADLESS
+	xTaskCreateStaticPinnedToCore(MenuDisp,"menuDisp",sizeof(MenuStack),(void*)&vars,CONFIG_PRIO_MENU,MenuStack,&MenuTcb,CONFIG_APP_CORE);		  // Cria uma task para Manipular o menu e mostrar as informacoes no LCD
+#endif
+	TaskDataExcel = xTaskCreateStaticPinnedToCore(DataExcel,"DataExcel",sizeof(UplinkStack),(void*)&vars,CONFIG_PRIO_UPLINK,UplinkStack,&UplinkTcb,CONFIG_APP_CORE); // Envia as amostras para o PC
+  wifi_uplink_start(&SampleRing);                           // Fan-out UDP/TCP/WebSocket (CONFIG_NET_UPLINK)
+#ifdef CONFIG_CONSOLE
+  static const console_ops_t consoleOps = {ConsoleProfile, ConsoleRegs};
+  console_start(&consoleOps, RadioProfile);                 // Comandos pela UART do uplink
+#endif
+
+  ulTaskNotifyTake(pdTRUE,portMAX_DELAY);                   // Espera o radio e o servico de ISR
 	gpio_isr_handler_add(ButtonEnter, DataButton,(void *)ButtonEnter);	
 	gpio_isr_handler_add(ButtonExit, DataButton,(void *)ButtonExit);
 	gpio_isr_handler_add(ButtonUP, DataButton,(void *)ButtonUP);
 	gpio_isr_handler_add(ButtonDown, DataButton,(void *)ButtonDown);
-  disp_Init();
-  disp_Clear();
-  __Delay(200);
-  disp_WriteCmd(LCD_1POS);  // Move o cursor para a primeira posição
-  disp_Puts("Telemetry System");
-  disp_WriteCmd(LCD_2POS);
-  disp_Puts("Abutres - v.01");
-  __Delay(2000);
-  disp_Clear();
-  disp_WriteCmd(LCD_1POS);
-  disp_Putrs(">");
-  disp_Putrs(Menu[cont]);
-  disp_WriteCmd(LCD_2POS);
-  disp_Putrs(" ");
-  disp_Putrs(Menu[( cont+1 )< 6 ? (cont+1) : 0 ]);
+  instr_boot(INSTR_BOOT_READY);
 
   while(true)
   {
@@ -164,6 +301,33 @@ static void IRAM_ATTR DataButton(void *args)
 	xQueueSendFromISR(Queueintr,&pin,NULL);
 }//end dataButton
 
+//==================================================================================================================================================================
+//--- DioRxDone ---
+static void IRAM_ATTR DioRxDone(void *args)
+{
+	BaseType_t woken = pdFALSE;
+	RxDoneTime = esp_timer_get_time();
+	xTaskNotifyFromISR(TaskReceive,RX_NOTIFY_DIO0,eSetBits,&woken);
+	portYIELD_FROM_ISR(woken);
+}//end DioRxDone
+
+#ifdef CONFIG_POWER_RX_CAD
+//==================================================================================================================================================================
+//--- DioWake ---
+// Fonte de wakeup do light sleep so funciona por nivel: a interrupcao do pino fica desligada ate a
+// task limpar o RegIrqFlags do radio (DioArm), senao o nivel alto dispararia sem parar.
+static void IRAM_ATTR DioWake(void *args)
+{
+	BaseType_t woken = pdFALSE;
+	int pin = (int)args;
+	gpio_intr_disable(pin);
+	if(pin == CONFIG_DIO0_GPIO)
+	  RxDoneTime = esp_timer_get_time();
+	xTaskNotifyFromISR(TaskReceive,pin == CONFIG_DIO0_GPIO ? RX_NOTIFY_DIO0 : RX_NOTIFY_DIO1,eSetBits,&woken);
+	portYIELD_FROM_ISR(woken);
+}//end DioWake
+#endif
+
 //==================================================================================================================================================================
 //--- readButton ---
 void ReadButton(void *p)
@@ -206,21 +370,18 @@ void ReadButton(void *p)
 void MenuDisp(void *p)
 {
   variable *PacketMenu=(variable*)p;
+  MenuSplash();
 	while(true)
 	{
     if(xSemaphoreTake(MutexMenu,portMAX_DELAY))
 		{
       __Delay(250);
-      disp_Clear();
-      disp_WriteCmd(LCD_1POS);
-      disp_Putrs(">");
-      disp_Putrs(Menu[cont]);
-      disp_WriteCmd(LCD_2POS);
-      disp_Putrs(" ");
-      disp_Putrs(Menu[( cont+1 )< 6 ? (cont+1) : 0 ]);
+      MenuList();
       while(!EnterPressed && !ExitPressed && !UpPressed && !DownPressed)
 		  {
 			  vTaskDelay(350/portTICK_PERIOD_MS);
+        if(MenuAlert())
+          break;                                  // Nenhum botao: so redesenha o menu
 		  }//end while aninhado
       if(UpPressed)
       {
@@ -240,16 +401,9 @@ void MenuDisp(void *p)
       {
         //printf("Botao Exit pressionado\n");
         ExitPressed = false;
-        if(cont >= 0 && cont <= 5)
+        if(cont >= 0 && cont < tamMenu)
         {
-          __Delay(2);
-          disp_Clear();
-          disp_WriteCmd(LCD_1POS);
-          disp_Putrs(">");
-          disp_Putrs(Menu[cont]);
-          disp_WriteCmd(LCD_2POS);
-          disp_Putrs(" ");
-          disp_Putrs(Menu[( cont+1 )< 6 ? (cont+1) : 0 ]);
+          MenuList();
         }//end if
         __Delay(10);
       }//end else if
@@ -262,32 +416,27 @@ void MenuDisp(void *p)
           case 0:
             while(!ExitPressed)
             {
-              char SnrStr[5];
-              char RssiStr[5];
-              sprintf(SnrStr,"%d",PacketMenu->SNR);
-              sprintf(RssiStr,"%d",PacketMenu->RSSI);
-              __Delay(2);
-              disp_Clear();
-              disp_WriteCmd(LCD_1POS);
-              disp_Puts("SNR:");
-              disp_Puts(SnrStr);
-              disp_WriteCmd(LCD_2POS);
-              disp_Puts("RSSI:");
-              disp_Puts(RssiStr);
+              MenuSample(PacketMenu);
+              char SnrStr[17];
+              char RssiStr[17];
+              snprintf(SnrStr,sizeof(SnrStr),"SNR:%d",PacketMenu->tlm.SNR);
+              snprintf(RssiStr,sizeof(RssiStr),"RSSI:%d",PacketMenu->tlm.rssi);
+              MenuCompose(SnrStr,RssiStr);      // Texto e barras no quadro, um flush so por volta
+              disp_FbBar(0,10,6,(float)(PacketMenu->tlm.SNR - DASH_SNR_MIN) / (DASH_SNR_MAX - DASH_SNR_MIN));
+              disp_FbBar(1,10,6,(float)(PacketMenu->tlm.rssi - DASH_RSSI_MIN) / (DASH_RSSI_MAX - DASH_RSSI_MIN));
+              disp_Flush();
+              LcdShown(&PacketMenu->tlm);
               __Delay(250);
             }//end while
             break;
           case 1:
             while(!ExitPressed)
             {
-              __Delay(2);
-              disp_Clear();
-              disp_WriteCmd(LCD_1POS);
-              disp_Puts("Temperatura:");
-              disp_WriteCmd(LCD_2POS);
-              char TempStr[10];
-              sprintf(TempStr,"%.2f",PacketMenu->temp);
-              disp_Puts(TempStr);
+              MenuSample(PacketMenu);
+              char TempStr[17];
+              snprintf(TempStr,sizeof(TempStr),"%.2f",PacketMenu->tlm.temp);
+              MenuShow("Temperatura:",TempStr);
+              LcdShown(&PacketMenu->tlm);
               __Delay(250);
             }//end While
             break;
@@ -295,6 +444,7 @@ void MenuDisp(void *p)
             int contMenuMP = 0;
             while(!ExitPressed)
             {
+              MenuSample(PacketMenu);
               while(!EnterPressed && !ExitPressed && !UpPressed && !DownPressed)
               {
                 vTaskDelay(350/portTICK_PERIOD_MS);
@@ -302,30 +452,32 @@ void MenuDisp(void *p)
 
               char RollStr[10];
               char PitchStr[10];
-              sprintf(RollStr,"%.2f",PacketMenu->angleRollDeg);
-              sprintf(PitchStr,"%.2f",PacketMenu->anglePitchDeg);
+              char RollAvgStr[10];
+              char PitchAvgStr[10];
+              char Line1[17];
+              char Line2[17];
+              sprintf(RollStr,"%.2f",PacketMenu->tlm.angleRollDeg);
+              sprintf(PitchStr,"%.2f",PacketMenu->tlm.anglePitchDeg);
+              sprintf(RollAvgStr,"%.1f",PacketMenu->tlm.roll_avg);
+              sprintf(PitchAvgStr,"%.1f",PacketMenu->tlm.pitch_avg);
               MPUValues[0] = RollStr;
               MPUValues[1] = PitchStr;
-              disp_Clear();
-              disp_WriteCmd(LCD_1POS);
-              disp_Putrs(">");
-              disp_Putrs(MenuMPU6050[contMenuMP]);
-              disp_Puts(":");
-              disp_Putrs(MPUValues[contMenuMP]);
-              disp_WriteCmd(LCD_2POS);
-              disp_Putrs(" ");
-              disp_Putrs(MenuMPU6050[(contMenuMP+1) < 2 ? (contMenuMP+1) : 0]);
-              disp_Puts(":");
-              disp_Putrs(MPUValues[(contMenuMP+1) < 2 ? (contMenuMP+1) : 0]);
+              MPUValues[2] = RollAvgStr;
+              MPUValues[3] = PitchAvgStr;
+              int nextMP = (contMenuMP+1) < tamMPU ? (contMenuMP+1) : 0;
+              snprintf(Line1,sizeof(Line1),">%s:%s",MenuMPU6050[contMenuMP],MPUValues[contMenuMP]);
+              snprintf(Line2,sizeof(Line2)," %s:%s",MenuMPU6050[nextMP],MPUValues[nextMP]);
+              MenuShow(Line1,Line2);
+              LcdShown(&PacketMenu->tlm);
 
               if(DownPressed)
               {
-                contMenuMP = (contMenuMP+1)<2 ? (contMenuMP+1) : 0;
+                contMenuMP = (contMenuMP+1)<tamMPU ? (contMenuMP+1) : 0;
                 DownPressed = false;
               }//end downPressed
               else if(UpPressed)
               {
-                contMenuMP = (contMenuMP - 1) >= 0 ? (contMenuMP - 1) : 1;
+                contMenuMP = (contMenuMP - 1) >= 0 ? (contMenuMP - 1) : (tamMPU - 1);
                 UpPressed = false;
               }//end UpPressed
               __Delay(200);
@@ -334,52 +486,185 @@ void MenuDisp(void *p)
           case 3:
             while(!ExitPressed)
             {
-              char AltiStr[10];
-              sprintf(AltiStr,"%.2f",PacketMenu->altitude);
-              __Delay(2);
-              disp_Clear();
-              disp_WriteCmd(LCD_1POS);
-              disp_Puts("Altitude:");
-              disp_WriteCmd(LCD_2POS);
-              disp_Puts(AltiStr);
+              MenuSample(PacketMenu);
+              char AltiStr[17];
+              snprintf(AltiStr,sizeof(AltiStr),"%.2f",PacketMenu->tlm.altitude);
+              MenuShow("Altitude:",AltiStr);
+              LcdShown(&PacketMenu->tlm);
               __Delay(250);
             }//end While
             break;
           case 4:
             while(!ExitPressed)
             {
-              char StrVel[10];
-              sprintf(StrVel,"%.3f",PacketMenu->speed);
-              __Delay(2);
-              disp_Clear();
-              disp_WriteCmd(LCD_1POS);
-              disp_Puts("Velocidade:");
-              disp_WriteCmd(LCD_2POS);
-              disp_Puts(StrVel);
-              disp_Putrs(" Km/h");
+              MenuSample(PacketMenu);
+              char StrVel[17];
+              snprintf(StrVel,sizeof(StrVel),"%.3f Km/h",PacketMenu->tlm.speed);
+              MenuShow("Velocidade:",StrVel);
+              LcdShown(&PacketMenu->tlm);
               __Delay(250);
             }//end While
             break;
           case 5:
             while(!ExitPressed)
             {
-              char StrPressure[15];
-              sprintf(StrPressure,"%lu",PacketMenu->pressure_bmp);
-              __Delay(2);
-              disp_Clear();
-              disp_WriteCmd(LCD_1POS);
-              disp_Puts("Pressao:");
-              disp_WriteCmd(LCD_2POS);
-              disp_Puts(StrPressure);
+              MenuSample(PacketMenu);
+              char StrPressure[17];
+              snprintf(StrPressure,sizeof(StrPressure),"%lu",PacketMenu->tlm.pressure_bmp);
+              MenuShow("Pressao:",StrPressure);
+              LcdShown(&PacketMenu->tlm);
               __Delay(250);
               //printf("case 5 pressionado\n");
             }//end While
             break;
+          case 6:
+            while(!ExitPressed)
+            {
+              MenuSample(PacketMenu);
+              char DistStr[17];
+              char RumoStr[17];
+              if(PacketMenu->tlm.flags & TELEM_FLAG_GEO)
+              {
+                snprintf(DistStr,sizeof(DistStr),"Dist:%.0f m",PacketMenu->tlm.range_m);
+                snprintf(RumoStr,sizeof(RumoStr),"Rumo:%.1f",PacketMenu->tlm.bearing_deg);
+                MenuShow(DistStr,RumoStr);
+                LcdShown(&PacketMenu->tlm);
+              }//end if
+              else
+              {
+                MenuShow("GPS sem fix","");
+              }//end else
+              __Delay(250);
+            }//end While
+            break;
+          case 7:
+            EnterPressed = false;                     // Enter dentro da tela grava a posicao atual como estacao
+            while(!ExitPressed)
+            {
+              MenuSample(PacketMenu);
+              char AzElStr[17];
+              char RangeStr[17];
+              telemetry_sample_t t = PacketMenu->tlm;
+              if(EnterPressed)
+              {
+                EnterPressed = false;
+                if((t.flags & TELEM_FLAG_FIX) && settings_save_station(t.lat_e7, t.lon_e7, (int32_t)t.altitude) == ESP_OK)
+                {
+                  geo_set_station(&stationNew, t.lat_e7, t.lon_e7, t.altitude);
+                  xTaskNotify(TaskReceive,RX_NOTIFY_STATION,eSetBits);   // Aplicada pelo ReceiveLoraData no proximo ciclo
+                  MenuShow("Estacao gravada","");
+                }//end if
+                else
+                {
+                  MenuShow("Falha: sem fix","");
+                }//end else
+                __Delay(1000);
+              }//end if
+              if(t.flags & TELEM_FLAG_GEO)
+              {
+                snprintf(AzElStr,sizeof(AzElStr),"Az%.1f El%.1f",t.bearing_deg,t.elevation_deg);
+                snprintf(RangeStr,sizeof(RangeStr),"R:%.0f m",t.range_m);
+                MenuShow(AzElStr,RangeStr);
+                LcdShown(&t);
+              }//end if
+              else
+              {
+                MenuShow("GPS sem fix","Enter: gravar");
+              }//end else
+              __Delay(250);
+            }//end While
+            break;
+          case 8:
+            int contDiag = 0;                         // Up/Down: um trecho de latencia por pagina + pilha minima
+            while(!ExitPressed)
+            {
+              MenuSample(PacketMenu);
+              char Line1[17];
+              char Line2[17];
+              if(DownPressed)
+              {
+                contDiag = (contDiag+1) <= INSTR_LAT_COUNT ? (contDiag+1) : 0;
+                DownPressed = false;
+              }//end if
+              else if(UpPressed)
+              {
+                contDiag = (contDiag-1) >= 0 ? (contDiag-1) : INSTR_LAT_COUNT;
+                UpPressed = false;
+              }//end else if
+              if(contDiag < INSTR_LAT_COUNT)
+              {
+                lat_hist_t h;
+                instr_get_latency((instr_lat_t)contDiag,&h);
+                snprintf(Line1,sizeof(Line1),"%.9s n%lu",instr_latency_name((instr_lat_t)contDiag),(unsigned long)h.count);
+                snprintf(Line2,sizeof(Line2),"p99%lu M%lu",(unsigned long)(lat_hist_percentile(&h,99)/1000),(unsigned long)(h.max_us/1000));
+              }//end if
+              else
+              {
+                char TaskName[17];
+                uint32_t Free = 0;
+                if(!instr_min_stack(TaskName,sizeof(TaskName),&Free))
+                  snprintf(TaskName,sizeof(TaskName),"-");
+                snprintf(Line1,sizeof(Line1),"Pilha min:");
+                snprintf(Line2,sizeof(Line2),"%.10s %lu",TaskName,(unsigned long)Free);
+              }//end else
+              MenuShow(Line1,Line2);
+              __Delay(250);
+            }//end While
+            break;
+          case 9:
+            while(!ExitPressed)
+            {
+              MenuSample(PacketMenu);
+              char Line1[17];
+              char Line2[17];
+              if(DownPressed)
+              {
+                MenuNode = (MenuNode+1) < NODE_MAX ? (MenuNode+1) : 0;
+                DownPressed = false;
+              }//end if
+              else if(UpPressed)
+              {
+                MenuNode = MenuNode > 0 ? (MenuNode-1) : (NODE_MAX-1);
+                UpPressed = false;
+              }//end else if
+              telemetry_sample_t *t = &MenuNodes[MenuNode];
+              snprintf(Line1,sizeof(Line1),"No %u n:%lu",MenuNode,(unsigned long)MenuCount[MenuNode]);
+              if(MenuCount[MenuNode])
+                snprintf(Line2,sizeof(Line2),"%ddBm %llus",t->rssi,(unsigned long long)((esp_timer_get_time() - t->t_rx_us)/1000000));
+              else
+                snprintf(Line2,sizeof(Line2),"sem pacotes");
+              MenuShow(Line1,Line2);
+              __Delay(250);
+            }//end While
+            break;
+          case 10:
+            while(!ExitPressed)
+            {
+              MenuSample(PacketMenu);
+              char Line1[17];
+              char Line2[17];
+              telemetry_sample_t *t = &PacketMenu->tlm;
+              snprintf(Line1,sizeof(Line1),"%-7s Vz%+.1f",metrics_phase_name(t->phase),t->vspeed);
+              if(t->phase >= METRICS_DESCENT)
+                snprintf(Line2,sizeof(Line2),"Ap%.0fm T%.1fs",t->alt_max,t->apogee_s);
+              else
+                snprintf(Line2,sizeof(Line2),"Max:%.0f m",t->alt_max);
+              MenuShow(Line1,Line2);
+              LcdShown(t);
+              __Delay(250);
+            }//end While
+            break;
+          case 11:
+            while(!ExitPressed)
+            {
+              MenuSample(PacketMenu);
+              MenuDashboard(&PacketMenu->tlm);
+              LcdShown(&PacketMenu->tlm);
+              __Delay(250);
+            }//end While
+            break;
           default:
-            __Delay(2);
-            disp_Clear();
-            disp_WriteCmd(LCD_1POS);
-            disp_Puts("Comando invalido");
+            MenuShow("Comando invalido","");
             vTaskDelay(250/portTICK_PERIOD_MS);
             break;
         }//end switch
@@ -397,159 +682,800 @@ void MenuDisp(void *p)
 void DataExcel(void *p)
 {
   variable *PacketExcel=(variable*)p;
+  sample_reader_t reader;
+  alarm_reader_t alarms;
+  telemetry_sample_t s;
+  alarm_event_t e;
+  char AlarmLine[ALARM_LINE_MAX];
+
+  sample_ring_reader_init(&SampleRing,&reader);
+  alarm_reader_init(&alarms);
 	while(true)
 	{
-    if(xSemaphoreTake(MutexLora,2000/portTICK_PERIOD_MS))
+    ulTaskNotifyTake(pdTRUE,1000/portTICK_PERIOD_MS);       // Acordada pelo ReceiveLoraData a cada amostra
+    while(sample_ring_pop(&SampleRing,&reader,&s))
     {
-      printf("%.1f",PacketExcel->anglePitchDeg);
-      printf(",");
-      printf("%.1f",PacketExcel->angleRollDeg);
-      printf(",");
-      printf("%.2f",PacketExcel->temp);
-      printf(",");
-      printf("%lu",PacketExcel->pressure_bmp);
-      printf(",");
-      printf("%s",PacketExcel->lat);
-      printf(",");
-      printf("%.1s",PacketExcel->lat_dir);
-      printf(",");
-      printf("%.11s",PacketExcel->lon);
-      printf(",");
-      printf("%.1s",PacketExcel->lon_dir);
-      printf(",");
-      printf("%.2f",PacketExcel->altitude);
-      printf(",");
-      printf("%.3f",PacketExcel->speed);
-      printf(",");
-      printf("%u",PacketExcel->SNR);
-      
-    }//end if
-    xSemaphoreGive(MutexLora);
-		__Delay(1000);
+      size_t len = uplink_format(console_uplink(),&s,PacketExcel->buf,sizeof(PacketExcel->buf));
+      transport_write(PacketExcel->buf,len);
+      instr_latency(INSTR_LAT_PARSE_UPLINK, esp_timer_get_time() - s.t_parse_us);
+    }//end while
+    while(alarm_pop(&alarms,&e))                          // Disparos e retornos, uma linha $ALM cada
+      transport_write(AlarmLine,alarm_format(&e,AlarmLine,sizeof(AlarmLine)));
+    pkt_buf_t *pkt;
+    while((pkt = pktpool_take(PKT_TAP_CAPTURE)) != NULL)  // Captura bruta: drena mesmo depois do "capture off"
+    {
+      transport_write(RawLine,pktpool_format(pkt,RawLine,sizeof(RawLine)));
+      pktpool_put(pkt);
+    }//end while
 	}//end while
 }//end Data Excel
 
+//==================================================================================================================================================================
+//--- MenuSample ---
+static void MenuSample(variable *v)
+{
+  static sample_reader_t reader;
+  static bool started = false;
+  telemetry_sample_t s;
+
+  if(!started)
+  {
+    sample_ring_reader_init(&SampleRing,&reader);
+    started = true;
+  }//end if
+  MenuAlert();
+  while(sample_ring_pop(&SampleRing,&reader,&s))          // O(1) por amostra: indexa direto pelo no
+  {
+    MenuNodes[s.node] = s;
+    MenuCount[s.node]++;
+  }//end while
+  v->tlm = MenuNodes[MenuNode];
+}//end MenuSample
+
+//==================================================================================================================================================================
+//--- MenuAlert ---
+// Cada disparo ocupa o LCD ate um botao (que e consumido, nao age na tela de baixo) ou ALERT_LCD_MS;
+// todas as telas chamam MenuSample no inicio do laco e se redesenham inteiras na volta. Os retornos
+// so vao para o uplink.
+static bool MenuAlert(void)
+{
+  static alarm_reader_t reader;
+  static bool started = false;
+  alarm_event_t e;
+  bool shown = false;
+
+  if(!started)
+  {
+    alarm_reader_init(&reader);
+    started = true;
+  }//end if
+  while(alarm_pop(&reader,&e))
+  {
+    if(!e.on)
+      continue;
+    char Line1[17];
+    char Line2[17];
+    snprintf(Line1,sizeof(Line1),"ALARME no %u",e.node);
+    snprintf(Line2,sizeof(Line2),"%s %.1f",alarm_field_name(e.field),e.value);
+    MenuShow(Line1,Line2);
+    for(int ms = 0; ms < ALERT_LCD_MS && !EnterPressed && !ExitPressed && !UpPressed && !DownPressed; ms += 50)
+      vTaskDelay(50/portTICK_PERIOD_MS);
+    EnterPressed = ExitPressed = UpPressed = DownPressed = false;
+    shown = true;
+  }//end while
+  return shown;
+}//end MenuAlert
+
+//==================================================================================================================================================================
+//--- MenuSplash ---
+// O radio ja pode estar recebendo durante o splash; qualquer botao encerra a espera sem virar comando.
+static void MenuSplash(void)
+{
+  disp_Start();                                             // Ja limpa a tela (e carrega a CGRAM no HD44780)
+  MenuShow("Telemetry System","Abutres - v.01");
+  instr_boot(INSTR_BOOT_LCD);
+  for(int ms = 0; ms < CONFIG_BOOT_SPLASH_MS && !EnterPressed && !ExitPressed && !UpPressed && !DownPressed; ms += 50)
+    vTaskDelay(50/portTICK_PERIOD_MS);
+  EnterPressed = ExitPressed = UpPressed = DownPressed = false;
+}//end MenuSplash
+
+//==================================================================================================================================================================
+//--- MenuCompose ---
+// So o quadro: quem desenha mais coisa na mesma tela (barras) compoe tudo e chama disp_Flush uma vez.
+static void MenuCompose(const char *l1, const char *l2)
+{
+  disp_FbClear();
+  disp_FbPuts(0,0,l1);
+  disp_FbPuts(1,0,l2);
+}//end MenuCompose
+
+//==================================================================================================================================================================
+//--- MenuShow ---
+// Sem disp_Clear: a tela nao pisca e so as celulas que mudaram desde o ultimo flush vao pelo I2C.
+static void MenuShow(const char *l1, const char *l2)
+{
+  MenuCompose(l1,l2);
+  disp_Flush();
+}//end MenuShow
+
+//==================================================================================================================================================================
+//--- MenuList ---
+static void MenuList(void)
+{
+  char Line[DISP_COLS_MAX + 1];
+
+  disp_FbClear();
+  for(uint8_t r = 0; r < disp_Rows() && r < tamMenu; r++)
+  {
+    snprintf(Line,sizeof(Line),"%c%s",r ? ' ' : '>',Menu[(cont + r) % tamMenu]);
+    disp_FbPuts(r,0,Line);
+  }//end for
+  disp_Flush();
+}//end MenuList
+
+//==================================================================================================================================================================
+//--- MenuDashboard ---
+// Tudo do no selecionado numa tela:
+//   linha 1: altitude, velocidade vertical e sparkline da altitude (um ponto a cada DASH_SPARK_MS)
+//   linha 2: fase (ou sino com alarme ativo), barra de RSSI, barra de SNR e distancia da estacao
+//     "  812m +12 ....."      (..... = sparkline, ate a ultima coluna)
+//     "^R...S..   12.3k"      (S solo, ^ subida, v descida, P pouso; ... = barras)
+//   Com 4 linhas ou mais (20x4, SSD1306) ainda temperatura/pressao e no/amostras.
+static void MenuDashboard(const telemetry_sample_t *t)
+{
+  static const char PhaseChar[METRICS_PHASE_COUNT] = {'S', '^', 'v', 'P'};
+  static float   Hist[DASH_SPARK_MAX];
+  static uint8_t HistNode = 0xFF;
+  static int64_t HistNext;
+  char Line1[DISP_COLS_MAX + 1];
+  char Range[8];
+  uint8_t cols  = disp_Cols();
+  uint8_t spark = cols - 11;
+
+  if(t->t_rx_us == 0)
+  {
+    MenuShow("Painel","sem pacotes");
+    return;
+  }//end if
+  int64_t now = esp_timer_get_time();
+  if(HistNode != t->node)                               // Outro no: a serie recomeca cheia com o valor atual
+  {
+    for(int i = 0; i < DASH_SPARK_MAX; i++)
+      Hist[i] = t->altitude;
+    HistNode = t->node;
+    HistNext = now + DASH_SPARK_MS * 1000;
+  }//end if
+  else if(now >= HistNext)
+  {
+    memmove(Hist, Hist + 1, (DASH_SPARK_MAX - 1) * sizeof(Hist[0]));
+    Hist[DASH_SPARK_MAX - 1] = t->altitude;
+    HistNext = now + DASH_SPARK_MS * 1000;
+  }//end else if
+
+  snprintf(Line1,sizeof(Line1),"%5.0fm%+4.0f",t->altitude,t->vspeed);
+  if(!(t->flags & TELEM_FLAG_GEO))
+    snprintf(Range,sizeof(Range),"   --- ");
+  else if(t->range_m < 1000.0f)
+    snprintf(Range,sizeof(Range),"%6.0fm",t->range_m);
+  else
+    snprintf(Range,sizeof(Range),"%6.1fk",t->range_m / 1000.0f);
+
+  disp_FbClear();
+  disp_FbPuts(0,0,Line1);
+  disp_FbSpark(0,cols - spark,Hist + DASH_SPARK_MAX - spark,spark);
+  disp_FbPutc(1,0,t->alarms ? DISP_G_BELL : t->phase < METRICS_PHASE_COUNT ? PhaseChar[t->phase] : '?');
+  disp_FbPutc(1,1,'R');
+  disp_FbBar(1,2,3,(float)(t->rssi - DASH_RSSI_MIN) / (DASH_RSSI_MAX - DASH_RSSI_MIN));
+  disp_FbPutc(1,5,'S');
+  disp_FbBar(1,6,2,(float)(t->SNR - DASH_SNR_MIN) / (DASH_SNR_MAX - DASH_SNR_MIN));
+  disp_FbPuts(1,cols - 7,Range);
+  if(disp_Rows() >= 4)
+  {
+    snprintf(Line1,sizeof(Line1),"%5.1fC %lu Pa",t->temp,(unsigned long)t->pressure_bmp);
+    disp_FbPuts(2,0,Line1);
+    snprintf(Line1,sizeof(Line1),"No %u n:%lu",t->node,(unsigned long)MenuCount[t->node]);
+    disp_FbPuts(3,0,Line1);
+  }//end if
+  disp_Flush();
+}//end MenuDashboard
+
+//==================================================================================================================================================================
+//--- LcdShown ---
+// So a primeira vez que uma amostra aparece no LCD conta; redesenhos da mesma amostra sao ignorados.
+static void LcdShown(const telemetry_sample_t *t)
+{
+  static int64_t lastShown = 0;
+  if(t->t_parse_us != 0 && t->t_parse_us != lastShown)
+  {
+    lastShown = t->t_parse_us;
+    instr_latency(INSTR_LAT_PARSE_LCD, esp_timer_get_time() - t->t_parse_us);
+  }//end if
+}//end LcdShown
+
 //==================================================================================================================================================================
 //--- setupLoRa ---
+// Sem resposta do chip o boot continua: o RadioSupervise ve o REG_VERSION errado e tenta de novo.
 esp_err_t setupLoRa(void)
 {   
     if(lora_init() == 0){
-        ESP_LOGE(TAG2, "Error!");
+        ESP_LOGE(TAG2, "SX1276 nao responde, nova tentativa a cada %d ms", RADIOSUP_CHECK_MS);
         return ESP_FAIL;
     }//end if
 
+    RadioConfig();
+
+    ESP_LOGW(TAG2, "LoRa OK!");
+
+    return ESP_OK;
+}//end SetupLoRa
+
+//==================================================================================================================================================================
+//--- RadioConfig ---
+// Tudo que o lora_restart() desfaz. O perfil vem do RadioProfile: uma recuperacao volta ao perfil em uso.
+static void RadioConfig(void)
+{
     lora_set_frequency(FREQUENCY);
-    lora_set_bandwidth(BW);
-    lora_set_spreading_factor(10);
     lora_set_tx_power(20); //lora__init() seta tx power em 17 dbm 
-    lora_enable_crc(); // CRC (verificação de redundancia ciclica) método de detecção de erros, que verifica a integridade dos dados transmitidos com os dados recebidos
-    lora_set_coding_rate(5);
     lora_set_sync_word(0x12);
-    lora_set_preamble_length(6);
+    RadioApply(radio_profile(RadioProfile));
+}//end RadioConfig
+
+//==================================================================================================================================================================
+//--- RadioApply ---
+// Registros de modem so mudam fora do RX: o laco do ReceiveLoraData volta a chamar lora_receive().
+static void RadioApply(const radio_profile_t *prof)
+{
+    lora_idle();
+    lora_set_bandwidth(prof->bw_hz);
+    lora_set_spreading_factor(prof->sf);
+    lora_set_low_data_rate_optimize(radio_ldro(prof));   // Obrigatorio com simbolo >= 16 ms (SF11/SF12 em 125k)
+    if(prof->crc)
+      lora_enable_crc(); // CRC (verificação de redundancia ciclica) método de detecção de erros, que verifica a integridade dos dados transmitidos com os dados recebidos
+    else
+      lora_disable_crc();
+    lora_set_coding_rate(prof->cr);
+    lora_set_preamble_length(prof->preamble);
+    ESP_LOGI(TAG2, "Perfil %s: SF%u BW%lu CR4/%u, frame de 96 B = %lu us no ar", prof->name, prof->sf,
+             (unsigned long)prof->bw_hz, prof->cr, (unsigned long)radio_airtime_us(prof, 96));
+}//end RadioApply
 
-    vTaskDelay(pdMS_TO_TICKS(500));
+//==================================================================================================================================================================
+//--- RadioRequest ---
+// Chamado pela task do console. A task do radio atende no fim do ciclo atual (a notificacao tambem
+// interrompe a espera pelo DIO0) e devolve uma notificacao quando termina.
+static bool RadioRequest(uint32_t bit)
+{
+  RadioRequester = xTaskGetCurrentTaskHandle();
+  xTaskNotify(TaskReceive,bit,eSetBits);
+  return ulTaskNotifyTake(pdTRUE,pdMS_TO_TICKS(5000)) != 0;  // Cobre um TX de beacon/ACK em SF12
+}//end RadioRequest
 
-    ESP_LOGW(TAG2, "LoRa OK!");
+static bool ConsoleProfile(uint8_t id)
+{
+  RadioProfileNew = id;
+  return RadioRequest(RX_NOTIFY_PROFILE);
+}//end ConsoleProfile
 
-    return ESP_OK;
-}//end SetupLoRa
+static bool ConsoleRegs(void)
+{
+  return RadioRequest(RX_NOTIFY_REGS);
+}//end ConsoleRegs
 
 //==================================================================================================================================================================
 //--- ReceiveLoraData ---
 void ReceiveLoraData(void *p)
 {
-  variable *vPacket=(variable*)p;
+  uint32_t notify;
+
+  TaskReceive = xTaskGetCurrentTaskHandle();                // A ISR do DIO0 pode disparar antes do xTaskCreate retornar
+  if(setupLoRa() == ESP_OK)                                 // Inicializa LoRa neste nucleo (ISR do SPI)
+    instr_boot(INSTR_BOOT_RADIO);
+  radiosup_init(CONFIG_RADIO_SILENCE_MS, esp_timer_get_time());
+	gpio_install_isr_service(0);										          // Config. das interrupcoes p/ adicionar pinos individualmente.
+#ifdef CONFIG_POWER_RX_CAD
+  RxDuty = PowerSetup();                                    // Sem plano possivel fica no RX continuo
+#else
+  power_set_mode(false, false, esp_timer_get_time());
+#endif
+#ifdef CONFIG_LORA_SIM
+  lora_sim_attach_dio0(DioRxDone, NULL);                    // Radio simulado chama o handler direto
+#else
+  if(!RxDuty)
+	  gpio_isr_handler_add(CONFIG_DIO0_GPIO, DioRxDone, NULL);
+#endif
+  xTaskNotifyGive(TaskMain);
+  instr_boot(INSTR_BOOT_RX);
+
+#ifdef CONFIG_TDMA
+  tdma_init(&Tdma, radio_profile(RadioProfile), CONFIG_TDMA_FRAME_MAX, CONFIG_TDMA_GUARD_US,
+            CONFIG_TDMA_LEAD_US, CONFIG_TDMA_CYCLE_MS * 1000);
+  int64_t nextBeacon = 0;
+#endif
+
   while(true)
   {
-    lora_receive();
-    while(lora_received())
+#ifdef CONFIG_TDMA
+    // Inicio de ciclo: fecha o plano com os nos ouvidos e anuncia os slots
+    if(esp_timer_get_time() >= nextBeacon)
     {
-      vPacket->RSSI = lora_packet_rssi();
-      strcpy((char *)vPacket->packetLoRa, "");
-      lora_receive_packet(vPacket->packetLoRa,sizeof(vPacket->packetLoRa));
-      printf("%s\n",(char *)vPacket->packetLoRa);
-      char *index1  = strchr((char *)vPacket->packetLoRa,'!');
-       //if(index1) printf("Index1 encontrado\n");
-      char *index2  = strchr((char *)vPacket->packetLoRa,'@');
-        //if(index2) printf("Index2 encontrado\n");
-      char *index3  = strchr((char *)vPacket->packetLoRa,'#');
-        //if(index3) printf("Index3 encontrado\n");
-      char *index4  = strchr((char *)vPacket->packetLoRa,'C');
-        //if(index4) printf("Index4 encontrado\n");
-      char *index5  = strchr((char *)vPacket->packetLoRa,'A');
-        //if(index5) printf("Index5 encontrado\n");
-      char *index6  = strchr((char *)vPacket->packetLoRa,'&');
-        //if(index6) printf("Index6 encontrado\n");
-      char *index7  = strchr((char *)vPacket->packetLoRa,'*');
-        //if(index7) printf("Index7 encontrado\n");
-      char *index8  = strchr((char *)vPacket->packetLoRa,'(');
-        //if(index8) printf("Index8 encontrado\n");
-      char *index9  = strchr((char *)vPacket->packetLoRa,')');
-        //if(index9) printf("Index9 encontrado\n");
-      char *index10 = strchr((char *)vPacket->packetLoRa,'B');
-      char *index11 = strchr((char *)vPacket->packetLoRa,'E');
-        //if(index10) printf("Index10 encontrado\n");
-        //if(index11) printf("Index11 encontrado\n");
-      
-      if (index1!=NULL && index2!=NULL && index3!=NULL && index4!=NULL && index5!=NULL && index6!=NULL
-           && index7!=NULL && index8!=NULL && index9!=NULL && index10!=NULL && index11!=NULL) 
-      {
-        //printf("Os index foram encontrados!\n");
-        char tempBuffer[20];
-
-        // Ângulo Pitch
-        strncpy(tempBuffer, (char *)vPacket->packetLoRa, index1 - (char *)vPacket->packetLoRa);
-        tempBuffer[index1 - (char *)vPacket->packetLoRa] = '\0';
-        vPacket->anglePitchDeg = atof(tempBuffer);  // Converte para float
-        
-        // Ângulo Roll
-        strncpy(tempBuffer, index1 + 1, index2 - index1 - 1);
-        tempBuffer[index2 - index1 - 1] = '\0';
-        vPacket->angleRollDeg = atof(tempBuffer);  // Converte para float
-
-        // Temperatura
-        strncpy(tempBuffer, index2 + 1, index3 - index2 - 1);
-        tempBuffer[index3 - index2 - 1] = '\0';
-        vPacket->temp = atof(tempBuffer);  // Converte para float
-
-        strncpy(tempBuffer, index3 + 1, index4 - index3 - 1);
-        tempBuffer[index4 - index3 - 1] = '\0';
-        vPacket->pressure_bmp = strtoul(tempBuffer, NULL, 10);
-
-        strncpy(vPacket->lat, index4 + 1, index5 - index4 - 1);
-        vPacket->lat[index5 - index4 - 1] = '\0';
-
-        strncpy(vPacket->lat_dir, index5 + 1, index6 - index5 - 1);
-        vPacket->lat_dir[index6 - index5 - 1] = '\0';
-
-        strncpy(vPacket->lon, index6 + 1, index7 - index6 - 1);
-        vPacket->lon[index7 - index6 - 1] = '\0';
-
-        strncpy(vPacket->lon_dir, index7 + 1, index8 - index7 - 1);
-        vPacket->lon_dir[index8 - index7 - 1] = '\0';
-
-        // Altitude
-        strncpy(tempBuffer, index8 + 1, index9 - index8 - 1);
-        tempBuffer[index9 - index8 - 1] = '\0';
-        vPacket->altitude = atof(tempBuffer);  // Converte para float
-
-        // Velocidade
-        strncpy(tempBuffer, index9 + 1, index10 - index9 - 1);
-        tempBuffer[index10 - index9 - 1] = '\0';
-        vPacket->speed = atof(tempBuffer);  // Converte para float
-
-        strncpy(tempBuffer, index10 + 1, index11 - index10 - 1);
-        tempBuffer[index11 - index10 - 1] = '\0';
-        vPacket->SNR = (uint8_t)strtoul(tempBuffer, NULL, 10);
-        
-      }//end if 
+      uint8_t beacon[TDMA_BEACON_MAX + INTEG_TRAILER];
+      tdma_plan(&Tdma);
+      size_t n = tdma_beacon_encode(&Tdma, beacon, TDMA_BEACON_MAX);
+      RadioSend(beacon, integ_append(beacon, n, sizeof(beacon)));
+      nextBeacon = esp_timer_get_time() + Tdma.cycle_us - Tdma.beacon_us;
+    }//end if
+#endif
+    notify = 0;
+#ifdef CONFIG_POWER_RX_CAD
+    if(RxDuty)
+    {
+      RxDutyCycle(&notify);
+      RadioSupervise(RADIOSUP_ANY_MODE, false);             // Modo muda a cada ciclo: so versao e bit LoRa
+    }//end if
+    else
+#endif
+    {
+      int burst = 0;
       lora_receive();
-    }//end while aninhado
-    __Delay(500);
-    //UBaseType_t uxHighWaterMark = uxTaskGetStackHighWaterMark(NULL); // obtenção de espaço livre na task em words
-    //ESP_LOGI(TAG2,"Espaço mínimo livre na stack: %u\n\n", uxHighWaterMark);
+      while(lora_received() && burst++ < RX_BURST_MAX)
+      {
+        RxRead();
+        lora_receive();
+      }//end while aninhado
+      // Logo depois do lora_receive() o chip tem que estar em RX continuo. Uma rajada sem fim e o
+      // REG_IRQ_FLAGS lido como 0xFF (SPI mudo): confere os registros na hora.
+      bool restarted = RadioSupervise(MODE_LONG_RANGE_MODE | MODE_RX_CONTINUOUS, burst > RX_BURST_MAX);
+      // Dorme ate o proximo RxDone; o timeout cobre um DIO0 desconectado (volta ao polling de 500 ms)
+      TickType_t wait = 500/portTICK_PERIOD_MS;
+#ifdef CONFIG_TDMA
+      int64_t toBeacon = nextBeacon - esp_timer_get_time();
+      if(toBeacon < 500000)
+        wait = toBeacon > 0 ? pdMS_TO_TICKS(toBeacon / 1000) : 0;
+#endif
+      if(restarted)
+        wait = 0;                                           // Volta ja para o RX
+      xTaskNotifyWait(0,UINT32_MAX,&notify,wait);
+    }//end else
+    if(notify & RX_NOTIFY_STATION)
+      station = stationNew;
+    if(notify & RX_NOTIFY_PROFILE)
+    {
+      RadioProfile = RadioProfileNew;
+      RadioApply(radio_profile(RadioProfile));
+#ifdef CONFIG_TDMA
+      tdma_set_profile(&Tdma, radio_profile(RadioProfile));
+#endif
+#ifdef CONFIG_POWER_RX_CAD
+      if(RxDuty && power_plan(radio_profile(RadioProfile), CONFIG_POWER_PREAMBLE, &PowerPlan))
+        lora_set_preamble_length(PowerPlan.preamble);
+#endif
+      xTaskNotifyGive(RadioRequester);
+    }//end if
+    if(notify & RX_NOTIFY_REGS)
+    {
+      lora_dump_registers();                                // Printf no nucleo do radio: so sob pedido
+      xTaskNotifyGive(RadioRequester);
+    }//end if
+#ifdef CONFIG_ARQ
+    RxReliableTimeout();
+#endif
+    RxWatchdog();
   }//end while
 }//end ReceiveLoraData
 
+//==================================================================================================================================================================
+//--- RxRead ---
+// O pacote fica no buffer do pool: os taps recebem o ponteiro e o RxFrame decodifica no lugar.
+static int RxRead(void)
+{
+  int64_t tRx = RxDoneTime ? RxDoneTime : esp_timer_get_time();  // Sem IRQ (DIO0 desligado) usa a hora da leitura
+  RxDoneTime = 0;
+  pkt_buf_t *pkt = pktpool_get();
+  if(pkt == NULL)
+    pkt = &RxScratch;                                       // Consumidores seguram o pool: o parse nao espera por eles
+  pkt->t_rx_us = tRx;
+  pkt->rssi    = (int16_t)lora_packet_rssi();
+  pkt->snr     = (int8_t)lora_packet_snr();
+  int len = lora_receive_packet(pkt->data,sizeof(pkt->data) - 1);
+  pkt->data[len] = '\0';
+  pkt->len = (uint16_t)len;
+  pkt->t_pre_us = radio_preamble_end_us(radio_profile(RadioProfile), (size_t)len, tRx);
+  ESP_LOGD(TAG2,"%s",(char *)pkt->data);                  // Eco bruto so em debug: printf bloquearia o nucleo do radio
+
+  if(len > 0 && pkt != &RxScratch)
+  {
+    pktpool_publish(pkt);
+    if(pktpool_tapped(PKT_TAP_CAPTURE) && TaskDataExcel)
+      xTaskNotifyGive(TaskDataExcel);
+  }//end if
+  if(len > 0)
+  {
+    link_rx_t rx = {.t_rx_us = tRx, .t_pre_us = pkt->t_pre_us, .rssi = pkt->rssi, .late = false};
+    RxFrame(pkt->data, (size_t)len, &rx);
+  }//end if
+  if(pkt != &RxScratch)
+    pktpool_put(pkt);
+  return len;
+}//end RxRead
+
+//==================================================================================================================================================================
+//--- RadioSend ---
+// O fim do TX e esperado pelo RegIrqFlags (TxDone) dentro do lora_send_packet: o DIO0 continua mapeado
+// no RxDone (0x00) ou no CadDone (0xa0) e nao sobe no TX. O carimbo do RxDone e descartado porque o
+// lora_idle do TX aborta a recepcao e o FIFO e sobrescrito: um RxDone ainda nao lido ja nao tem frame.
+// len 0 e o integ_append recusando (sem espaco ou sem chave de MAC): nada vai ao ar.
+static void RadioSend(uint8_t *buf, size_t len)
+{
+  if(len == 0)
+    return;
+  pwr_state_t prev = power_enter(PWR_TX, esp_timer_get_time());
+#ifdef CONFIG_POWER_RX_CAD
+  if(RxDuty)
+  {
+    lora_set_preamble_length(radio_profile(RadioProfile)->preamble);  // O preambulo longo e so para quem dorme
+    lora_send_packet(buf, (int)len);
+    lora_set_preamble_length(PowerPlan.preamble);
+    DioArm();                                               // Um DioWake de antes do TX pode ter desligado o pino
+  }//end if
+  else
+#endif
+    lora_send_packet(buf, (int)len);
+  RxDoneTime = 0;
+  power_enter(prev, esp_timer_get_time());
+}//end RadioSend
+
+#ifdef CONFIG_POWER_RX_CAD
+//==================================================================================================================================================================
+//--- PowerSetup ---
+static bool PowerSetup(void)
+{
+  if(!power_plan(radio_profile(RadioProfile), CONFIG_POWER_PREAMBLE, &PowerPlan))
+  {
+    ESP_LOGW(TAG2, "Preambulo de %d simbolos nao deixa tempo para dormir: RX continuo", CONFIG_POWER_PREAMBLE);
+    power_set_mode(false, false, esp_timer_get_time());
+    return false;
+  }//end if
+  lora_set_preamble_length(PowerPlan.preamble);             // No RX o registro e o maior preambulo esperado
+#ifndef CONFIG_LORA_SIM
+  gpio_set_direction(CONFIG_DIO1_GPIO,GPIO_MODE_INPUT);
+  gpio_isr_handler_add(CONFIG_DIO0_GPIO, DioWake, (void *)CONFIG_DIO0_GPIO);
+  gpio_isr_handler_add(CONFIG_DIO1_GPIO, DioWake, (void *)CONFIG_DIO1_GPIO);
+  gpio_wakeup_enable(CONFIG_DIO0_GPIO, GPIO_INTR_HIGH_LEVEL);   // Tambem troca a interrupcao do pino para nivel
+  gpio_wakeup_enable(CONFIG_DIO1_GPIO, GPIO_INTR_HIGH_LEVEL);
+  esp_sleep_enable_gpio_wakeup();
+#endif
+  // Sem DFS (min = max): so light sleep, o clock do UART do uplink nao muda
+  esp_pm_config_t pm = {
+    .max_freq_mhz       = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+    .min_freq_mhz       = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+    .light_sleep_enable = true};
+  bool light = (esp_pm_configure(&pm) == ESP_OK);
+  power_set_mode(true, light, esp_timer_get_time());
+  ESP_LOGI(TAG2, "CAD a cada %lu us, preambulo de %u simbolos (+%lu us no ar por frame)%s",
+           (unsigned long)(PowerPlan.sleep_us + PowerPlan.cad_us), PowerPlan.preamble,
+           (unsigned long)PowerPlan.extra_air_us, light ? "" : ", sem light sleep");
+  return true;
+}//end PowerSetup
+
+//==================================================================================================================================================================
+//--- RxDutyCycle ---
+// Um ciclo do modo CAD. Quem decide sao os flags do radio: as notificacoes do DIO0/DIO1 so acordam
+// a task, e os prazos cobrem um DIO desconectado.
+static void RxDutyCycle(uint32_t *notify)
+{
+  const radio_profile_t *prof = radio_profile(RadioProfile);
+  int64_t deadline;
+  int     cad;
+
+  // Radio em sleep; com a task bloqueada o tickless idle poe o ESP32 em light sleep
+  lora_sleep();
+  power_enter(PWR_SLEEP, esp_timer_get_time());
+  uint32_t got = 0;
+  xTaskNotifyWait(0,UINT32_MAX,&got,pdMS_TO_TICKS(PowerPlan.sleep_us / 1000));  // Arredonda para baixo: acordar cedo e seguro
+  *notify |= got;
+
+  lora_cad();
+  power_enter(PWR_CAD, esp_timer_get_time());
+  deadline = esp_timer_get_time() + 2 * PowerPlan.cad_us;
+  while((cad = lora_cad_result()) < 0 && esp_timer_get_time() < deadline)
+    RxWaitUntil(deadline, notify);
+  RxDoneTime = 0;                                           // O DIO0 era o CadDone
+  DioArm();
+  power_cad(cad > 0);
+  if(cad <= 0)
+    return;
+
+  // Preambulo no ar: janela unica, o radio volta sozinho para standby
+  lora_receive_single(PowerPlan.rx_timeout_sym);
+  power_enter(PWR_RX, esp_timer_get_time());
+  deadline = esp_timer_get_time() + (int64_t)PowerPlan.rx_timeout_sym * radio_symbol_us(prof) + radio_airtime_us(prof, 255);
+  while(true)
+  {
+    if(lora_received())
+    {
+      if(RxRead() <= 0)
+        power_cad_false();                                  // Erro de CRC
+      break;
+    }//end if
+    if(lora_rx_timeout() || esp_timer_get_time() >= deadline)
+    {
+      power_cad_false();
+      break;
+    }//end if
+    RxWaitUntil(deadline, notify);
+  }//end while
+  DioArm();
+}//end RxDutyCycle
+
+//==================================================================================================================================================================
+//--- RxWaitUntil ---
+// Bloqueia ate o prazo ou ate a proxima notificacao, acumulando os bits em *notify
+static void RxWaitUntil(int64_t deadline, uint32_t *notify)
+{
+  uint32_t got  = 0;
+  int64_t  left = deadline - esp_timer_get_time();
+
+  if(left <= 0)
+    return;
+  xTaskNotifyWait(0,UINT32_MAX,&got,pdMS_TO_TICKS(left / 1000) + 1);
+  *notify |= got;
+}//end RxWaitUntil
+
+//==================================================================================================================================================================
+//--- DioArm ---
+static void DioArm(void)
+{
+#ifndef CONFIG_LORA_SIM
+  gpio_intr_enable(CONFIG_DIO0_GPIO);
+  gpio_intr_enable(CONFIG_DIO1_GPIO);
+#endif
+}//end DioArm
+#endif
+
+//==================================================================================================================================================================
+//--- RxFrame ---
+// Confere o trailer de integridade antes de tudo, separa o cabecalho de enlace e despacha pelo
+// endereco do no (indice direto na tabela).
+// rx->late = frame refeito pela paridade FEC: nao volta para o acumulador do grupo, e o RSSI e os
+// instantes sao os da paridade (o frame original nunca foi ouvido).
+static void RxFrame(const uint8_t *buf, size_t len, const link_rx_t *rx)
+{
+  link_frame_t       f;
+  node_state_t      *node;
+  telemetry_sample_t s;
+  size_t             body = integ_check(buf, len);         // A FEC usa o frame inteiro, trailer incluido
+
+  if(body == 0 || !link_decode(buf, body, &f) || (node = node_get(f.node)) == NULL)
+    return;
+  switch(f.type)
+  {
+    case LINK_T_ASCII:
+    case LINK_T_KEY:
+    case LINK_T_DELTA:
+      // So telemetria conta como pacote do no: beacon/ACK de outro receptor nao alimentam o alarme de
+      // enlace, o criterio de silencio do radiosup nem o marco de primeiro pacote
+      if(!rx->late)                                         // O refeito pela FEC chegou junto com a paridade
+        node_period(node, rx->t_rx_us);
+      if(RxLastUs == 0)
+        instr_boot(INSTR_BOOT_PACKET);
+      RxLastUs     = rx->t_rx_us;
+      node_rx(node, &f, rx->rssi, rx->t_rx_us);
+#ifdef CONFIG_TDMA
+      tdma_heard(&Tdma, f.node);
+#endif
+#ifdef CONFIG_ARQ
+      if(f.type == LINK_T_ASCII && (f.flags & LINK_F_REL))
+      {
+        RxReliable(node, &f, rx);
+        break;
+      }//end if
+#endif
+#ifdef CONFIG_FEC
+      if(f.has_hdr && !rx->late)
+        fec_data(&node->fec, f.seq, buf, len);
+#endif
+      if(f.type == LINK_T_ASCII)
+        RxPayload(node, f.node, f.payload, f.plen, rx);
+      else if(delta_decode(&node->delta, &f, &s))
+        RxSample(node, f.node, &s, rx);
+      else
+        node->bad++;
+      break;
+#ifdef CONFIG_FEC
+    case LINK_T_PARITY:
+    {
+      // Paridade do grupo: refaz o unico frame que faltou, sem retransmissao
+      uint8_t frame[FEC_FRAME_MAX];
+      uint8_t seq;
+      size_t  n = fec_parity(&node->fec, f.seq, f.payload, f.plen, frame, &seq);
+      if(n && !rx->late)
+      {
+        link_rx_t lrx = *rx;
+        lrx.late = true;
+        RxFrame(frame, n, &lrx);
+      }//end if
+      break;
+    }
+#endif
+    case LINK_T_TIME:
+      node_rx(node, &f, rx->rssi, rx->t_rx_us);
+      if(!timesync_update(&node->sync, f.payload, f.plen, rx->t_pre_us))
+        node->bad++;
+      break;
+    default:
+      break;                                                // Beacon/ACK de outro receptor
+  }//end switch
+}//end RxFrame
+
+//==================================================================================================================================================================
+//--- RxWatchdog ---
+// Roda a cada volta do laco do radio (no maximo 500 ms sem RxDone). So nos ja ouvidos entram.
+static void RxWatchdog(void)
+{
+  int64_t now   = esp_timer_get_time();
+  bool    fired = false;
+
+  for(uint8_t id = 0; id < NODE_MAX; id++)
+  {
+    node_state_t *node = node_get(id);
+    if(node->rx)
+      fired |= alarm_link(&node->alarm, id, now - node->tlm_us, node->period_us, now);
+  }//end for
+  if(fired && TaskDataExcel)
+    xTaskNotifyGive(TaskDataExcel);
+}//end RxWatchdog
+
+//==================================================================================================================================================================
+//--- RadioSupervise ---
+// 'expect' e o REG_OP_MODE esperado neste ponto do laco; 'force' le os registros fora do periodo.
+static bool RadioSupervise(int expect, bool force)
+{
+  int64_t           now = esp_timer_get_time();
+  radiosup_reason_t why = RADIOSUP_OK;
+
+  if(radiosup_due(now) || force)
+    why = radiosup_regs(lora_version(), lora_op_mode(), expect);
+  if(why == RADIOSUP_OK)
+    why = radiosup_silence(RxLastUs, now);
+  if(why == RADIOSUP_OK)
+    return false;
+  RadioRecover(why, now);
+  return true;
+}//end RadioSupervise
+
+//==================================================================================================================================================================
+//--- RadioRecover ---
+// Reset pelo pino RST (~5 ms) e a configuracao guardada: perfil, preambulo do plano CAD e DIOs.
+// Nao mexe no SPI, na ISR nem no estado dos nos; o laco volta ao RX na mesma volta.
+static void RadioRecover(radiosup_reason_t why, int64_t t0)
+{
+  bool ok = lora_restart() != 0;
+
+  if(ok)
+  {
+    RadioConfig();
+#ifdef CONFIG_POWER_RX_CAD
+    if(RxDuty)
+    {
+      lora_set_preamble_length(PowerPlan.preamble);
+      DioArm();                                             // O nivel do DIO pode ter ficado alto com o chip travado
+    }//end if
+#endif
+  }//end if
+  RxDoneTime = 0;
+  int64_t t1 = esp_timer_get_time();
+  if(!radiosup_recovered(why, ok, t0, t1))
+    return;
+  if(ok)
+    ESP_LOGW(TAG2, "Radio reiniciado (%s) em %lu us", radiosup_reason_name(why), (unsigned long)(t1 - t0));
+  else
+    ESP_LOGE(TAG2, "Radio nao responde (%s), nova tentativa em %d ms", radiosup_reason_name(why), RADIOSUP_CHECK_MS);
+}//end RadioRecover
+
+//==================================================================================================================================================================
+//--- RxPayload ---
+static void RxPayload(node_state_t *node, uint8_t id, const uint8_t *p, size_t len, const link_rx_t *rx)
+{
+  telemetry_sample_t s;
+
+  if(!telemetry_parse((const char *)p, len, &s))
+  {
+    node->bad++;
+    return;
+  }//end if
+  RxSample(node, id, &s, rx);
+}//end RxPayload
+
+//==================================================================================================================================================================
+//--- RxSample ---
+// Decodifica uma unica vez aqui; Menu e Excel so leem a amostra ja convertida. O instante da medida
+// vem do relogio do transmissor quando ha sincronismo; senao e o fim do preambulo, o mais perto da
+// medida que o receptor ve. Frames seguros pelo ARQ trazem os instantes do proprio RxDone; os refeitos
+// pela FEC, os da paridade. Os dois saem com TELEM_FLAG_LATE e nao mexem nos filtros do metrics.
+static void RxSample(node_state_t *node, uint8_t id, telemetry_sample_t *sp, const link_rx_t *rx)
+{
+  telemetry_sample_t s = *sp;
+
+  s.node        = id;
+  s.rssi        = rx->rssi;
+  s.t_rx_us     = rx->t_rx_us;
+  s.t_sample_us = rx->t_pre_us;
+  s.t_parse_us  = esp_timer_get_time();
+  if(rx->late)
+    s.flags |= TELEM_FLAG_LATE;
+  else
+    instr_latency(INSTR_LAT_RX_PARSE, s.t_parse_us - s.t_rx_us);
+  if((s.flags & TELEM_FLAG_TTX) && timesync_map(&node->sync, s.t_tx_us, &s.t_sample_us))
+  {
+    s.flags |= TELEM_FLAG_TSYNC;
+    if(!rx->late)
+      instr_latency(INSTR_LAT_TX_PARSE, s.t_parse_us - s.t_sample_us);
+  }//end if
+  geo_update(&station, &s);
+  metrics_update(&node->metrics, &s);
+  alarm_eval(&node->alarm, &s);
+  node->last     = s;
+  node->ring_idx = sample_ring_push(&SampleRing, &s);     // LCD e uplink leem daqui, no outro nucleo
+  if(TaskDataExcel)                                         // O handle estatico so existe depois do retorno do xTaskCreateStatic
+    xTaskNotifyGive(TaskDataExcel);
+}//end RxSample
+
+#ifdef CONFIG_ARQ
+//==================================================================================================================================================================
+//--- RxReliable ---
+// Guarda o frame na janela de reordenacao, libera o que ficou em ordem e responde com o ACK seletivo
+// ainda dentro da janela de virada do transmissor (ele abre RX logo apos o TxDone). So o que foi
+// guardado ou ja tinha sido recebido e confirmado: um frame descartado sem ACK volta a ser enviado.
+static void RxReliable(node_state_t *node, const link_frame_t *f, const link_rx_t *rx)
+{
+  static uint8_t frame[ARQ_FRAME_MAX];
+  uint8_t   ack[ARQ_ACK_LEN + INTEG_TRAILER];
+  size_t    len;
+  link_rx_t held;
+  int64_t   now = esp_timer_get_time();
+
+  int r = arq_rx(&node->arq, f->seq, f->payload, f->plen, rx, now);
+  if(r == ARQ_FAR)
+  {
+    while(arq_pop(&node->arq, frame, &len, &held, now, true))
+    {
+      held.late = true;
+      RxPayload(node, f->node, frame, len, &held);
+    }//end while
+    r = arq_rx(&node->arq, f->seq, f->payload, f->plen, rx, now);
+  }//end if
+  while(arq_pop(&node->arq, frame, &len, &held, now, false))
+  {
+    held.late |= held.t_rx_us != rx->t_rx_us;               // Preso atras de uma lacuna
+    RxPayload(node, f->node, frame, len, &held);
+  }//end while
+  if(r != ARQ_NEW && r != ARQ_DUP)
+    return;
+
+  len = arq_ack_encode(&node->arq, f->node, ack, ARQ_ACK_LEN);
+  RadioSend(ack, integ_append(ack, len, sizeof(ack)));
+}//end RxReliable
+
+//==================================================================================================================================================================
+//--- RxReliableTimeout ---
+static void RxReliableTimeout(void)
+{
+  static uint8_t frame[ARQ_FRAME_MAX];
+  size_t    len;
+  link_rx_t held;
+  int64_t   now = esp_timer_get_time();
+
+  for(uint8_t id = 0; id < NODE_MAX; id++)
+  {
+    node_state_t *node = node_get(id);
+    while(arq_pop(&node->arq, frame, &len, &held, now, false))
+    {
+      held.late = true;
+      RxPayload(node, id, frame, len, &held);
+    }//end while
+  }//end for
+}//end RxReliableTimeout
+#endif
+
 //==================================================================================================================================================================
 //--- End of Program --
@@ -0,0 +1,194 @@
+//=======================================================================================================
+//
+//   Title: Streaming flight metrics (vertical speed, apogee, landing, smoothed attitude).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include "metrics.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define WIN_MASK  (METRICS_WIN - 1)
+#define WIN_MS    (METRICS_WIN_US / 1000)
+#define STEP_MS   ((WIN_MS + METRICS_WIN - 2) / (METRICS_WIN - 1))  // Espaco minimo entre pontos guardados
+#define AB_H      (METRICS_AB_G * METRICS_AB_G / (2.0f - METRICS_AB_G))   // Benedict-Bordner
+
+static const char *PhaseName[METRICS_PHASE_COUNT] = {"solo", "subida", "descida", "pouso"};
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static void  Restart(metrics_t *m, const telemetry_sample_t *s);
+static void  DequePush(metrics_deque_t *d, float v, uint32_t t_ms, bool max);
+static void  DequeExpire(metrics_deque_t *d, uint32_t t_ms);
+static bool  DequeEmpty(const metrics_deque_t *d);
+static const metrics_point_t *DequeFront(const metrics_deque_t *d);
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- metrics_update ---
+// Amostra atrasada (TELEM_FLAG_LATE: refeita pela FEC, liberada pelo ARQ), com o mesmo instante da
+// anterior ou pouco fora de ordem nao mexe no filtro nem nas janelas: so recebe o estado atual.
+void metrics_update(metrics_t *m, telemetry_sample_t *s)
+{
+  int64_t t     = s->t_sample_us;
+  int64_t dt    = t - m->t_us;
+  bool    late  = m->valid && (s->flags & TELEM_FLAG_LATE);
+  bool    fresh = !late && (!m->valid || dt > METRICS_GAP_US || dt < -METRICS_GAP_US);
+
+  if(late)
+    dt = 0;
+
+  if(fresh)
+    Restart(m, s);
+  else if(dt > 0)
+  {
+    float dts  = (float)dt * 1e-6f;
+    float pred = m->alt + m->vz * dts;
+    float r    = s->altitude - pred;
+    m->alt  = pred + METRICS_AB_G * r;
+    m->vz  += AB_H * r / dts;
+    float a = dts / (METRICS_TAU_US * 1e-6f + dts);
+    m->pitch += a * (s->anglePitchDeg - m->pitch);
+    m->roll  += a * (s->angleRollDeg - m->roll);
+  }//end else if
+  if(fresh || dt > 0)
+  {
+    uint32_t t_ms = (uint32_t)(t / 1000);
+    m->t_us = t;
+    DequePush(&m->lo, m->alt, t_ms, false);
+    DequePush(&m->hi, m->alt, t_ms, true);
+    DequeExpire(&m->lo, t_ms);
+    DequeExpire(&m->hi, t_ms);
+    if(m->alt > m->alt_max)
+    {
+      m->alt_max  = m->alt;
+      m->t_max_us = t;
+    }//end if
+
+    const metrics_point_t *lo = DequeFront(&m->lo);
+    switch(m->phase)
+    {
+      case METRICS_PAD:
+      case METRICS_LANDED:
+        if(m->alt - lo->v < METRICS_LAND_BAND)
+          m->t_rest_us = t;                   // Ainda parado: o lancamento e depois daqui
+        if(m->vz > METRICS_LAUNCH_VZ || m->alt - lo->v > METRICS_LAUNCH_RISE)
+        {
+          m->phase       = METRICS_ASCENT;
+          m->t_launch_us = m->t_rest_us;
+          m->alt_max     = m->alt;
+          m->t_max_us    = t;
+          s->flags      |= TELEM_FLAG_LAUNCH;
+        }//end if
+        break;
+      case METRICS_ASCENT:
+        if(m->vz < 0.0f && m->alt < m->alt_max - METRICS_APOGEE_DROP)
+        {
+          m->phase  = METRICS_DESCENT;
+          s->flags |= TELEM_FLAG_APOGEE;
+        }//end if
+        break;
+      case METRICS_DESCENT:
+        if(t - m->t_start_us >= METRICS_WIN_US && DequeFront(&m->hi)->v - lo->v < METRICS_LAND_BAND)
+        {
+          m->phase  = METRICS_LANDED;
+          s->flags |= TELEM_FLAG_LANDED;
+        }//end if
+        break;
+    }//end switch
+  }//end if
+
+  s->vspeed    = m->vz;
+  s->alt_max   = m->alt_max;
+  s->apogee_s  = m->phase >= METRICS_DESCENT ? (float)(m->t_max_us - m->t_launch_us) * 1e-6f : 0.0f;
+  s->pitch_avg = m->pitch;
+  s->roll_avg  = m->roll;
+  s->phase     = m->phase;
+}//end metrics_update
+
+//=======================================================================================================
+//--- metrics_phase_name ---
+const char *metrics_phase_name(uint8_t phase)
+{
+  return phase < METRICS_PHASE_COUNT ? PhaseName[phase] : "?";
+}//end metrics_phase_name
+
+//=======================================================================================================
+//--- Restart ---
+// Primeira amostra ou volta de uma lacuna: a altitude recomeca da medida e as janelas esvaziam. Fase,
+// maximo e velocidade continuam (um voo nao acaba porque o enlace caiu alguns segundos).
+static void Restart(metrics_t *m, const telemetry_sample_t *s)
+{
+  if(!m->valid)
+  {
+    memset(m, 0, sizeof(*m));
+    m->alt_max  = s->altitude;
+    m->t_max_us = s->t_sample_us;
+    m->valid    = true;
+  }//end if
+  m->alt        = s->altitude;
+  m->pitch      = s->anglePitchDeg;
+  m->roll       = s->angleRollDeg;
+  m->t_start_us = s->t_sample_us;
+  m->lo.head    = m->lo.tail = 0;
+  m->hi.head    = m->hi.tail = 0;
+}//end Restart
+
+//=======================================================================================================
+//--- DequePush ---
+// Deque monotonico: descarta do fim os pontos que nunca mais serao o extremo da janela. Dizimado: um
+// ponto a menos de STEP_MS do ultimo guardado (que e mais extremo) nao entra, entao a janela inteira
+// cabe em METRICS_WIN pontos a qualquer taxa e o extremo nunca e empurrado para fora; o custo e o
+// extremo sair da janela ate STEP_MS (~97 ms) antes da hora. Cheio, so sobra para tirar um ponto que
+// o DequeExpire tiraria em seguida.
+static void DequePush(metrics_deque_t *d, float v, uint32_t t_ms, bool max)
+{
+  while(!DequeEmpty(d))
+  {
+    const metrics_point_t *back = &d->p[(uint8_t)(d->tail - 1) & WIN_MASK];
+    if(max ? back->v > v : back->v < v)
+    {
+      if((int32_t)(t_ms - back->t_ms) < STEP_MS)
+        return;
+      break;
+    }//end if
+    d->tail--;
+  }//end while
+  if((uint8_t)(d->tail - d->head) == METRICS_WIN)
+    d->head++;
+  d->p[d->tail & WIN_MASK] = (metrics_point_t){v, t_ms};
+  d->tail++;
+}//end DequePush
+
+//=======================================================================================================
+//--- DequeExpire ---
+// O ultimo ponto guardado esta a menos de STEP_MS da amostra atual, entao a frente sempre existe.
+static void DequeExpire(metrics_deque_t *d, uint32_t t_ms)
+{
+  while((int32_t)(t_ms - DequeFront(d)->t_ms) > WIN_MS)
+    d->head++;
+}//end DequeExpire
+
+//=======================================================================================================
+//--- DequeEmpty ---
+static bool DequeEmpty(const metrics_deque_t *d)
+{
+  return d->head == d->tail;
+}//end DequeEmpty
+
+//=======================================================================================================
+//--- DequeFront ---
+static const metrics_point_t *DequeFront(const metrics_deque_t *d)
+{
+  return &d->p[d->head & WIN_MASK];
+}//end DequeFront
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,91 @@
+//=======================================================================================================
+//
+//   Title: Streaming flight metrics (vertical speed, apogee, landing, smoothed attitude).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Estado por no, atualizado no ReceiveLoraData a cada amostra em O(1), sem alocacao:
+//     - Velocidade vertical por um filtro alfa-beta sobre a altitude (Kalman de regime para
+//       velocidade constante); o dt vem de t_sample_us, entao amostras perdidas nao distorcem a
+//       derivada como uma diferenca finita faria.
+//     - Min/max da altitude filtrada numa janela deslizante de METRICS_WIN_US, com deques monotonicos
+//       (cada amostra entra e sai no maximo uma vez de cada deque) dizimados a um ponto a cada
+//       METRICS_WIN_US / (METRICS_WIN - 1): o tamanho nao depende da taxa do transmissor.
+//     - Media exponencial (EWMA) de pitch/roll com constante de tempo METRICS_TAU_US.
+//     - Fases solo -> subida -> descida -> pouso. Lancamento: vz acima de METRICS_LAUNCH_VZ ou subida
+//       de METRICS_LAUNCH_RISE sobre o minimo da janela. Apogeu: vz < 0 e METRICS_APOGEE_DROP abaixo
+//       do maximo. Pouso: variacao da janela inteira abaixo de METRICS_LAND_BAND. Um lancamento
+//       detectado depois do pouso comeca um voo novo.
+//   A amostra recebe os resultados (vspeed, alt_max, apogee_s, pitch/roll_avg, phase) e o flag do
+//   evento no instante em que ele e detectado (TELEM_FLAG_LAUNCH/APOGEE/LANDED).
+//=======================================================================================================
+
+#ifndef METRICS_h
+#define METRICS_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include "telemetry.h"
+
+//=======================================================================================================
+//--- Macros and Constants ---
+#define METRICS_WIN          32               // Entradas por deque (potencia de 2, <= 128); define o passo da dizimacao
+#define METRICS_WIN_US       3000000          // Janela de min/max
+#define METRICS_GAP_US       2000000          // Lacuna maior que isso reinicia o filtro e a janela
+#define METRICS_AB_G         0.3f             // Ganho de posicao do alfa-beta (o de velocidade e derivado)
+#define METRICS_TAU_US       1000000          // Constante de tempo da media de pitch/roll
+#define METRICS_LAUNCH_VZ    10.0f            // m/s
+#define METRICS_LAUNCH_RISE  20.0f            // m
+#define METRICS_APOGEE_DROP  5.0f             // m
+#define METRICS_LAND_BAND    2.0f             // m
+
+_Static_assert((METRICS_WIN & (METRICS_WIN - 1)) == 0 && METRICS_WIN <= 128, "METRICS_WIN potencia de 2 ate 128");
+
+//=======================================================================================================
+//--- Types ---
+
+typedef enum{
+    METRICS_PAD = 0,                          // Esperando o lancamento
+    METRICS_ASCENT,
+    METRICS_DESCENT,                          // Depois do apogeu
+    METRICS_LANDED,
+    METRICS_PHASE_COUNT
+}metrics_phase_t;
+
+typedef struct{
+    float    v;
+    uint32_t t_ms;                            // t_sample_us / 1000 (diferencas com sinal atravessam a volta)
+}metrics_point_t;
+
+typedef struct{
+    metrics_point_t p[METRICS_WIN];
+    uint8_t         head;                     // Frente (mais antigo)
+    uint8_t         tail;                     // Proxima posicao livre
+}metrics_deque_t;
+
+typedef struct{
+    bool            valid;                    // Zerado (nodes_reset) = sem amostra ainda
+    uint8_t         phase;                    // metrics_phase_t
+    int64_t         t_us;                     // Ultima amostra usada
+    int64_t         t_start_us;               // Inicio da janela continua (sem lacuna)
+    int64_t         t_rest_us;                // Ultima amostra parada (dentro de METRICS_LAND_BAND do minimo)
+    int64_t         t_launch_us;
+    int64_t         t_max_us;
+    float           alt;                      // Altitude filtrada
+    float           vz;                       // Velocidade vertical filtrada (m/s, + para cima)
+    float           alt_max;
+    float           pitch, roll;              // EWMA
+    metrics_deque_t lo, hi;                   // Minimo e maximo da janela
+}metrics_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void        metrics_update(metrics_t *m, telemetry_sample_t *s);  // Atualiza o estado e preenche a amostra
+const char *metrics_phase_name(uint8_t phase);
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,695 @@
+//=======================================================================================================
+//
+//   Title: Network uplink fan-out (UDP batches, TCP and WebSocket streams).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include <strings.h>
+#include <stdio.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "netout.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define RING_BYTES   (NET_RING_RECS * NET_REC_SIZE)
+#define WS_REQ_MAX   512
+#define WS_GUID      "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0                        // lwIP nao gera SIGPIPE
+#endif
+#define SEND_FLAGS   (MSG_DONTWAIT | MSG_NOSIGNAL)
+
+//=======================================================================================================
+//--- Types ---
+typedef enum{
+    CLI_FREE = 0,
+    CLI_HANDSHAKE,                            // WebSocket esperando o pedido HTTP
+    CLI_STREAM
+}cli_state_t;
+
+typedef struct{
+    int         fd;
+    cli_state_t state;
+    bool        ws;
+    uint32_t    cursor;                       // Proximo byte do anel (contador absoluto, como Head)
+    uint8_t     pend[NET_REC_SIZE];           // Resto de um registro que o anel ia sobrescrever
+    uint8_t     pend_len, pend_off;
+    uint8_t     hdr[4];                       // Cabecalho do frame WebSocket em envio
+    uint8_t     hdr_len, hdr_off;
+    uint32_t    frame_left;                   // Payload que falta no frame WebSocket atual
+    uint16_t    req_len;
+    char        req[WS_REQ_MAX];
+}client_t;
+
+//=======================================================================================================
+//--- Variaveis ---
+static uint8_t            Ring[RING_BYTES];
+static uint32_t           Head;                             // Bytes escritos (multiplo de NET_REC_SIZE)
+static uint32_t           Rec;
+static client_t           Client[NET_MAX_CLIENTS];
+static int                ListenTcp = -1, ListenWs = -1, Udp = -1;
+static struct sockaddr_in UdpDest;
+static uint32_t           UdpCursor;
+static int64_t            UdpOldestUs;
+static int64_t            BatchUs;
+static bool               Running;
+static net_stats_t        Stats;
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static int      Listen(uint16_t port, int sndbuf);
+static void     NonBlocking(int fd);
+static void     Accept(int lfd, bool ws);
+static void     Close(client_t *c);
+static void     Overrun(client_t *c, uint32_t limit);
+static void     ClientRead(client_t *c);
+static void     ClientSend(client_t *c);
+static void     UdpSend(int64_t now_us);
+static bool     WsAccept(client_t *c);
+static void     Sha1(const uint8_t *msg, size_t len, uint8_t out[20]);
+static void     Base64(const uint8_t *in, size_t len, char *out);
+static void     Put16(uint8_t *p, uint16_t v);
+static void     Put32(uint8_t *p, uint32_t v);
+static uint32_t Get32(const uint8_t *p);
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- netout_start ---
+int netout_start(const net_config_t *cfg)
+{
+  memset(&Stats, 0, sizeof(Stats));
+  for(int i = 0; i < NET_MAX_CLIENTS; i++)
+    Client[i].state = CLI_FREE;
+  Head = UdpCursor = Rec = 0;
+  BatchUs = (int64_t)cfg->batch_ms * 1000;
+
+  if(cfg->tcp_port && (ListenTcp = Listen(cfg->tcp_port, cfg->sndbuf)) < 0)
+    goto fail;
+  if(cfg->ws_port && (ListenWs = Listen(cfg->ws_port, cfg->sndbuf)) < 0)
+    goto fail;
+  if(cfg->udp_dest && cfg->udp_dest[0])
+  {
+    memset(&UdpDest, 0, sizeof(UdpDest));
+    UdpDest.sin_family = AF_INET;
+    UdpDest.sin_port   = htons(cfg->udp_port);
+    if(inet_pton(AF_INET, cfg->udp_dest, &UdpDest.sin_addr) != 1)
+    {
+      errno = EINVAL;
+      goto fail;
+    }//end if
+    if((Udp = socket(AF_INET, SOCK_DGRAM, 0)) < 0)
+      goto fail;
+    int     on  = 1;
+    uint8_t ttl = 1;                                        // Multicast so na rede local
+    setsockopt(Udp, SOL_SOCKET, SO_BROADCAST, &on, sizeof(on));
+    if((ntohl(UdpDest.sin_addr.s_addr) >> 28) == 14)
+      setsockopt(Udp, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    NonBlocking(Udp);
+  }//end if
+  Running = true;
+  return 0;
+
+fail:;
+  int err = errno;
+  netout_stop();
+  return -err;
+}//end netout_start
+
+//=======================================================================================================
+//--- netout_stop ---
+void netout_stop(void)
+{
+  for(int i = 0; i < NET_MAX_CLIENTS; i++)
+  {
+    if(Client[i].state != CLI_FREE)
+      Close(&Client[i]);
+  }//end for
+  if(ListenTcp >= 0)
+    close(ListenTcp);
+  if(ListenWs >= 0)
+    close(ListenWs);
+  if(Udp >= 0)
+    close(Udp);
+  ListenTcp = ListenWs = Udp = -1;
+  Running = false;
+}//end netout_stop
+
+//=======================================================================================================
+//--- netout_push ---
+// Antes de escrever, quem ainda nao enviou o slot que vai ser sobrescrito perde o atraso. As
+// comparacoes sao pela diferenca com sinal, como no SampleRing, entao o contador pode dar a volta.
+void netout_push(const telemetry_sample_t *s, int64_t now_us)
+{
+  uint32_t limit = Head + NET_REC_SIZE - RING_BYTES;        // Primeiro byte valido depois da escrita
+
+  if(!Running)
+    return;
+  for(int i = 0; i < NET_MAX_CLIENTS; i++)
+  {
+    if(Client[i].state == CLI_STREAM)
+      Overrun(&Client[i], limit);
+  }//end for
+  if((int32_t)(limit - UdpCursor) > 0)
+  {
+    Stats.udp_dropped += (limit - UdpCursor) / NET_REC_SIZE;
+    UdpCursor = limit;
+  }//end if
+  if(UdpCursor == Head)
+    UdpOldestUs = now_us;
+  netout_encode(s, Rec++, &Ring[Head % RING_BYTES]);
+  Head += NET_REC_SIZE;
+  Stats.records++;
+}//end netout_push
+
+//=======================================================================================================
+//--- netout_poll ---
+void netout_poll(int timeout_ms, int64_t now_us)
+{
+  fd_set         rd;
+  struct timeval tv = {timeout_ms / 1000, (timeout_ms % 1000) * 1000};
+  int            maxfd = -1;
+
+  if(!Running)
+    return;
+  for(int i = 0; i < NET_MAX_CLIENTS; i++)
+    ClientSend(&Client[i]);
+  UdpSend(now_us);
+
+  // Escrita pendente nao entra no select: o proximo poll tenta de novo (send nao bloqueante)
+  FD_ZERO(&rd);
+  if(ListenTcp >= 0)
+    FD_SET(ListenTcp, &rd);
+  if(ListenWs >= 0)
+    FD_SET(ListenWs, &rd);
+  if(Udp >= 0)
+    FD_SET(Udp, &rd);                                       // Nunca recebe: so faz o select esperar
+  maxfd = ListenTcp > ListenWs ? ListenTcp : ListenWs;
+  maxfd = Udp > maxfd ? Udp : maxfd;
+  for(int i = 0; i < NET_MAX_CLIENTS; i++)
+  {
+    if(Client[i].state == CLI_FREE)
+      continue;
+    FD_SET(Client[i].fd, &rd);
+    if(Client[i].fd > maxfd)
+      maxfd = Client[i].fd;
+  }//end for
+  if(maxfd < 0)
+    return;
+  if(select(maxfd + 1, &rd, NULL, NULL, &tv) <= 0)
+    return;
+
+  if(ListenTcp >= 0 && FD_ISSET(ListenTcp, &rd))
+    Accept(ListenTcp, false);
+  if(ListenWs >= 0 && FD_ISSET(ListenWs, &rd))
+    Accept(ListenWs, true);
+  for(int i = 0; i < NET_MAX_CLIENTS; i++)
+  {
+    if(Client[i].state != CLI_FREE && FD_ISSET(Client[i].fd, &rd))
+      ClientRead(&Client[i]);
+  }//end for
+}//end netout_poll
+
+//=======================================================================================================
+//--- netout_get ---
+void netout_get(net_stats_t *out)
+{
+  *out = Stats;
+  out->clients = 0;
+  for(int i = 0; i < NET_MAX_CLIENTS; i++)
+  {
+    if(Client[i].state == CLI_STREAM)
+      out->clients++;
+  }//end for
+}//end netout_get
+
+//=======================================================================================================
+//--- netout_encode ---
+size_t netout_encode(const telemetry_sample_t *s, uint32_t rec, uint8_t *out)
+{
+  const float f[] = {s->anglePitchDeg, s->angleRollDeg, s->temp};
+  const float g[] = {s->altitude, s->speed, s->range_m, s->bearing_deg, s->elevation_deg};
+  uint32_t    u;
+
+  memset(out, 0, NET_REC_SIZE);
+  Put32(&out[0], rec);
+  int64_t     air = (s->t_rx_us - s->t_sample_us) / 1000;
+
+  Put32(&out[4], (uint32_t)(s->t_sample_us / 1000));
+  out[8]  = s->node;
+  out[9]  = (uint8_t)s->flags;                            // So os 8 primeiros flags vao no registro
+  out[10] = s->SNR;
+  Put16(&out[12], (uint16_t)s->rssi);
+  Put16(&out[14], (uint16_t)(air < 0 ? 0 : (air > 0xFFFF ? 0xFFFF : air)));
+  for(int i = 0; i < 3; i++)
+  {
+    memcpy(&u, &f[i], 4);
+    Put32(&out[16 + 4 * i], u);
+  }//end for
+  Put32(&out[28], s->pressure_bmp);
+  Put32(&out[32], (uint32_t)s->lat_e7);
+  Put32(&out[36], (uint32_t)s->lon_e7);
+  for(int i = 0; i < 5; i++)
+  {
+    memcpy(&u, &g[i], 4);
+    Put32(&out[40 + 4 * i], u);
+  }//end for
+  Put32(&out[60], (uint32_t)(s->t_parse_us - s->t_rx_us));
+  return NET_REC_SIZE;
+}//end netout_encode
+
+//=======================================================================================================
+//--- netout_decode ---
+bool netout_decode(const uint8_t *in, uint32_t *rec, telemetry_sample_t *out)
+{
+  float   *f[] = {&out->anglePitchDeg, &out->angleRollDeg, &out->temp};
+  float   *g[] = {&out->altitude, &out->speed, &out->range_m, &out->bearing_deg, &out->elevation_deg};
+  uint32_t u;
+
+  if(in[11])
+    return false;                                           // Reservado sempre zero
+  memset(out, 0, sizeof(*out));
+  *rec             = Get32(&in[0]);
+  out->t_sample_us = (int64_t)Get32(&in[4]) * 1000;
+  out->t_rx_us     = out->t_sample_us + (int64_t)(in[14] | in[15] << 8) * 1000;
+  out->node     = in[8];
+  out->flags    = in[9];
+  out->SNR      = in[10];
+  out->rssi     = (int16_t)(in[12] | in[13] << 8);
+  for(int i = 0; i < 3; i++)
+  {
+    u = Get32(&in[16 + 4 * i]);
+    memcpy(f[i], &u, 4);
+  }//end for
+  out->pressure_bmp = Get32(&in[28]);
+  out->lat_e7       = (int32_t)Get32(&in[32]);
+  out->lon_e7       = (int32_t)Get32(&in[36]);
+  for(int i = 0; i < 5; i++)
+  {
+    u = Get32(&in[40 + 4 * i]);
+    memcpy(g[i], &u, 4);
+  }//end for
+  out->t_parse_us = out->t_rx_us + Get32(&in[60]);
+  return true;
+}//end netout_decode
+
+//=======================================================================================================
+//--- Listen ---
+static int Listen(uint16_t port, int sndbuf)
+{
+  struct sockaddr_in a = {0};
+  int                on = 1;
+  int                fd = socket(AF_INET, SOCK_STREAM, 0);
+
+  if(fd < 0)
+    return -1;
+  a.sin_family      = AF_INET;
+  a.sin_port        = htons(port);
+  a.sin_addr.s_addr = htonl(INADDR_ANY);
+  setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+  if(sndbuf)
+    setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));   // Herdado pelos aceitos
+  if(bind(fd, (struct sockaddr *)&a, sizeof(a)) < 0 || listen(fd, 2) < 0)
+  {
+    int err = errno;
+    close(fd);
+    errno = err;
+    return -1;
+  }//end if
+  NonBlocking(fd);
+  return fd;
+}//end Listen
+
+//=======================================================================================================
+//--- NonBlocking ---
+static void NonBlocking(int fd)
+{
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}//end NonBlocking
+
+//=======================================================================================================
+//--- Accept ---
+// Sem vaga o cliente e fechado na hora: quem ja esta conectado nao perde nada.
+static void Accept(int lfd, bool ws)
+{
+  int fd = accept(lfd, NULL, NULL);
+
+  if(fd < 0)
+    return;
+  for(int i = 0; i < NET_MAX_CLIENTS; i++)
+  {
+    client_t *c = &Client[i];
+    if(c->state != CLI_FREE)
+      continue;
+    memset(c, 0, sizeof(*c));
+    NonBlocking(fd);
+    c->fd     = fd;
+    c->ws     = ws;
+    c->state  = ws ? CLI_HANDSHAKE : CLI_STREAM;
+    c->cursor = Head;                                       // So os registros novos
+    Stats.accepted++;
+    return;
+  }//end for
+  close(fd);
+}//end Accept
+
+//=======================================================================================================
+//--- Close ---
+static void Close(client_t *c)
+{
+  close(c->fd);
+  c->fd    = -1;
+  c->state = CLI_FREE;
+}//end Close
+
+//=======================================================================================================
+//--- Overrun ---
+// O anel vai sobrescrever tudo antes de 'limit'. Se o cliente esta no meio de um registro, o resto
+// dele vai para pend (o frame WebSocket em curso ja contou esses bytes); os registros inteiros que
+// faltam sao pulados.
+static void Overrun(client_t *c, uint32_t limit)
+{
+  if((int32_t)(limit - c->cursor) <= 0)
+    return;
+  uint32_t off = c->cursor % NET_REC_SIZE;
+  if(off)
+  {
+    c->pend_len = (uint8_t)(NET_REC_SIZE - off);
+    c->pend_off = 0;
+    memcpy(c->pend, &Ring[c->cursor % RING_BYTES], c->pend_len);
+    c->cursor += c->pend_len;
+  }//end if
+  if((int32_t)(limit - c->cursor) > 0)
+  {
+    Stats.client_dropped += (limit - c->cursor) / NET_REC_SIZE;
+    c->cursor = limit;
+  }//end if
+}//end Overrun
+
+//=======================================================================================================
+//--- ClientRead ---
+// Clientes do stream nao mandam nada util (no maximo ping/close do WebSocket): o que chega e
+// descartado e so o EOF importa.
+static void ClientRead(client_t *c)
+{
+  uint8_t buf[64];
+  ssize_t n;
+
+  if(c->state == CLI_HANDSHAKE)
+  {
+    n = recv(c->fd, &c->req[c->req_len], WS_REQ_MAX - 1 - c->req_len, MSG_DONTWAIT);
+    if(n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+    {
+      Close(c);
+      return;
+    }//end if
+    if(n < 0)
+      return;
+    c->req_len += (uint16_t)n;
+    c->req[c->req_len] = '\0';
+    if(strstr(c->req, "\r\n\r\n"))
+    {
+      if(WsAccept(c))
+      {
+        c->state  = CLI_STREAM;
+        c->cursor = Head;
+      }//end if
+      else
+        Close(c);
+    }//end if
+    else if(c->req_len == WS_REQ_MAX - 1)
+      Close(c);                                             // Pedido grande demais
+    return;
+  }//end if
+
+  n = recv(c->fd, buf, sizeof(buf), MSG_DONTWAIT);
+  if(n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+    Close(c);
+}//end ClientRead
+
+//=======================================================================================================
+//--- ClientSend ---
+// Envia o que o socket aceitar sem bloquear: pend, depois o anel ate a volta ou ate o fim do frame.
+static void ClientSend(client_t *c)
+{
+  while(c->state == CLI_STREAM)
+  {
+    uint32_t queued = (Head - c->cursor) + (uint32_t)(c->pend_len - c->pend_off);
+    if(c->ws && c->frame_left == 0 && c->hdr_off == c->hdr_len)
+    {
+      if(queued == 0)
+        return;
+      c->frame_left = queued < NET_WS_FRAME ? queued : NET_WS_FRAME;
+      c->hdr[0]     = 0x82;                                 // FIN + binario, sem mascara (servidor)
+      if(c->frame_left < 126)
+      {
+        c->hdr[1]  = (uint8_t)c->frame_left;
+        c->hdr_len = 2;
+      }//end if
+      else
+      {
+        c->hdr[1]  = 126;
+        c->hdr[2]  = (uint8_t)(c->frame_left >> 8);
+        c->hdr[3]  = (uint8_t)c->frame_left;
+        c->hdr_len = 4;
+      }//end else
+      c->hdr_off = 0;
+    }//end if
+
+    const uint8_t *p;
+    size_t         len;
+    bool           hdr = c->hdr_off < c->hdr_len;
+    bool           pend = !hdr && c->pend_off < c->pend_len;
+    if(hdr)
+    {
+      p   = &c->hdr[c->hdr_off];
+      len = c->hdr_len - c->hdr_off;
+    }//end if
+    else if(pend)
+    {
+      p   = &c->pend[c->pend_off];
+      len = c->pend_len - c->pend_off;
+    }//end else if
+    else
+    {
+      uint32_t off = c->cursor % RING_BYTES;
+      len = Head - c->cursor;
+      if(len > RING_BYTES - off)
+        len = RING_BYTES - off;
+      p = &Ring[off];
+    }//end else
+    if(!hdr && c->ws && len > c->frame_left)
+      len = c->frame_left;
+    if(len == 0)
+      return;
+
+    ssize_t n = send(c->fd, p, len, SEND_FLAGS);
+    if(n < 0)
+    {
+      if(errno != EAGAIN && errno != EWOULDBLOCK)
+        Close(c);
+      return;                                               // Buffer do socket cheio: proximo poll
+    }//end if
+    if(hdr)
+      c->hdr_off += (uint8_t)n;
+    else
+    {
+      if(pend)
+      {
+        c->pend_off += (uint8_t)n;
+        if(c->pend_off == c->pend_len)
+          c->pend_off = c->pend_len = 0;
+      }//end if
+      else
+        c->cursor += (uint32_t)n;
+      if(c->ws)
+        c->frame_left -= (uint32_t)n;
+    }//end else
+  }//end while
+}//end ClientSend
+
+//=======================================================================================================
+//--- UdpSend ---
+// Datagrama = cabecalho + registros direto do anel (sendmsg com dois iovec). Lote incompleto espera
+// ate batch_ms; sem buffer no lwIP (ENOMEM) tenta no proximo poll.
+static void UdpSend(int64_t now_us)
+{
+  while(Udp >= 0)
+  {
+    uint32_t recs = (Head - UdpCursor) / NET_REC_SIZE;
+    uint32_t off  = UdpCursor % RING_BYTES;
+    if(recs == 0 || (recs < NET_UDP_BATCH && now_us - UdpOldestUs < BatchUs))
+      return;
+    if(recs > NET_UDP_BATCH)
+      recs = NET_UDP_BATCH;
+    if(recs > (RING_BYTES - off) / NET_REC_SIZE)
+      recs = (RING_BYTES - off) / NET_REC_SIZE;             // Nao atravessa a volta do anel
+
+    uint8_t       hdr[NET_UDP_HDR] = {'T', 'L', NET_UDP_VERSION, (uint8_t)recs};
+    struct iovec  iov[2];
+    struct msghdr m;
+    memcpy(&hdr[4], &Ring[off], 4);                         // rec do primeiro registro
+    iov[0].iov_base = hdr;
+    iov[0].iov_len  = sizeof(hdr);
+    iov[1].iov_base = &Ring[off];
+    iov[1].iov_len  = recs * NET_REC_SIZE;
+    memset(&m, 0, sizeof(m));
+    m.msg_name    = &UdpDest;
+    m.msg_namelen = sizeof(UdpDest);
+    m.msg_iov     = iov;
+    m.msg_iovlen  = 2;
+    if(sendmsg(Udp, &m, SEND_FLAGS) < 0)
+    {
+      if(errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOMEM)
+        return;
+      Stats.udp_dropped += recs;                            // Sem rota etc.: descarta o lote
+    }//end if
+    else
+      Stats.datagrams++;
+    UdpCursor  += recs * NET_REC_SIZE;
+    UdpOldestUs = now_us;
+  }//end while
+}//end UdpSend
+
+//=======================================================================================================
+//--- WsAccept ---
+// Handshake RFC 6455: Sec-WebSocket-Accept = base64(sha1(chave + GUID)).
+static bool WsAccept(client_t *c)
+{
+  static const char hdrName[] = "Sec-WebSocket-Key:";
+  char              key[64 + sizeof(WS_GUID)];
+  char              accept[32];
+  char              resp[160];
+  uint8_t           digest[20];
+  const char       *k = NULL;
+
+  for(const char *l = c->req; l && *l; l = strstr(l, "\r\n"), l = l ? l + 2 : NULL)
+  {
+    if(strncasecmp(l, hdrName, sizeof(hdrName) - 1) == 0)
+    {
+      k = l + sizeof(hdrName) - 1;
+      break;
+    }//end if
+  }//end for
+  if(k == NULL || strncmp(c->req, "GET ", 4) != 0)
+    return false;
+  while(*k == ' ')
+    k++;
+  size_t n = strcspn(k, " \r\n");
+  if(n == 0 || n > 64)
+    return false;
+  memcpy(key, k, n);
+  memcpy(&key[n], WS_GUID, sizeof(WS_GUID) - 1);
+  Sha1((const uint8_t *)key, n + sizeof(WS_GUID) - 1, digest);
+  Base64(digest, sizeof(digest), accept);
+
+  int w = snprintf(resp, sizeof(resp), "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n"
+                   "Connection: Upgrade\r\nSec-WebSocket-Accept: %s\r\n\r\n", accept);
+  return send(c->fd, resp, (size_t)w, SEND_FLAGS) == w;     // Socket recem-aberto: cabe inteiro
+}//end WsAccept
+
+//=======================================================================================================
+//--- Sha1 ---
+// So para o handshake (uma vez por cliente); simples, nao rapido.
+static void Sha1(const uint8_t *msg, size_t len, uint8_t out[20])
+{
+  uint32_t h[5]  = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+  uint64_t bits  = (uint64_t)len * 8;
+  size_t   total = ((len + 8) / 64 + 1) * 64;               // Mensagem + 0x80 + tamanho de 64 bits
+  uint32_t w[80];
+
+  for(size_t blk = 0; blk < total; blk += 64)
+  {
+    for(int i = 0; i < 64; i++)
+    {
+      size_t  k = blk + i;
+      uint8_t b = k < len ? msg[k] : k == len ? 0x80 : 0;
+      if(k >= total - 8)
+        b = (uint8_t)(bits >> (8 * (total - 1 - k)));
+      if(i % 4 == 0)
+        w[i / 4] = 0;
+      w[i / 4] |= (uint32_t)b << (24 - 8 * (i % 4));
+    }//end for
+    for(int i = 16; i < 80; i++)
+    {
+      uint32_t x = w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16];
+      w[i] = x << 1 | x >> 31;
+    }//end for
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+    for(int i = 0; i < 80; i++)
+    {
+      uint32_t f, k;
+      if(i < 20)      { f = (b & c) | (~b & d);          k = 0x5A827999; }
+      else if(i < 40) { f = b ^ c ^ d;                   k = 0x6ED9EBA1; }
+      else if(i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+      else            { f = b ^ c ^ d;                   k = 0xCA62C1D6; }
+      uint32_t t = (a << 5 | a >> 27) + f + e + k + w[i];
+      e = d;
+      d = c;
+      c = b << 30 | b >> 2;
+      b = a;
+      a = t;
+    }//end for
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+  }//end for
+  for(int i = 0; i < 20; i++)
+    out[i] = (uint8_t)(h[i / 4] >> (24 - 8 * (i % 4)));
+}//end Sha1
+
+//=======================================================================================================
+//--- Base64 ---
+static void Base64(const uint8_t *in, size_t len, char *out)
+{
+  static const char Tab[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  for(size_t i = 0; i < len; i += 3)
+  {
+    uint32_t v = (uint32_t)in[i] << 16 | (i + 1 < len ? in[i + 1] << 8 : 0) | (i + 2 < len ? in[i + 2] : 0);
+    *out++ = Tab[v >> 18 & 63];
+    *out++ = Tab[v >> 12 & 63];
+    *out++ = i + 1 < len ? Tab[v >> 6 & 63] : '=';
+    *out++ = i + 2 < len ? Tab[v & 63] : '=';
+  }//end for
+  *out = '\0';
+}//end Base64
+
+//=======================================================================================================
+//--- Put16 / Put32 / Get32 ---
+static void Put16(uint8_t *p, uint16_t v)
+{
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}//end Put16
+
+static void Put32(uint8_t *p, uint32_t v)
+{
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+}//end Put32
+
+static uint32_t Get32(const uint8_t *p)
+{
+  return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}//end Get32
+
+//=======================================================================================================
+//--- End of Program ---
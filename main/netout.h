@@ -0,0 +1,84 @@
+//=======================================================================================================
+//
+//   Title: Network uplink fan-out (UDP batches, TCP and WebSocket streams).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Cada amostra vira um registro binario de NET_REC_SIZE bytes (little-endian) escrito uma unica vez
+//   num anel de bytes. Todos os destinos leem desse anel com o proprio cursor, como os leitores do
+//   SampleRing, e o send() sai direto da memoria do anel (sem copia por cliente):
+//     - UDP: datagramas com cabecalho de 8 bytes + ate NET_UDP_BATCH registros, enviados cheios ou
+//       apos batch_ms; destino unicast, broadcast ou multicast (TTL 1).
+//     - TCP: os registros em sequencia, sem cabecalho.
+//     - WebSocket: os mesmos bytes em frames binarios (ate NET_WS_FRAME bytes cada).
+//   Os sockets sao nao bloqueantes. Um cliente lento so atrasa o proprio cursor: quando o anel vai
+//   sobrescrever o que ele ainda nao enviou, o cursor pula para o registro mais antigo ainda no anel
+//   e os registros pulados sao contados para ele. O campo 'rec' mostra o buraco do lado do cliente.
+//
+//   Registro (offset: campo):
+//     0 rec u32 | 4 t_ms u32 | 8 node u8 | 9 flags u8 | 10 snr u8 | 11 0 | 12 rssi i16 | 14 rx_ms u16
+//     16 pitch f32 | 20 roll f32 | 24 temp f32 | 28 pressao u32 | 32 lat_e7 i32 | 36 lon_e7 i32
+//     40 altitude f32 | 44 velocidade f32 | 48 range f32 | 52 bearing f32 | 56 elevation f32
+//     60 rx_parse_us u32
+//   t_ms = instante da medida (t_sample_us) em ms; rx_ms = dele ao RxDone (65535 = saturado).
+//   Cabecalho UDP: 'T' 'L' | versao u8 | registros u8 | rec do primeiro u32
+//
+//   So usa a API de sockets BSD (lwIP no ESP32), entao o mesmo arquivo roda no host contra clientes
+//   em localhost (bench/netsim.c). Um unico chamador: netout_push e netout_poll na mesma task.
+//=======================================================================================================
+
+#ifndef NETOUT_h
+#define NETOUT_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "telemetry.h"
+
+//=======================================================================================================
+//--- Macros and Constants ---
+#define NET_REC_SIZE     64
+#define NET_RING_RECS    256                  // Anel de 16 KB
+#define NET_UDP_HDR      8
+#define NET_UDP_BATCH    16                   // 8 + 16*64 = 1032 bytes, abaixo do MTU
+#define NET_UDP_VERSION  2
+#define NET_WS_FRAME     4096
+#define NET_MAX_CLIENTS  4
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    const char *udp_dest;                     // IPv4 do destino UDP (NULL ou "" = sem UDP)
+    uint16_t    udp_port;
+    uint16_t    tcp_port;                     // 0 = sem servidor TCP
+    uint16_t    ws_port;                      // 0 = sem servidor WebSocket
+    uint32_t    batch_ms;                     // Idade maxima de um datagrama incompleto
+    int         sndbuf;                       // SO_SNDBUF dos clientes (0 = padrao da pilha)
+}net_config_t;
+
+typedef struct{
+    uint32_t records;                         // Registros escritos no anel
+    uint32_t datagrams;
+    uint32_t udp_dropped;                     // Registros que o UDP perdeu (envio falhou ou anel)
+    uint8_t  clients;                         // Clientes TCP/WS conectados
+    uint32_t accepted;
+    uint32_t client_dropped;                  // Registros pulados por clientes lentos (soma)
+}net_stats_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+int    netout_start(const net_config_t *cfg);                    // 0 ou -errno
+void   netout_stop(void);
+void   netout_push(const telemetry_sample_t *s, int64_t now_us); // Registro novo no anel (nunca bloqueia)
+void   netout_poll(int timeout_ms, int64_t now_us);              // select + accept + envios pendentes
+void   netout_get(net_stats_t *out);
+size_t netout_encode(const telemetry_sample_t *s, uint32_t rec, uint8_t *out);  // Um registro (NET_REC_SIZE)
+bool   netout_decode(const uint8_t *in, uint32_t *rec, telemetry_sample_t *out);
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,83 @@
+//=======================================================================================================
+//
+//   Title: Per-transmitter (node) state table.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include "nodes.h"
+
+//=======================================================================================================
+//--- Variaveis ---
+static node_state_t Nodes[NODE_MAX];
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- nodes_reset ---
+void nodes_reset(void)
+{
+  memset(Nodes, 0, sizeof(Nodes));
+}//end nodes_reset
+
+//=======================================================================================================
+//--- node_get ---
+node_state_t *node_get(uint8_t id)
+{
+  return id < NODE_MAX ? &Nodes[id] : NULL;
+}//end node_get
+
+//=======================================================================================================
+//--- node_rx ---
+void node_rx(node_state_t *n, const link_frame_t *f, int16_t rssi, int64_t t_us)
+{
+  n->rx++;
+  n->rssi       = rssi;
+  n->last_rx_us = t_us;
+
+  if(!f->has_hdr || (f->flags & LINK_F_REL))
+    return;                                   // Legado nao tem sequencia; a do canal confiavel e do arq.c
+  if(n->seq_valid)
+  {
+    uint8_t gap = (uint8_t)(f->seq - n->last_seq - 1);
+    if(gap >= 128)
+      return;                                 // Duplicata/atraso (ex.: refeito pela FEC): nao e perda nem avanca
+    n->lost += gap;
+  }//end if
+  n->last_seq  = f->seq;
+  n->seq_valid = true;
+}//end node_rx
+
+//=======================================================================================================
+//--- node_period ---
+// Media movel do intervalo entre telemetrias: o watchdog mede o silencio nessa unidade, entao o mesmo
+// limiar vale para um no a 20 Hz e outro a um frame por minuto. Um intervalo longo (frames perdidos)
+// entra cortado em NODE_PERIOD_CLIP x a media: uma queda de taxa de verdade ainda e seguida em poucos
+// frames, mas uma rajada de perdas nao infla a media a ponto de esconder a proxima.
+void node_period(node_state_t *n, int64_t t_us)
+{
+  int64_t dt = t_us - n->tlm_us;
+
+  if(n->tlm_us != 0 && dt > 0)
+  {
+    if(n->period_us == 0)
+      n->period_us = dt > UINT32_MAX ? UINT32_MAX : (uint32_t)dt;
+    else
+    {
+      int64_t p = n->period_us;
+      if(dt > p * NODE_PERIOD_CLIP)
+        dt = p * NODE_PERIOD_CLIP;
+      p += (dt - p) / (1 << NODE_PERIOD_SHIFT);
+      n->period_us = p < 1 ? 1 : p > UINT32_MAX ? UINT32_MAX : (uint32_t)p;
+    }//end else
+  }//end if
+  n->tlm_us = t_us;
+}//end node_period
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,77 @@
+//=======================================================================================================
+//
+//   Title: Per-transmitter (node) state table.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Tabela fixa indexada pelo endereco do cabecalho de enlace: busca O(1), sem hash nem lista.
+//   Escrita apenas pelo ReceiveLoraData; o relatorio so le contadores.
+//=======================================================================================================
+
+#ifndef NODES_h
+#define NODES_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include "telemetry.h"
+#include "link.h"
+#include "arq.h"
+#include "fec.h"
+#include "delta.h"
+#include "timesync.h"
+#include "metrics.h"
+#include "alarm.h"
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+#ifdef CONFIG_NODE_MAX
+#define NODE_MAX CONFIG_NODE_MAX
+#else
+#define NODE_MAX 8
+#endif
+
+#define NODE_PERIOD_SHIFT 3                   // Media do intervalo: peso 1/8 por chegada
+#define NODE_PERIOD_CLIP  4                   // Intervalo acima de 4x a media conta como 4x (perdas)
+
+_Static_assert(NODE_MAX <= LINK_NODE_MAX, "NODE_MAX maior que o endereco do cabecalho");
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    uint32_t rx;                              // Frames recebidos deste no
+    uint32_t bad;                             // Frames que nao decodificaram
+    uint32_t lost;                            // Lacunas na sequencia do cabecalho (frames nao confiaveis)
+    uint32_t ring_idx;                        // Indice no SampleRing da ultima amostra deste no
+    int64_t  last_rx_us;
+    int64_t  tlm_us;                          // Ultima telemetria (watchdog de enlace)
+    uint32_t period_us;                       // Intervalo medio entre telemetrias; 0 = menos de duas
+    int16_t  rssi;                            // RSSI do ultimo frame
+    uint8_t  last_seq;
+    bool     seq_valid;
+    telemetry_sample_t last;                  // Ultima amostra decodificada
+    arq_state_t arq;                          // Canal confiavel (LINK_F_REL): reordenacao e ACK
+    fec_state_t fec;                          // XOR acumulado do grupo FEC corrente
+    delta_state_t delta;                      // Keyframe de referencia dos frames delta
+    timesync_t sync;                          // Relogio do transmissor -> receptor (LINK_T_TIME)
+    metrics_t metrics;                        // Velocidade vertical, apogeu, pouso, atitude media
+    alarm_state_t alarm;                      // Regras disparadas/em hold (alarm.h)
+}node_state_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void          nodes_reset(void);                                                 // Zera a tabela
+node_state_t *node_get(uint8_t id);                                              // NULL fora da tabela
+void          node_rx(node_state_t *n, const link_frame_t *f, int16_t rssi, int64_t t_us); // Estatisticas de enlace
+void          node_period(node_state_t *n, int64_t t_us);                        // Chegada de telemetria
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
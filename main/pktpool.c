@@ -0,0 +1,198 @@
+//=======================================================================================================
+//
+//   Title: Packet buffer pool (radio -> parser, flash log, capture).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <string.h>
+#include "pktpool.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define ALL_FREE  ((uint32_t)(((uint64_t)1 << PKT_POOL_LEN) - 1))
+#define TAP_SLOTS 32                          // Potencia de 2, >= PKT_TAP_DEPTH
+#define TAP_MASK  (TAP_SLOTS - 1)
+
+_Static_assert(PKT_POOL_LEN >= 2 && PKT_POOL_LEN <= 32, "PKT_POOL_LEN cabe na mascara de 32 bits");
+_Static_assert(PKT_TAP_DEPTH <= TAP_SLOTS, "PKT_TAP_DEPTH maior que a fila do tap");
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    pkt_buf_t  *slot[TAP_SLOTS];
+    atomic_uint head;                         // Escrito so pelo radio
+    atomic_uint tail;                         // Escrito so pelo consumidor
+    atomic_bool on;
+    uint32_t    dropped;
+}tap_t;
+
+//=======================================================================================================
+//--- Variaveis ---
+static pkt_buf_t   Pool[PKT_POOL_LEN];
+static atomic_uint Free;                      // Bit i = Pool[i] livre
+static tap_t       Taps[PKT_TAP_COUNT];
+static uint32_t    Seq, Received, Exhausted;  // So o radio escreve
+static uint8_t     MinFree;
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- pktpool_init ---
+void pktpool_init(void)
+{
+  memset(Pool, 0, sizeof(Pool));
+  for(int i = 0; i < PKT_POOL_LEN; i++)
+  {
+    Pool[i].idx = (uint8_t)i;
+    atomic_init(&Pool[i].refs, 0);
+  }//end for
+  for(int t = 0; t < PKT_TAP_COUNT; t++)
+  {
+    atomic_init(&Taps[t].head, 0);
+    atomic_init(&Taps[t].tail, 0);
+    atomic_init(&Taps[t].on, false);
+    Taps[t].dropped = 0;
+  }//end for
+  atomic_init(&Free, ALL_FREE);
+  Seq = Received = Exhausted = 0;
+  MinFree = PKT_POOL_LEN;
+}//end pktpool_init
+
+//=======================================================================================================
+//--- pktpool_get ---
+// Tira o buffer livre de menor indice da mascara; o CAS so falha se um consumidor devolver um buffer
+// no meio, e ai a mascara nova e relida.
+pkt_buf_t *pktpool_get(void)
+{
+  uint32_t mask = atomic_load_explicit(&Free, memory_order_acquire);
+
+  Seq++;
+  do
+  {
+    if(mask == 0)
+    {
+      Exhausted++;
+      return NULL;
+    }//end if
+  }while(!atomic_compare_exchange_weak_explicit(&Free, &mask, mask & (mask - 1), memory_order_acquire,
+                                                memory_order_acquire));
+
+  int        i = __builtin_ctz(mask);
+  pkt_buf_t *p = &Pool[i];
+  uint8_t    n = (uint8_t)__builtin_popcount(mask) - 1;
+  if(n < MinFree)
+    MinFree = n;
+  Received++;
+  atomic_store_explicit(&p->refs, 1, memory_order_relaxed);
+  p->seq = Seq;
+  return p;
+}//end pktpool_get
+
+//=======================================================================================================
+//--- pktpool_ref ---
+void pktpool_ref(pkt_buf_t *p)
+{
+  atomic_fetch_add_explicit(&p->refs, 1, memory_order_relaxed);
+}//end pktpool_ref
+
+//=======================================================================================================
+//--- pktpool_put ---
+void pktpool_put(pkt_buf_t *p)
+{
+  if(atomic_fetch_sub_explicit(&p->refs, 1, memory_order_acq_rel) == 1)
+    atomic_fetch_or_explicit(&Free, 1u << p->idx, memory_order_release);
+}//end pktpool_put
+
+//=======================================================================================================
+//--- pktpool_publish ---
+void pktpool_publish(pkt_buf_t *p)
+{
+  for(int t = 0; t < PKT_TAP_COUNT; t++)
+  {
+    tap_t *tap = &Taps[t];
+    if(!atomic_load_explicit(&tap->on, memory_order_relaxed))
+      continue;
+    uint32_t head = atomic_load_explicit(&tap->head, memory_order_relaxed);
+    if(head - atomic_load_explicit(&tap->tail, memory_order_acquire) >= PKT_TAP_DEPTH)
+    {
+      tap->dropped++;
+      continue;
+    }//end if
+    pktpool_ref(p);
+    tap->slot[head & TAP_MASK] = p;
+    atomic_store_explicit(&tap->head, head + 1, memory_order_release);
+  }//end for
+}//end pktpool_publish
+
+//=======================================================================================================
+//--- pktpool_tap ---
+void pktpool_tap(pkt_tap_t t, bool on)
+{
+  atomic_store_explicit(&Taps[t].on, on, memory_order_relaxed);
+}//end pktpool_tap
+
+//=======================================================================================================
+//--- pktpool_tapped ---
+bool pktpool_tapped(pkt_tap_t t)
+{
+  return atomic_load_explicit(&Taps[t].on, memory_order_relaxed);
+}//end pktpool_tapped
+
+//=======================================================================================================
+//--- pktpool_take ---
+pkt_buf_t *pktpool_take(pkt_tap_t t)
+{
+  tap_t   *tap  = &Taps[t];
+  uint32_t tail = atomic_load_explicit(&tap->tail, memory_order_relaxed);
+
+  if(tail == atomic_load_explicit(&tap->head, memory_order_acquire))
+    return NULL;
+  pkt_buf_t *p = tap->slot[tail & TAP_MASK];
+  atomic_store_explicit(&tap->tail, tail + 1, memory_order_release);
+  return p;
+}//end pktpool_take
+
+//=======================================================================================================
+//--- pktpool_get_stats ---
+void pktpool_get_stats(pkt_stats_t *out)
+{
+  out->size      = PKT_POOL_LEN;
+  out->free      = (uint8_t)__builtin_popcount(atomic_load_explicit(&Free, memory_order_relaxed));
+  out->min_free  = MinFree;
+  out->received  = Received;
+  out->exhausted = Exhausted;
+  for(int t = 0; t < PKT_TAP_COUNT; t++)
+    out->dropped[t] = Taps[t].dropped;
+}//end pktpool_get_stats
+
+//=======================================================================================================
+//--- pktpool_format ---
+// Retorna o tamanho da linha (0 se nao couber).
+size_t pktpool_format(const pkt_buf_t *p, char *buf, size_t size)
+{
+  static const char Hex[] = "0123456789abcdef";
+  int w = snprintf(buf, size, "$RAW,%lu,%lld,%d,%d,%u,", (unsigned long)p->seq, (long long)p->t_pre_us, p->rssi,
+                   p->snr, p->len);
+
+  if(w < 0 || (size_t)w + 2 * p->len + 2 > size)
+    return 0;
+  char *o = buf + w;
+  for(uint16_t i = 0; i < p->len; i++)
+  {
+    *o++ = Hex[p->data[i] >> 4];
+    *o++ = Hex[p->data[i] & 0x0F];
+  }//end for
+  *o++ = '\n';
+  *o   = '\0';
+  return (size_t)(o - buf);
+}//end pktpool_format
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,91 @@
+//=======================================================================================================
+//
+//   Title: Packet buffer pool (radio -> parser, flash log, capture).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Pool fixo de PKT_POOL_LEN buffers de pacote bruto com os metadados da recepcao. O ReceiveLoraData
+//   le o FIFO direto num buffer do pool, publica o ponteiro para os consumidores ligados (taps) e
+//   decodifica no proprio buffer; nenhum consumidor copia o pacote. Cada tap e uma fila SPSC de
+//   ponteiros com no maximo PKT_TAP_DEPTH pacotes, entao um consumidor parado nao esgota o pool
+//   sozinho: o excesso e contado como descartado para ele.
+//
+//   Contagem de referencias: pktpool_get entrega o buffer com refs = 1 (do radio); cada tap que recebe
+//   o ponteiro soma 1; quem terminar chama pktpool_put e o ultimo devolve o buffer ao pool. Pool e
+//   filas so usam atomicos (como o SampleRing), sem mutex entre os nucleos.
+//
+//   Regras: pktpool_get/pktpool_publish so na task do radio (um produtor); cada tap e drenado por uma
+//   unica task, que deve continuar drenando depois de desligar o tap.
+//=======================================================================================================
+
+#ifndef PKTPOOL_h
+#define PKTPOOL_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+//=======================================================================================================
+//--- Macros and Constants ---
+#ifdef CONFIG_PKT_POOL_LEN
+#define PKT_POOL_LEN  CONFIG_PKT_POOL_LEN
+#else
+#define PKT_POOL_LEN  16
+#endif
+#define PKT_DATA_MAX  256                     // 255 bytes do FIFO + terminador
+#define PKT_TAP_DEPTH (PKT_POOL_LEN / 2)      // Pacotes presos por tap, no maximo
+#define PKT_LINE_MAX  576                     // "$RAW,..." com 255 bytes em hex
+
+//=======================================================================================================
+//--- Types ---
+
+typedef enum{
+    PKT_TAP_FLASHLOG = 0,                     // Log bruto na flash ("log start raw")
+    PKT_TAP_CAPTURE,                          // Linhas $RAW no uplink ("capture on")
+    PKT_TAP_COUNT
+}pkt_tap_t;
+
+typedef struct{
+    uint8_t     data[PKT_DATA_MAX];
+    uint16_t    len;
+    int16_t     rssi;                         // dBm
+    int8_t      snr;                          // dB
+    uint8_t     idx;                          // Posicao fixa no pool
+    int64_t     t_rx_us;                      // Carimbo do RxDone
+    int64_t     t_pre_us;                     // RxDone corrigido para o fim do preambulo (radio.h)
+    uint32_t    seq;                          // Pacotes lidos do FIFO ate este
+    atomic_uint refs;
+}pkt_buf_t;
+
+typedef struct{
+    uint8_t  size;
+    uint8_t  free;
+    uint8_t  min_free;                        // Menor numero de buffers livres desde o boot
+    uint32_t received;                        // Buffers entregues ao radio
+    uint32_t exhausted;                       // Pacotes lidos sem buffer livre (so decodificados)
+    uint32_t dropped[PKT_TAP_COUNT];          // Tap cheio
+}pkt_stats_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void       pktpool_init(void);
+pkt_buf_t *pktpool_get(void);                                    // refs = 1; NULL com o pool esgotado
+void       pktpool_ref(pkt_buf_t *p);
+void       pktpool_put(pkt_buf_t *p);                            // Ultima referencia devolve ao pool
+void       pktpool_publish(pkt_buf_t *p);                        // Entrega a todos os taps ligados
+void       pktpool_tap(pkt_tap_t t, bool on);
+bool       pktpool_tapped(pkt_tap_t t);
+pkt_buf_t *pktpool_take(pkt_tap_t t);                            // Proximo do tap (o chamador faz o put)
+void       pktpool_get_stats(pkt_stats_t *out);
+size_t     pktpool_format(const pkt_buf_t *p, char *buf, size_t size);  // $RAW,seq,t_pre_us,rssi,snr,len,hex
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,111 @@
+//=======================================================================================================
+//
+//   Title: Receiver power modes (CAD duty cycling) and energy accounting.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include "power.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+// Correntes tipicas em uA. SX1276: RX/CAD com LnaBoostHf (lora_init liga), TX em +17 dBm no PA_BOOST.
+// ESP32: 240 MHz sem Wi-Fi, CPU quase toda em idle; light sleep com RTC ligado.
+static const uint32_t RadioUa[PWR_STATE_COUNT] = {1, 11500, 11500, 87000};
+#define ESP_AWAKE_UA 30000
+#define ESP_LIGHT_UA 800
+
+//=======================================================================================================
+//--- Variaveis ---
+static power_stats_t Stats;
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- power_plan ---
+bool power_plan(const radio_profile_t *p, uint16_t preamble, power_plan_t *out)
+{
+  uint32_t tsym = radio_symbol_us(p);
+
+  memset(out, 0, sizeof(*out));
+  if(preamble < 2 * POWER_CAD_SYMBOLS + POWER_LOCK_SYMBOLS + 1)
+    return false;                                           // Nao sobra tempo para dormir
+  out->cad_us         = POWER_CAD_SYMBOLS * tsym;
+  out->sleep_us       = (uint32_t)(preamble - 2 * POWER_CAD_SYMBOLS - POWER_LOCK_SYMBOLS) * tsym;
+  out->rx_timeout_sym = preamble;                           // Cobre o resto do preambulo com folga
+  out->preamble       = preamble;
+  out->extra_air_us   = preamble > p->preamble ? (uint32_t)(preamble - p->preamble) * tsym : 0;
+  return true;
+}//end power_plan
+
+//=======================================================================================================
+//--- power_set_mode ---
+void power_set_mode(bool duty, bool light_sleep, int64_t now)
+{
+  memset(&Stats, 0, sizeof(Stats));
+  Stats.duty        = duty;
+  Stats.light_sleep = light_sleep;
+  Stats.state       = duty ? PWR_SLEEP : PWR_RX;
+  Stats.mark_us     = now;
+}//end power_set_mode
+
+//=======================================================================================================
+//--- power_enter ---
+pwr_state_t power_enter(pwr_state_t st, int64_t now)
+{
+  pwr_state_t prev = Stats.state;
+
+  if(now > Stats.mark_us)
+    Stats.us[prev] += (uint64_t)(now - Stats.mark_us);
+  Stats.mark_us = now;
+  Stats.state   = st;
+  return prev;
+}//end power_enter
+
+//=======================================================================================================
+//--- power_cad / power_cad_false ---
+void power_cad(bool hit)
+{
+  Stats.cad++;
+  if(hit)
+    Stats.cad_hit++;
+}//end power_cad
+
+void power_cad_false(void)
+{
+  Stats.cad_false++;
+}//end power_cad_false
+
+//=======================================================================================================
+//--- power_get ---
+void power_get(power_stats_t *out, int64_t now)
+{
+  *out = Stats;
+  if(now > out->mark_us)
+    out->us[out->state] += (uint64_t)(now - out->mark_us);
+}//end power_get
+
+//=======================================================================================================
+//--- power_avg_ua ---
+// Media ponderada pelo tempo. O ESP32 so conta como dormindo enquanto o radio dorme no modo CAD:
+// nos outros estados a task do radio esta esperando um DIO e o tickless idle acorda a cada tick.
+uint32_t power_avg_ua(const power_stats_t *s)
+{
+  uint64_t total = 0, charge = 0;
+
+  for(int i = 0; i < PWR_STATE_COUNT; i++)
+  {
+    uint32_t esp = (i == PWR_SLEEP && s->duty && s->light_sleep) ? ESP_LIGHT_UA : ESP_AWAKE_UA;
+    total  += s->us[i];
+    charge += s->us[i] * (RadioUa[i] + esp);
+  }//end for
+  return total ? (uint32_t)(charge / total) : 0;
+}//end power_avg_ua
+
+//=======================================================================================================
+//--- End of Program ---
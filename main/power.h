@@ -0,0 +1,80 @@
+//=======================================================================================================
+//
+//   Title: Receiver power modes (CAD duty cycling) and energy accounting.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   No modo CONFIG_POWER_RX_CAD o radio dorme e acorda a cada ciclo para um CAD (channel activity
+//   detection). So quando o CAD ve preambulo no ar abre-se um RX_SINGLE. Para nenhum frame passar
+//   entre dois CADs, o transmissor usa um preambulo longo (Npre) e o ciclo cabe dentro dele:
+//
+//     ciclo = Npre - CAD - trava         (simbolos)
+//     sono  = ciclo - CAD
+//
+//   Aqui "trava" sao os simbolos de preambulo que o RX_SINGLE ainda precisa depois do CAD. O custo vai
+//   para o transmissor: (Npre - preambulo do perfil) simbolos a mais por frame.
+//
+//   A corrente media e estimada pelo tempo em cada estado e pelas correntes tipicas dos datasheets
+//   (SX1276 e ESP32). A estimativa cobre so o radio e o SoC, sem LCD nem regulador.
+//=======================================================================================================
+
+#ifndef POWER_h
+#define POWER_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "radio.h"
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+#define POWER_CAD_SYMBOLS  2                  // Duracao de um CAD (~1 simbolo + processamento)
+#define POWER_LOCK_SYMBOLS 5                  // Preambulo que o RX_SINGLE precisa para sincronizar
+
+//=======================================================================================================
+//--- Types ---
+
+typedef enum{
+    PWR_SLEEP = 0,                            // Radio em sleep (ESP32 em light sleep, se habilitado)
+    PWR_CAD,
+    PWR_RX,
+    PWR_TX,
+    PWR_STATE_COUNT
+}pwr_state_t;
+
+typedef struct{
+    uint32_t cad_us;                          // Duracao de um CAD
+    uint32_t sleep_us;                        // Radio dormindo entre dois CADs
+    uint16_t rx_timeout_sym;                  // Timeout do RX_SINGLE apos um CAD positivo
+    uint16_t preamble;                        // Preambulo que o transmissor tem que usar
+    uint32_t extra_air_us;                    // Tempo no ar a mais por frame no transmissor
+}power_plan_t;
+
+typedef struct{
+    bool        duty;                         // Modo CAD ativo
+    bool        light_sleep;                  // ESP32 dorme junto com o radio
+    pwr_state_t state;
+    int64_t     mark_us;                      // Entrada no estado atual
+    uint64_t    us[PWR_STATE_COUNT];          // Tempo acumulado por estado
+    uint32_t    cad;                          // CADs feitos
+    uint32_t    cad_hit;                      // CADs com preambulo
+    uint32_t    cad_false;                    // CAD positivo sem frame (RxTimeout ou CRC)
+}power_stats_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+bool        power_plan(const radio_profile_t *p, uint16_t preamble, power_plan_t *out);  // false = preambulo curto demais
+void        power_set_mode(bool duty, bool light_sleep, int64_t now);
+pwr_state_t power_enter(pwr_state_t st, int64_t now);          // Troca de estado; devolve o anterior
+void        power_cad(bool hit);                               // Resultado de um CAD
+void        power_cad_false(void);                             // CAD positivo que nao virou frame
+void        power_get(power_stats_t *out, int64_t now);        // Copia com o estado atual contabilizado
+uint32_t    power_avg_ua(const power_stats_t *s);              // Corrente media estimada (radio + ESP32)
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,85 @@
+//=======================================================================================================
+//
+//   Title: LoRa modem profiles and time-on-air.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include "radio.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define LDRO_SYMBOL_US 16000                  // Acima disso o datasheet exige LowDataRateOptimize
+
+static const radio_profile_t RadioProfiles[RADIO_PROFILE_COUNT] = {
+  [RADIO_PROFILE_LONG]    = {"longo",  12, 5, 8, 125000, true, false},
+  [RADIO_PROFILE_DEFAULT] = {"padrao", 10, 5, 6, 125000, true, false},
+  [RADIO_PROFILE_FAST]    = {"rapido",  7, 5, 6, 250000, true, false},
+};
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- radio_profile ---
+const radio_profile_t *radio_profile(uint8_t id)
+{
+  return id < RADIO_PROFILE_COUNT ? &RadioProfiles[id] : NULL;
+}//end radio_profile
+
+//=======================================================================================================
+//--- radio_symbol_us ---
+uint32_t radio_symbol_us(const radio_profile_t *p)
+{
+  return (uint32_t)(((uint64_t)1000000u << p->sf) / p->bw_hz);
+}//end radio_symbol_us
+
+//=======================================================================================================
+//--- radio_ldro ---
+bool radio_ldro(const radio_profile_t *p)
+{
+  return radio_symbol_us(p) >= LDRO_SYMBOL_US;
+}//end radio_ldro
+
+//=======================================================================================================
+//--- radio_airtime_us ---
+// Conta tudo em quartos de simbolo para manter o 4.25 do preambulo inteiro; uma unica divisao no fim.
+uint32_t radio_airtime_us(const radio_profile_t *p, size_t payload)
+{
+  int32_t de   = radio_ldro(p) ? 1 : 0;
+  int32_t num  = 8 * (int32_t)payload - 4 * p->sf + 28 + (p->crc ? 16 : 0) - (p->implicit ? 20 : 0);
+  int32_t den  = 4 * (p->sf - 2 * de);
+  int32_t nPay = 8;
+
+  if(num > 0)
+    nPay += ((num + den - 1) / den) * p->cr;
+
+  uint64_t quarters = (uint64_t)p->preamble * 4 + 17 + (uint64_t)nPay * 4;
+  return (uint32_t)((quarters * ((uint64_t)1000000u << p->sf)) / (4ull * p->bw_hz));
+}//end radio_airtime_us
+
+//=======================================================================================================
+//--- radio_preamble_us ---
+// Preambulo + sync word (Npre + 4.25 simbolos): do inicio da transmissao ao primeiro simbolo do
+// cabecalho.
+uint32_t radio_preamble_us(const radio_profile_t *p)
+{
+  uint64_t quarters = (uint64_t)p->preamble * 4 + 17;
+  return (uint32_t)((quarters * ((uint64_t)1000000u << p->sf)) / (4ull * p->bw_hz));
+}//end radio_preamble_us
+
+//=======================================================================================================
+//--- radio_preamble_end_us ---
+// Carimbo do RxDone -> fim do preambulo. O RxDone sobe depois do ultimo simbolo do payload, entao o
+// erro do carimbo cru cresce com o tamanho do frame (centenas de ms em SF12); o fim do preambulo e
+// o mesmo instante para qualquer tamanho.
+int64_t radio_preamble_end_us(const radio_profile_t *p, size_t payload, int64_t t_rxdone_us)
+{
+  return t_rxdone_us - (int64_t)(radio_airtime_us(p, payload) - radio_preamble_us(p));
+}//end radio_preamble_end_us
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,70 @@
+//=======================================================================================================
+//
+//   Title: LoRa modem profiles and time-on-air.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Cada perfil fixa SF/BW/CR/preambulo; o perfil ativo vem do menuconfig e e aplicado pelo setupLoRa.
+//   O tempo no ar segue a formula do datasheet do SX1276 (secao 4.1.1.7), em inteiros:
+//     Tsym = 2^SF / BW
+//     Tpre = (Npre + 4.25) * Tsym
+//     Npay = 8 + max(ceil((8*PL - 4*SF + 28 + 16*CRC - 20*IH) / (4*(SF - 2*DE))) * (CR), 0)
+//   com DE (LowDataRateOptimize) ligado quando Tsym >= 16 ms.
+//=======================================================================================================
+
+#ifndef RADIO_h
+#define RADIO_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+enum{
+  RADIO_PROFILE_LONG = 0,                     // SF12/125k: alcance maximo, ~300 bps
+  RADIO_PROFILE_DEFAULT,                      // SF10/125k: configuracao original do receptor
+  RADIO_PROFILE_FAST,                         // SF7/250k: voos proximos, taxa alta
+  RADIO_PROFILE_COUNT
+};
+
+#if defined(CONFIG_RADIO_PROFILE_LONG)
+#define RADIO_PROFILE_ACTIVE RADIO_PROFILE_LONG
+#elif defined(CONFIG_RADIO_PROFILE_FAST)
+#define RADIO_PROFILE_ACTIVE RADIO_PROFILE_FAST
+#else
+#define RADIO_PROFILE_ACTIVE RADIO_PROFILE_DEFAULT
+#endif
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    const char *name;
+    uint8_t     sf;                           // Spreading factor 6..12
+    uint8_t     cr;                           // Coding rate 4/cr, cr = 5..8
+    uint16_t    preamble;                     // Simbolos de preambulo
+    uint32_t    bw_hz;
+    bool        crc;                          // CRC de payload
+    bool        implicit;                     // Cabecalho implicito (tamanho fixo)
+}radio_profile_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+const radio_profile_t *radio_profile(uint8_t id);                          // NULL fora da tabela
+bool     radio_ldro(const radio_profile_t *p);                             // LowDataRateOptimize exigido?
+uint32_t radio_symbol_us(const radio_profile_t *p);                        // Duracao de um simbolo
+uint32_t radio_airtime_us(const radio_profile_t *p, size_t payload);       // Tempo no ar de um frame
+uint32_t radio_preamble_us(const radio_profile_t *p);                      // Preambulo + sync word
+int64_t  radio_preamble_end_us(const radio_profile_t *p, size_t payload, int64_t t_rxdone_us);  // RxDone -> fim do preambulo
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
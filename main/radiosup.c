@@ -0,0 +1,136 @@
+//=======================================================================================================
+//
+//   Title: Radio supervisor (wedged SX1276 detection and recovery bookkeeping).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include "radiosup.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define SX1276_VERSION   0x12                 // REG_VERSION (lora.h)
+#define OP_LONG_RANGE    0x80                 // MODE_LONG_RANGE_MODE em REG_OP_MODE
+
+static const char *ReasonName[RADIOSUP_REASON_COUNT] = {"ok", "versao", "modo", "silencio"};
+
+//=======================================================================================================
+//--- Variaveis ---
+// So a task do radio escreve; o instr copia (um campo rasgado no relatorio nao faz mal)
+static radiosup_stats_t Stats;
+static int64_t  NextCheck;
+static int64_t  QuietSince;                   // Ultimo frame ou ultima recuperacao
+static int64_t  SilenceBase;                  // 0 = criterio desligado
+static int64_t  Silence;                      // Prazo atual (com o backoff)
+static bool     SilenceOff;                   // Teto do backoff sem frame: suspenso ate o proximo
+static uint32_t FailStreak;
+static uint32_t SilentStreak;                 // Recuperacoes por silencio sem frame entre elas
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- radiosup_init ---
+void radiosup_init(uint32_t silence_ms, int64_t now)
+{
+  memset(&Stats, 0, sizeof(Stats));
+  SilenceBase  = (int64_t)silence_ms * 1000;
+  Silence      = SilenceBase;
+  SilenceOff   = false;
+  QuietSince   = now;
+  NextCheck    = now + RADIOSUP_CHECK_MS * 1000;
+  FailStreak   = 0;
+  SilentStreak = 0;
+}//end radiosup_init
+
+//=======================================================================================================
+//--- radiosup_due ---
+bool radiosup_due(int64_t now)
+{
+  if(now < NextCheck)
+    return false;
+  NextCheck = now + RADIOSUP_CHECK_MS * 1000;
+  return true;
+}//end radiosup_due
+
+//=======================================================================================================
+//--- radiosup_regs ---
+radiosup_reason_t radiosup_regs(int version, int op_mode, int expect)
+{
+  if(version != SX1276_VERSION)
+    return RADIOSUP_VERSION;
+  if((op_mode & OP_LONG_RANGE) == 0 || (expect != RADIOSUP_ANY_MODE && op_mode != expect))
+    return RADIOSUP_MODE;
+  return RADIOSUP_OK;
+}//end radiosup_regs
+
+//=======================================================================================================
+//--- radiosup_silence ---
+// Um frame depois da ultima recuperacao prova que o radio voltou: o prazo volta ao configurado. Sem
+// nenhum frame desde o boot o silencio nao diz nada sobre o radio (last_rx_us = 0).
+radiosup_reason_t radiosup_silence(int64_t last_rx_us, int64_t now)
+{
+  if(SilenceBase == 0 || last_rx_us == 0)
+    return RADIOSUP_OK;
+  if(last_rx_us > QuietSince)
+  {
+    QuietSince   = last_rx_us;
+    Silence      = SilenceBase;
+    SilenceOff   = false;
+    SilentStreak = 0;
+  }//end if
+  if(SilenceOff)
+    return RADIOSUP_OK;
+  return now - QuietSince >= Silence ? RADIOSUP_SILENT : RADIOSUP_OK;
+}//end radiosup_silence
+
+//=======================================================================================================
+//--- radiosup_recovered ---
+// Falhas seguidas (chip sem alimentacao) so sao logadas na 1a, 2a, 4a, 8a... para nao inundar a serial;
+// recuperacoes por silencio, so a primeira de cada sequencia (o resto fica no $RADIO).
+bool radiosup_recovered(radiosup_reason_t why, bool ok, int64_t t0, int64_t t1)
+{
+  QuietSince = t1;
+  if(why == RADIOSUP_SILENT)
+  {
+    SilentStreak++;
+    if(Silence < SilenceBase * RADIOSUP_BACKOFF_MAX)
+      Silence *= 2;
+    else
+      SilenceOff = true;
+  }//end if
+  Stats.by_reason[why < RADIOSUP_REASON_COUNT ? why : RADIOSUP_OK]++;
+  Stats.last_reason = (uint8_t)why;
+  Stats.last_us     = (uint32_t)(t1 - t0);
+  Stats.last_t_us   = t1;
+  if(ok)
+  {
+    Stats.recoveries++;
+    FailStreak = 0;
+    return why != RADIOSUP_SILENT || SilentStreak == 1;
+  }//end if
+  Stats.failures++;
+  FailStreak++;
+  return (FailStreak & (FailStreak - 1)) == 0;
+}//end radiosup_recovered
+
+//=======================================================================================================
+//--- radiosup_get ---
+void radiosup_get(radiosup_stats_t *out)
+{
+  *out = Stats;
+}//end radiosup_get
+
+//=======================================================================================================
+//--- radiosup_reason_name ---
+const char *radiosup_reason_name(uint8_t why)
+{
+  return why < RADIOSUP_REASON_COUNT ? ReasonName[why] : "?";
+}//end radiosup_reason_name
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,68 @@
+//=======================================================================================================
+//
+//   Title: Radio supervisor (wedged SX1276 detection and recovery bookkeeping).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Um SX1276 travado (glitch no SPI, brownout) nao avisa: o lora_received() so devolve 0 para sempre.
+//   A task do radio chama radiosup_regs/radiosup_silence a cada volta e, quando um dos dois aponta
+//   problema, faz o lora_restart() e reaplica a configuracao guardada, sem reiniciar o ESP32.
+//     - Registros (a cada RADIOSUP_CHECK_MS): REG_VERSION diferente de 0x12 (SPI mudo le 0x00/0xFF),
+//       modo LoRa desligado em REG_OP_MODE (o chip volta do reset em FSK) ou, no RX continuo, o modo
+//       fora de RX_CONTINUOUS logo depois do lora_receive().
+//     - Silencio: nenhum frame valido de nenhum no por CONFIG_RADIO_SILENCE_MS, contado so depois do
+//       primeiro frame desde o boot. Cada recuperacao por silencio que nao traz pacote dobra o prazo
+//       (ate RADIOSUP_BACKOFF_MAX vezes); a que chega no teto e ainda nao traz nada suspende o criterio
+//       ate o proximo frame. Com os nos desligados o radio ocioso fica por conta dos registros, e so a
+//       primeira recuperacao de cada sequencia por silencio vai para o log.
+//   As contagens saem no $RADIO do instr.
+//=======================================================================================================
+
+#ifndef RADIOSUP_h
+#define RADIOSUP_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+
+//=======================================================================================================
+//--- Macros and Constants ---
+#define RADIOSUP_CHECK_MS     1000            // Leitura dos registros de controle
+#define RADIOSUP_BACKOFF_MAX  8               // Prazo maximo de silencio = 8 x CONFIG_RADIO_SILENCE_MS
+#define RADIOSUP_ANY_MODE     (-1)            // Modo do radio varia (ciclo CAD): so o bit LoRa e conferido
+
+//=======================================================================================================
+//--- Types ---
+
+typedef enum{
+    RADIOSUP_OK = 0,
+    RADIOSUP_VERSION,                         // REG_VERSION errado: SPI ou chip sem alimentacao
+    RADIOSUP_MODE,                            // REG_OP_MODE fora do esperado
+    RADIOSUP_SILENT,                          // Nenhum frame valido no prazo
+    RADIOSUP_REASON_COUNT
+}radiosup_reason_t;
+
+typedef struct{
+    uint32_t recoveries;                      // lora_restart() com o chip respondendo
+    uint32_t failures;                        // lora_restart() sem resposta (tenta de novo no proximo check)
+    uint32_t by_reason[RADIOSUP_REASON_COUNT];
+    uint8_t  last_reason;
+    uint32_t last_us;                         // Duracao da ultima recuperacao
+    int64_t  last_t_us;                       // Instante da ultima recuperacao (0 = nenhuma)
+}radiosup_stats_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void              radiosup_init(uint32_t silence_ms, int64_t now);        // 0 desliga o criterio de silencio
+bool              radiosup_due(int64_t now);                              // Hora de ler os registros?
+radiosup_reason_t radiosup_regs(int version, int op_mode, int expect);   // expect = modo ou RADIOSUP_ANY_MODE
+radiosup_reason_t radiosup_silence(int64_t last_rx_us, int64_t now);
+bool              radiosup_recovered(radiosup_reason_t why, bool ok, int64_t t0, int64_t t1);  // Vale logar?
+void              radiosup_get(radiosup_stats_t *out);
+const char       *radiosup_reason_name(uint8_t why);
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
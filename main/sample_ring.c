@@ -0,0 +1,115 @@
+//=======================================================================================================
+//
+//   Title: Sample ring (single producer, multiple readers).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include "sample_ring.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define RING_MASK (SAMPLE_RING_LEN - 1)
+
+_Static_assert((SAMPLE_RING_LEN & RING_MASK) == 0, "SAMPLE_RING_LEN deve ser potencia de 2");
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- sample_ring_init ---
+void sample_ring_init(sample_ring_t *r)
+{
+  memset(r, 0, sizeof(*r));
+  for(uint32_t i = 0; i < SAMPLE_RING_LEN; i++)
+    atomic_init(&r->slot[i].seq, 0);
+  atomic_init(&r->head, 0);
+}//end sample_ring_init
+
+//=======================================================================================================
+//--- sample_ring_push ---
+uint32_t sample_ring_push(sample_ring_t *r, const telemetry_sample_t *s)
+{
+  uint32_t       idx  = atomic_load_explicit(&r->head, memory_order_relaxed);
+  sample_slot_t *slot = &r->slot[idx & RING_MASK];
+
+  atomic_store_explicit(&slot->seq, 0, memory_order_relaxed);   // Invalida o slot para leitores em curso
+  atomic_thread_fence(memory_order_release);
+  slot->s = *s;
+  atomic_store_explicit(&slot->seq, idx + 1, memory_order_release);
+  atomic_store_explicit(&r->head, idx + 1, memory_order_release);
+  return idx;
+}//end sample_ring_push
+
+//=======================================================================================================
+//--- sample_ring_reader_init ---
+void sample_ring_reader_init(sample_ring_t *r, sample_reader_t *rd)
+{
+  rd->tail    = atomic_load_explicit(&r->head, memory_order_acquire);
+  rd->dropped = 0;
+}//end sample_ring_reader_init
+
+//=======================================================================================================
+//--- sample_ring_pop ---
+bool sample_ring_pop(sample_ring_t *r, sample_reader_t *rd, telemetry_sample_t *out)
+{
+  while(true)
+  {
+    uint32_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+    if(rd->tail == head)
+      return false;                           // Nada novo
+
+    if(head - rd->tail > SAMPLE_RING_LEN)     // Leitor ficou para tras: pula para a mais antiga ainda valida
+    {
+      rd->dropped += head - rd->tail - SAMPLE_RING_LEN;
+      rd->tail     = head - SAMPLE_RING_LEN;
+    }//end if
+
+    sample_slot_t *slot = &r->slot[rd->tail & RING_MASK];
+    uint32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    if(seq == rd->tail + 1)
+    {
+      *out = slot->s;
+      atomic_thread_fence(memory_order_acquire);
+      if(atomic_load_explicit(&slot->seq, memory_order_relaxed) == seq)
+      {
+        rd->tail++;
+        return true;
+      }//end if
+    }//end if
+
+    // Slot sobrescrito durante a leitura: descarta e tenta a proxima
+    rd->dropped++;
+    rd->tail++;
+  }//end while
+}//end sample_ring_pop
+
+//=======================================================================================================
+//--- sample_ring_latest ---
+// Para quem so quer o estado atual (LCD): nao tem cursor e nunca conta perdas.
+bool sample_ring_latest(sample_ring_t *r, telemetry_sample_t *out)
+{
+  for(int tries = 0; tries < 4; tries++)
+  {
+    uint32_t head = atomic_load_explicit(&r->head, memory_order_acquire);
+    if(head == 0)
+      return false;
+
+    sample_slot_t *slot = &r->slot[(head - 1) & RING_MASK];
+    uint32_t seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+    if(seq != head)
+      continue;                               // Produtor ja esta escrevendo a seguinte
+    *out = slot->s;
+    atomic_thread_fence(memory_order_acquire);
+    if(atomic_load_explicit(&slot->seq, memory_order_relaxed) == seq)
+      return true;
+  }//end for
+  return false;
+}//end sample_ring_latest
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,57 @@
+//=======================================================================================================
+//
+//   Title: Sample ring (single producer, multiple readers).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   O ReceiveLoraData publica cada amostra decodificada aqui; cada consumidor (uplink, LCD, ...) tem
+//   seu proprio cursor. O produtor nunca bloqueia: um leitor lento apenas perde as amostras mais
+//   antigas (contadas em 'dropped'). Cada slot tem um numero de sequencia que o leitor confere antes
+//   e depois da copia, como um seqlock, entao nao ha mutex entre os nucleos.
+//=======================================================================================================
+
+#ifndef SAMPLE_RING_h
+#define SAMPLE_RING_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "telemetry.h"
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+#define SAMPLE_RING_LEN 16                    // Potencia de 2
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    atomic_uint        seq;                   // Indice+1 da amostra armazenada, 0 durante a escrita
+    telemetry_sample_t s;
+}sample_slot_t;
+
+typedef struct{
+    sample_slot_t slot[SAMPLE_RING_LEN];
+    atomic_uint   head;                       // Total de amostras publicadas
+}sample_ring_t;
+
+typedef struct{
+    uint32_t tail;                            // Proxima amostra a ler
+    uint32_t dropped;                         // Amostras sobrescritas antes da leitura
+}sample_reader_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void sample_ring_init(sample_ring_t *r);                                           // Zera o anel
+uint32_t sample_ring_push(sample_ring_t *r, const telemetry_sample_t *s);          // Publica (um unico produtor), retorna o indice
+void sample_ring_reader_init(sample_ring_t *r, sample_reader_t *rd);               // Cursor a partir da amostra atual
+bool sample_ring_pop(sample_ring_t *r, sample_reader_t *rd, telemetry_sample_t *out); // Copia a proxima amostra
+bool sample_ring_latest(sample_ring_t *r, telemetry_sample_t *out);               // Copia a amostra mais recente
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,175 @@
+//=======================================================================================================
+//
+//   Title: Persistent receiver settings (NVS).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include "settings.h"
+#include "nvs_flash.h"
+#include "nvs.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define SETTINGS_NS "telemetry"
+static const char *TAG3 = "NVS";
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- settings_init ---
+esp_err_t settings_init(void)
+{
+  esp_err_t ret = nvs_flash_init();
+  if(ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND)
+  {
+    ESP_LOGW(TAG3, "Particao NVS invalida, apagando");
+    ESP_ERROR_CHECK(nvs_flash_erase());
+    ret = nvs_flash_init();
+  }//end if
+  return ret;
+}//end settings_init
+
+//=======================================================================================================
+//--- settings_load_station ---
+void settings_load_station(int32_t *lat_e7, int32_t *lon_e7, int32_t *alt_m)
+{
+  nvs_handle_t h;
+
+  *lat_e7 = CONFIG_GS_LAT_E7;
+  *lon_e7 = CONFIG_GS_LON_E7;
+  *alt_m  = CONFIG_GS_ALT_M;
+
+  if(nvs_open(SETTINGS_NS, NVS_READONLY, &h) != ESP_OK)
+    return;                                   // Namespace ainda nao existe: usa os defaults
+  nvs_get_i32(h, "gs_lat", lat_e7);
+  nvs_get_i32(h, "gs_lon", lon_e7);
+  nvs_get_i32(h, "gs_alt", alt_m);
+  nvs_close(h);
+}//end settings_load_station
+
+//=======================================================================================================
+//--- settings_save_station ---
+esp_err_t settings_save_station(int32_t lat_e7, int32_t lon_e7, int32_t alt_m)
+{
+  nvs_handle_t h;
+  esp_err_t ret = nvs_open(SETTINGS_NS, NVS_READWRITE, &h);
+  if(ret != ESP_OK)
+    return ret;
+
+  ret = nvs_set_i32(h, "gs_lat", lat_e7);
+  if(ret == ESP_OK) ret = nvs_set_i32(h, "gs_lon", lon_e7);
+  if(ret == ESP_OK) ret = nvs_set_i32(h, "gs_alt", alt_m);
+  if(ret == ESP_OK) ret = nvs_commit(h);
+  nvs_close(h);
+
+  if(ret != ESP_OK)
+    ESP_LOGE(TAG3, "Falha gravando estacao: %s", esp_err_to_name(ret));
+  return ret;
+}//end settings_save_station
+
+//=======================================================================================================
+//--- settings_load_link_key ---
+bool settings_load_link_key(uint8_t key[16])
+{
+  nvs_handle_t h;
+  size_t len = 16;
+
+  if(nvs_open(SETTINGS_NS, NVS_READONLY, &h) != ESP_OK)
+    return false;
+  esp_err_t ret = nvs_get_blob(h, "link_key", key, &len);
+  nvs_close(h);
+  return ret == ESP_OK && len == 16;
+}//end settings_load_link_key
+
+//=======================================================================================================
+//--- settings_save_link_key ---
+esp_err_t settings_save_link_key(const uint8_t key[16])
+{
+  nvs_handle_t h;
+  esp_err_t ret = nvs_open(SETTINGS_NS, NVS_READWRITE, &h);
+  if(ret != ESP_OK)
+    return ret;
+
+  ret = nvs_set_blob(h, "link_key", key, 16);
+  if(ret == ESP_OK) ret = nvs_commit(h);
+  nvs_close(h);
+
+  if(ret != ESP_OK)
+    ESP_LOGE(TAG3, "Falha gravando chave de enlace: %s", esp_err_to_name(ret));
+  return ret;
+}//end settings_save_link_key
+
+//=======================================================================================================
+//--- settings_load_radio_profile ---
+void settings_load_radio_profile(uint8_t *id)
+{
+  nvs_handle_t h;
+
+  if(nvs_open(SETTINGS_NS, NVS_READONLY, &h) != ESP_OK)
+    return;
+  nvs_get_u8(h, "radio_prof", id);
+  nvs_close(h);
+}//end settings_load_radio_profile
+
+//=======================================================================================================
+//--- settings_save_radio_profile ---
+esp_err_t settings_save_radio_profile(uint8_t id)
+{
+  nvs_handle_t h;
+  esp_err_t ret = nvs_open(SETTINGS_NS, NVS_READWRITE, &h);
+  if(ret != ESP_OK)
+    return ret;
+
+  ret = nvs_set_u8(h, "radio_prof", id);
+  if(ret == ESP_OK) ret = nvs_commit(h);
+  nvs_close(h);
+
+  if(ret != ESP_OK)
+    ESP_LOGE(TAG3, "Falha gravando perfil de radio: %s", esp_err_to_name(ret));
+  return ret;
+}//end settings_save_radio_profile
+
+//=======================================================================================================
+//--- settings_load_alarms ---
+// Lista vazia gravada (todas as regras apagadas) e diferente de ausente, que usa o default do menuconfig.
+int settings_load_alarms(alarm_rule_t *rules)
+{
+  nvs_handle_t h;
+  size_t len = ALARM_RULE_MAX * sizeof(alarm_rule_t);
+
+  if(nvs_open(SETTINGS_NS, NVS_READONLY, &h) != ESP_OK)
+    return -1;
+  esp_err_t ret = nvs_get_blob(h, "alarms", rules, &len);
+  nvs_close(h);
+  if(ret != ESP_OK || len % sizeof(alarm_rule_t) != 0)
+    return -1;
+  return (int)(len / sizeof(alarm_rule_t));
+}//end settings_load_alarms
+
+//=======================================================================================================
+//--- settings_save_alarms ---
+esp_err_t settings_save_alarms(const alarm_rule_t *rules, size_t n)
+{
+  nvs_handle_t h;
+  esp_err_t ret = nvs_open(SETTINGS_NS, NVS_READWRITE, &h);
+  if(ret != ESP_OK)
+    return ret;
+
+  ret = nvs_set_blob(h, "alarms", rules, n * sizeof(alarm_rule_t));
+  if(ret == ESP_OK) ret = nvs_commit(h);
+  nvs_close(h);
+
+  if(ret != ESP_OK)
+    ESP_LOGE(TAG3, "Falha gravando alarmes: %s", esp_err_to_name(ret));
+  return ret;
+}//end settings_save_alarms
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,35 @@
+//=======================================================================================================
+//
+//   Title: Persistent receiver settings (NVS).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Valores ausentes na NVS assumem os defaults do menuconfig.
+//=======================================================================================================
+
+#ifndef SETTINGS_h
+#define SETTINGS_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "alarm.h"
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+esp_err_t settings_init(void);                                                     // Inicializa a particao NVS
+void      settings_load_station(int32_t *lat_e7, int32_t *lon_e7, int32_t *alt_m); // Le a posicao da estacao
+esp_err_t settings_save_station(int32_t lat_e7, int32_t lon_e7, int32_t alt_m);    // Grava a posicao da estacao
+bool      settings_load_link_key(uint8_t key[16]);                                 // Chave do MAC de enlace (false = ausente)
+esp_err_t settings_save_link_key(const uint8_t key[16]);
+void      settings_load_radio_profile(uint8_t *id);                                // Perfil escolhido pelo console (mantem *id se ausente)
+esp_err_t settings_save_radio_profile(uint8_t id);
+int       settings_load_alarms(alarm_rule_t *rules);                               // Regras gravadas (-1 = nunca gravadas)
+esp_err_t settings_save_alarms(const alarm_rule_t *rules, size_t n);
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,219 @@
+//=======================================================================================================
+//
+//   Title: SSD1306 128x64 OLED driver (I2C) for the character display layer.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   O quadro e a propria GDDRAM: 8 paginas de 128 bytes, um byte = 8 pontos de uma coluna (bit 0 em
+//   cima). Cada celula do display.h ocupa 6 colunas de uma pagina (fonte 5x7 + 1 de espaco), o que da
+//   21x8 celulas. O blit so desenha no quadro e alarga a faixa suja da pagina; o flush manda, por
+//   pagina suja, a janela de colunas (0x21/0x22) e os bytes direto do quadro, sem copia.
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include "display.h"
+#include "lcd_jr.h"
+#include "esp_attr.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define OLED_ADDR      CONFIG_DISPLAY_I2C_ADDR
+#define OLED_W         128
+#define OLED_PAGES     8
+#define OLED_CELL_W    6
+#define OLED_COLS      (OLED_W / OLED_CELL_W)  // 21 (sobram 2 colunas a direita)
+#define OLED_CMD       0x00                    // Byte de controle: comandos
+#define OLED_DATA      0x40                    // Byte de controle: GDDRAM
+#define OLED_LINK      I2C_LINK_RECOMMENDED_SIZE(1)
+#define OLED_TIMEOUT   (1000 / portTICK_PERIOD_MS)
+static const char *TAG9 = "OLED";
+
+// Modulos 128x64 com charge pump interno (datasheet, app note de inicializacao)
+static const uint8_t InitSeq[] = {
+  OLED_CMD,
+  0xAE,                                       // Display desligado
+  0xD5, 0x80,                                 // Clock
+  0xA8, 0x3F,                                 // Multiplex 64
+  0xD3, 0x00,                                 // Sem offset
+  0x40,                                       // Linha inicial 0
+  0x8D, 0x14,                                 // Charge pump ligado
+  0x20, 0x00,                                 // Enderecamento horizontal (janela 0x21/0x22)
+  0xA1, 0xC8,                                 // Coluna 127 = SEG0, COM invertido (conector em cima)
+  0xDA, 0x12,                                 // COM alternado
+  0x81, 0xCF,                                 // Contraste
+  0xD9, 0xF1,                                 // Pre-carga
+  0xDB, 0x40,                                 // VCOMH
+  0xA4, 0xA6,                                 // Mostra a RAM, sem inverter
+  0xAF                                        // Display ligado
+};
+
+// ASCII 0x20-0x7F, 5 colunas, bit 0 em cima. 0x7E/0x7F sao as setas da ROM A00 do HD44780.
+static const uint8_t Font[96][5] = {
+  {0x00,0x00,0x00,0x00,0x00}, {0x00,0x00,0x5F,0x00,0x00}, {0x00,0x07,0x00,0x07,0x00}, {0x14,0x7F,0x14,0x7F,0x14},
+  {0x24,0x2A,0x7F,0x2A,0x12}, {0x23,0x13,0x08,0x64,0x62}, {0x36,0x49,0x55,0x22,0x50}, {0x00,0x05,0x03,0x00,0x00},
+  {0x00,0x1C,0x22,0x41,0x00}, {0x00,0x41,0x22,0x1C,0x00}, {0x14,0x08,0x3E,0x08,0x14}, {0x08,0x08,0x3E,0x08,0x08},
+  {0x00,0x50,0x30,0x00,0x00}, {0x08,0x08,0x08,0x08,0x08}, {0x00,0x60,0x60,0x00,0x00}, {0x20,0x10,0x08,0x04,0x02},
+  {0x3E,0x51,0x49,0x45,0x3E}, {0x00,0x42,0x7F,0x40,0x00}, {0x42,0x61,0x51,0x49,0x46}, {0x21,0x41,0x45,0x4B,0x31},
+  {0x18,0x14,0x12,0x7F,0x10}, {0x27,0x45,0x45,0x45,0x39}, {0x3C,0x4A,0x49,0x49,0x30}, {0x01,0x71,0x09,0x05,0x03},
+  {0x36,0x49,0x49,0x49,0x36}, {0x06,0x49,0x49,0x29,0x1E}, {0x00,0x36,0x36,0x00,0x00}, {0x00,0x56,0x36,0x00,0x00},
+  {0x08,0x14,0x22,0x41,0x00}, {0x14,0x14,0x14,0x14,0x14}, {0x00,0x41,0x22,0x14,0x08}, {0x02,0x01,0x51,0x09,0x06},
+  {0x32,0x49,0x79,0x41,0x3E}, {0x7E,0x11,0x11,0x11,0x7E}, {0x7F,0x49,0x49,0x49,0x36}, {0x3E,0x41,0x41,0x41,0x22},
+  {0x7F,0x41,0x41,0x22,0x1C}, {0x7F,0x49,0x49,0x49,0x41}, {0x7F,0x09,0x09,0x09,0x01}, {0x3E,0x41,0x49,0x49,0x7A},
+  {0x7F,0x08,0x08,0x08,0x7F}, {0x00,0x41,0x7F,0x41,0x00}, {0x20,0x40,0x41,0x3F,0x01}, {0x7F,0x08,0x14,0x22,0x41},
+  {0x7F,0x40,0x40,0x40,0x40}, {0x7F,0x02,0x0C,0x02,0x7F}, {0x7F,0x04,0x08,0x10,0x7F}, {0x3E,0x41,0x41,0x41,0x3E},
+  {0x7F,0x09,0x09,0x09,0x06}, {0x3E,0x41,0x51,0x21,0x5E}, {0x7F,0x09,0x19,0x29,0x46}, {0x46,0x49,0x49,0x49,0x31},
+  {0x01,0x01,0x7F,0x01,0x01}, {0x3F,0x40,0x40,0x40,0x3F}, {0x1F,0x20,0x40,0x20,0x1F}, {0x3F,0x40,0x38,0x40,0x3F},
+  {0x63,0x14,0x08,0x14,0x63}, {0x07,0x08,0x70,0x08,0x07}, {0x61,0x51,0x49,0x45,0x43}, {0x00,0x7F,0x41,0x41,0x00},
+  {0x02,0x04,0x08,0x10,0x20}, {0x00,0x41,0x41,0x7F,0x00}, {0x04,0x02,0x01,0x02,0x04}, {0x40,0x40,0x40,0x40,0x40},
+  {0x00,0x01,0x02,0x04,0x00}, {0x20,0x54,0x54,0x54,0x78}, {0x7F,0x48,0x44,0x44,0x38}, {0x38,0x44,0x44,0x44,0x20},
+  {0x38,0x44,0x44,0x48,0x7F}, {0x38,0x54,0x54,0x54,0x18}, {0x08,0x7E,0x09,0x01,0x02}, {0x0C,0x52,0x52,0x52,0x3E},
+  {0x7F,0x08,0x04,0x04,0x78}, {0x00,0x44,0x7D,0x40,0x00}, {0x20,0x40,0x44,0x3D,0x00}, {0x7F,0x10,0x28,0x44,0x00},
+  {0x00,0x41,0x7F,0x40,0x00}, {0x7C,0x04,0x18,0x04,0x78}, {0x7C,0x08,0x04,0x04,0x78}, {0x38,0x44,0x44,0x44,0x38},
+  {0x7C,0x14,0x14,0x14,0x08}, {0x08,0x14,0x14,0x18,0x7C}, {0x7C,0x08,0x04,0x04,0x08}, {0x48,0x54,0x54,0x54,0x20},
+  {0x04,0x3F,0x44,0x40,0x20}, {0x3C,0x40,0x40,0x20,0x7C}, {0x1C,0x20,0x40,0x20,0x1C}, {0x3C,0x40,0x30,0x40,0x3C},
+  {0x44,0x28,0x10,0x28,0x44}, {0x0C,0x50,0x50,0x50,0x3C}, {0x44,0x64,0x54,0x4C,0x44}, {0x00,0x08,0x36,0x41,0x00},
+  {0x00,0x00,0x7F,0x00,0x00}, {0x00,0x41,0x36,0x08,0x00}, {0x08,0x08,0x2A,0x1C,0x08}, {0x08,0x1C,0x2A,0x08,0x08}
+};
+
+// DISP_G_VBAR + 0..2 (de baixo) e DISP_G_BELL, mesmo desenho da CGRAM do lcd_jr.c
+static const uint8_t VBar[3] = {0xC0, 0xF0, 0xFC};
+static const uint8_t Bell[5] = {0x10, 0x1E, 0x5F, 0x1E, 0x10};
+
+//=======================================================================================================
+//--- Variaveis ---
+// So a task do menu usa o display. Word-aligned em DRAM: o flush passa o ponteiro do quadro direto ao
+// driver I2C (e a um SPI com DMA, se o modulo for o de 7 pinos).
+static DMA_ATTR uint8_t Fb[OLED_PAGES][OLED_W];
+static uint8_t DirtyLo[OLED_PAGES];           // Faixa suja por pagina (Lo > Hi = limpa)
+static uint8_t DirtyHi[OLED_PAGES];
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static esp_err_t OledInit(void);
+static void      OledBlit(uint8_t row, uint8_t col, const uint8_t *cells, uint8_t n);
+static uint32_t  OledFlush(void);
+static void      RenderCell(uint8_t *dst, uint8_t chr);    // 6 colunas de uma celula
+static void      MarkDirty(uint8_t page, uint8_t x0, uint8_t x1);
+static esp_err_t SendPage(uint8_t page, uint8_t x0, uint8_t x1);
+
+//=======================================================================================================
+//--- Driver ---
+const display_ops_t DisplaySsd1306 = {
+  .name  = "ssd1306",
+  .cols  = OLED_COLS,
+  .rows  = OLED_PAGES,
+  .init  = OledInit,
+  .blit  = OledBlit,
+  .flush = OledFlush,
+};
+
+_Static_assert(OLED_COLS <= DISP_COLS_MAX && OLED_PAGES <= DISP_ROWS_MAX, "SSD1306 maior que o quadro do display.h");
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- OledInit ---
+// A GDDRAM sai do reset com lixo: o quadro inteiro (zerado) vai no primeiro flush.
+static esp_err_t OledInit(void)
+{
+  ESP_ERROR_CHECK(I2C0_Init());
+  esp_err_t err = i2c_master_write_to_device(I2C_NUM_0, OLED_ADDR, InitSeq, sizeof(InitSeq), OLED_TIMEOUT);
+  if(err != ESP_OK)
+  {
+    ESP_LOGE(TAG9, "SSD1306 nao responde em 0x%02X: %s", OLED_ADDR, esp_err_to_name(err));
+    return err;
+  }//end if
+  memset(Fb, 0, sizeof(Fb));
+  for(uint8_t p = 0; p < OLED_PAGES; p++)
+    MarkDirty(p, 0, OLED_W - 1);
+  OledFlush();
+  return ESP_OK;
+}//end OledInit
+
+//=======================================================================================================
+//--- OledBlit ---
+static void OledBlit(uint8_t row, uint8_t col, const uint8_t *cells, uint8_t n)
+{
+  if(row >= OLED_PAGES || col >= OLED_COLS)
+    return;
+  if(n > OLED_COLS - col)
+    n = OLED_COLS - col;
+  for(uint8_t i = 0; i < n; i++)
+    RenderCell(&Fb[row][(col + i) * OLED_CELL_W], cells[i]);
+  MarkDirty(row, col * OLED_CELL_W, (col + n) * OLED_CELL_W - 1);
+}//end OledBlit
+
+//=======================================================================================================
+//--- OledFlush ---
+// Por pagina suja: 7 bytes de janela + 2 de cabecalho + a faixa. Uma celula custa 6 bytes de dado.
+static uint32_t OledFlush(void)
+{
+  uint32_t sent = 0;
+
+  for(uint8_t p = 0; p < OLED_PAGES; p++)
+  {
+    if(DirtyLo[p] > DirtyHi[p])
+      continue;
+    if(SendPage(p, DirtyLo[p], DirtyHi[p]) == ESP_OK)
+      sent += 1 + 7 + 2 + (DirtyHi[p] - DirtyLo[p] + 1);
+    DirtyLo[p] = 0xFF;
+    DirtyHi[p] = 0;
+  }//end for
+  return sent;
+}//end OledFlush
+
+//=======================================================================================================
+//--- RenderCell ---
+static void RenderCell(uint8_t *dst, uint8_t chr)
+{
+  memset(dst, 0, OLED_CELL_W);
+  if(chr >= 0x20 && chr <= 0x7F)
+    memcpy(dst, Font[chr - 0x20], 5);
+  else if(chr >= DISP_G_HBAR && chr < DISP_G_VBAR)
+    memset(dst, 0xFF, chr - DISP_G_HBAR + 1);          // 1 a 4 quintos
+  else if(chr >= DISP_G_VBAR && chr < DISP_G_BELL)
+    memset(dst, VBar[chr - DISP_G_VBAR], 5);
+  else if(chr == DISP_G_BELL)
+    memcpy(dst, Bell, 5);
+  else if(chr == DISP_FULL)
+    memset(dst, 0xFF, 5);
+}//end RenderCell
+
+//=======================================================================================================
+//--- MarkDirty ---
+static void MarkDirty(uint8_t page, uint8_t x0, uint8_t x1)
+{
+  if(x0 < DirtyLo[page] || DirtyLo[page] > DirtyHi[page])
+    DirtyLo[page] = x0;
+  if(x1 > DirtyHi[page])
+    DirtyHi[page] = x1;
+}//end MarkDirty
+
+//=======================================================================================================
+//--- SendPage ---
+// A janela limita a escrita: com o enderecamento horizontal os bytes caem em x0..x1 da pagina.
+static esp_err_t SendPage(uint8_t page, uint8_t x0, uint8_t x1)
+{
+  const uint8_t win[] = {OLED_CMD, 0x21, x0, x1, 0x22, page, page};
+  uint8_t link[OLED_LINK];
+
+  esp_err_t err = i2c_master_write_to_device(I2C_NUM_0, OLED_ADDR, win, sizeof(win), OLED_TIMEOUT);
+  if(err != ESP_OK)
+    return err;
+
+  i2c_cmd_handle_t cmd_handle = i2c_cmd_link_create_static(link, sizeof(link));
+  i2c_master_start(cmd_handle);
+  i2c_master_write_byte(cmd_handle, (OLED_ADDR << 1) | I2C_MASTER_WRITE, true);
+  i2c_master_write_byte(cmd_handle, OLED_DATA, true);
+  i2c_master_write(cmd_handle, &Fb[page][x0], x1 - x0 + 1, true);
+  i2c_master_stop(cmd_handle);
+  err = i2c_master_cmd_begin(I2C_NUM_0, cmd_handle, OLED_TIMEOUT);
+  i2c_cmd_link_delete_static(cmd_handle);
+  return err;
+}//end SendPage
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,170 @@
+//=======================================================================================================
+//
+//   Title: Receiver-driven TDMA (poll) scheduler.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include "tdma.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define TDMA_UNIT_US   100                    // Resolucao dos tempos no beacon
+#define TDMA_UNIT_MAX  0xFFFFu
+#define IDLE_NEVER     0xFF
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static uint32_t round_unit(uint32_t us);
+static void     put_u16(uint8_t *p, uint32_t us);
+static uint32_t get_u16(const uint8_t *p);
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- tdma_init ---
+void tdma_init(tdma_t *t, const radio_profile_t *prof, size_t frame_max, uint32_t guard_us,
+               uint32_t lead_us, uint32_t min_cycle_us)
+{
+  memset(t, 0, sizeof(*t));
+  memset(t->idle, IDLE_NEVER, sizeof(t->idle));
+  t->prof         = prof;
+  t->frame_max    = frame_max;
+  t->guard_us     = guard_us;
+  t->min_cycle_us = min_cycle_us;
+  t->cycle_us     = min_cycle_us;
+  t->plan.lead_us = round_unit(lead_us);
+  t->plan.seq     = 0xFF;                     // O primeiro tdma_plan anuncia o ciclo 0
+}//end tdma_init
+
+//=======================================================================================================
+//--- tdma_set_profile ---
+void tdma_set_profile(tdma_t *t, const radio_profile_t *prof)
+{
+  t->prof = prof;
+}//end tdma_set_profile
+
+//=======================================================================================================
+//--- tdma_heard ---
+void tdma_heard(tdma_t *t, uint8_t node)
+{
+  if(node < LINK_NODE_MAX)
+    t->heard |= (uint16_t)(1u << node);
+}//end tdma_heard
+
+//=======================================================================================================
+//--- tdma_plan ---
+// Slots em ordem de endereco: um no que continua ativo mantem a posicao relativa entre ciclos.
+void tdma_plan(tdma_t *t)
+{
+  tdma_beacon_t *b = &t->plan;
+
+  b->nslots = 0;
+  for(uint8_t id = 0; id < LINK_NODE_MAX; id++)
+  {
+    if(t->heard & (1u << id))
+      t->idle[id] = 0;
+    else if(t->idle[id] != IDLE_NEVER)
+      t->idle[id]++;
+    if(t->idle[id] >= TDMA_IDLE_CYCLES)
+      t->idle[id] = IDLE_NEVER;               // Libera o slot; volta pelo slot de entrada
+    if(t->idle[id] != IDLE_NEVER)
+      b->order[b->nslots++] = id;
+  }//end for
+  t->heard = 0;
+
+  // Deriva acumulada ao longo do ciclo anterior, nos dois relogios
+  uint32_t drift = (uint32_t)(((uint64_t)t->cycle_us * TDMA_DRIFT_PPM * 2) / 1000000u);
+  b->guard_us  = round_unit(t->guard_us + drift);
+  b->slot_us   = round_unit(radio_airtime_us(t->prof, t->frame_max) + b->guard_us);
+  b->seq++;
+  t->beacon_us = radio_airtime_us(t->prof, LINK_HDR_LEN + TDMA_BEACON_FIXED + b->nslots);
+
+  uint32_t cycle = t->beacon_us + b->lead_us + (uint32_t)(b->nslots + 1) * b->slot_us;
+  t->cycle_us = cycle > t->min_cycle_us ? cycle : t->min_cycle_us;
+}//end tdma_plan
+
+//=======================================================================================================
+//--- tdma_beacon_encode ---
+size_t tdma_beacon_encode(const tdma_t *t, uint8_t *buf, size_t size)
+{
+  const tdma_beacon_t *b = &t->plan;
+  size_t len = LINK_HDR_LEN + TDMA_BEACON_FIXED + b->nslots;
+
+  if(size < len)
+    return 0;
+  uint8_t *p = buf + link_encode_hdr(buf, LINK_T_BEACON, 0, 0, b->seq);
+  put_u16(p + 0, b->slot_us);
+  put_u16(p + 2, b->guard_us);
+  put_u16(p + 4, b->lead_us);
+  p[6] = b->nslots;
+  memcpy(p + TDMA_BEACON_FIXED, b->order, b->nslots);
+  return len;
+}//end tdma_beacon_encode
+
+//=======================================================================================================
+//--- tdma_beacon_decode ---
+bool tdma_beacon_decode(const link_frame_t *f, tdma_beacon_t *out)
+{
+  const uint8_t *p = f->payload;
+
+  if(!f->has_hdr || f->type != LINK_T_BEACON || f->plen < TDMA_BEACON_FIXED)
+    return false;
+  if(p[6] > TDMA_SLOTS_MAX || f->plen < (size_t)TDMA_BEACON_FIXED + p[6])
+    return false;
+  out->seq      = f->seq;
+  out->slot_us  = get_u16(p + 0);
+  out->guard_us = get_u16(p + 2);
+  out->lead_us  = get_u16(p + 4);
+  out->nslots   = p[6];
+  memcpy(out->order, p + TDMA_BEACON_FIXED, out->nslots);
+  return out->slot_us > out->guard_us;
+}//end tdma_beacon_decode
+
+//=======================================================================================================
+//--- tdma_tx_offset_us ---
+uint32_t tdma_tx_offset_us(const tdma_beacon_t *b, uint8_t node)
+{
+  uint8_t slot = b->nslots;                   // Sem slot proprio: entrada
+
+  for(uint8_t i = 0; i < b->nslots; i++)
+  {
+    if(b->order[i] == node)
+    {
+      slot = i;
+      break;
+    }//end if
+  }//end for
+  return b->lead_us + (uint32_t)slot * b->slot_us + b->guard_us / 2;
+}//end tdma_tx_offset_us
+
+//=======================================================================================================
+//--- round_unit ---
+// Arredonda para cima na resolucao do beacon, para receptor e transmissor usarem o mesmo valor
+static uint32_t round_unit(uint32_t us)
+{
+  uint32_t units = (us + TDMA_UNIT_US - 1) / TDMA_UNIT_US;
+  return (units > TDMA_UNIT_MAX ? TDMA_UNIT_MAX : units) * TDMA_UNIT_US;
+}//end round_unit
+
+//=======================================================================================================
+//--- put_u16 / get_u16 ---
+static void put_u16(uint8_t *p, uint32_t us)
+{
+  uint32_t units = us / TDMA_UNIT_US;
+  p[0] = (uint8_t)units;
+  p[1] = (uint8_t)(units >> 8);
+}//end put_u16
+
+static uint32_t get_u16(const uint8_t *p)
+{
+  return ((uint32_t)p[0] | ((uint32_t)p[1] << 8)) * TDMA_UNIT_US;
+}//end get_u16
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,82 @@
+//=======================================================================================================
+//
+//   Title: Receiver-driven TDMA (poll) scheduler.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   A cada ciclo o receptor transmite um beacon (LINK_T_BEACON) com a atribuicao de slots:
+//
+//     | beacon | lead | slot 0 | slot 1 | ... | slot n-1 | entrada |      (ate o proximo beacon)
+//
+//   Os tempos contam a partir do fim do beacon (RxDone no transmissor, TxDone no receptor).
+//   'lead' cobre a virada TX->RX do receptor. Cada slot = tempo no ar do maior frame + guarda; o
+//   transmissor comeca guard/2 depois do inicio do seu slot. Quem nao esta na lista usa o slot de
+//   entrada (contencao, com backoff exponencial binario de ate TDMA_JOIN_WINDOW_MAX ciclos no
+//   transmissor); ao ser ouvido ganha slot proprio no ciclo seguinte e o perde apos
+//   TDMA_IDLE_CYCLES ciclos em silencio. Os slots sao recalculados a cada ciclo a partir do perfil
+//   de radio ativo, entao trocar SF/BW ajusta o plano sem mexer nos transmissores.
+//
+//   Payload do beacon (apos o cabecalho de enlace, seq = numero do ciclo), tempos em 100 us:
+//     [slot lo][slot hi][guard lo][guard hi][lead lo][lead hi][n][no 0]...[no n-1]
+//=======================================================================================================
+
+#ifndef TDMA_h
+#define TDMA_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "link.h"
+#include "radio.h"
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+#define TDMA_SLOTS_MAX       LINK_NODE_MAX
+#define TDMA_IDLE_CYCLES     8                // Ciclos sem ouvir o no ate liberar o slot
+#define TDMA_DRIFT_PPM       40               // Cristal do transmissor + receptor, pior caso
+#define TDMA_JOIN_WINDOW_MAX 32               // Maior janela de backoff no slot de entrada (ciclos)
+#define TDMA_BEACON_FIXED    7
+#define TDMA_BEACON_MAX      (LINK_HDR_LEN + TDMA_BEACON_FIXED + TDMA_SLOTS_MAX)
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    uint32_t slot_us;
+    uint32_t guard_us;
+    uint32_t lead_us;                         // Fim do beacon -> inicio do slot 0
+    uint8_t  seq;                             // Numero do ciclo
+    uint8_t  nslots;                          // Slots atribuidos; o slot 'nslots' e o de entrada
+    uint8_t  order[TDMA_SLOTS_MAX];           // order[i] = no dono do slot i
+}tdma_beacon_t;
+
+typedef struct{
+    const radio_profile_t *prof;
+    size_t        frame_max;                  // Maior frame de telemetria (com cabecalho)
+    uint32_t      guard_us;                   // Guarda configurada (sem a deriva)
+    uint32_t      min_cycle_us;               // Limita a taxa por no
+    uint32_t      beacon_us;                  // Tempo no ar do beacon
+    uint32_t      cycle_us;                   // Beacon + lead + slots + entrada
+    uint16_t      heard;                      // Nos ouvidos no ciclo corrente (bitmask)
+    uint8_t       idle[LINK_NODE_MAX];        // Ciclos em silencio; 0xFF = nunca ouvido
+    tdma_beacon_t plan;                       // Plano anunciado no ultimo beacon
+}tdma_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void     tdma_init(tdma_t *t, const radio_profile_t *prof, size_t frame_max, uint32_t guard_us,
+                   uint32_t lead_us, uint32_t min_cycle_us);
+void     tdma_set_profile(tdma_t *t, const radio_profile_t *prof);          // Vale a partir do proximo ciclo
+void     tdma_heard(tdma_t *t, uint8_t node);                               // Frame recebido do no
+void     tdma_plan(tdma_t *t);                                              // Fecha o ciclo e monta o proximo
+size_t   tdma_beacon_encode(const tdma_t *t, uint8_t *buf, size_t size);    // Beacon completo (com cabecalho)
+bool     tdma_beacon_decode(const link_frame_t *f, tdma_beacon_t *out);     // Lado do transmissor/simulador
+uint32_t tdma_tx_offset_us(const tdma_beacon_t *b, uint8_t node);           // Fim do beacon -> inicio da TX do no
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,218 @@
+//=======================================================================================================
+//
+//   Title: Telemetry frame decoder.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include "telemetry.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+
+// Delimitadores na ordem em que aparecem no frame. O campo i termina no delimitador i.
+static const char FRAME_DELIM[] = {'!','@','#','C','A','&','*','(',')','B','E'};
+
+#define FRAME_FIELDS   (sizeof(FRAME_DELIM))
+#define COORD_FRAC_MAX 5                      // Casas decimais dos minutos aproveitadas (1e-5 min ~ 2 cm)
+
+enum{
+  F_PITCH = 0, F_ROLL, F_TEMP, F_PRESSURE, F_LAT, F_LAT_DIR, F_LON, F_LON_DIR, F_ALT, F_SPEED, F_SNR
+};
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static bool parse_float(const char *s, size_t len, float *out);
+static bool parse_uint(const char *s, size_t len, uint32_t *out);
+static char parse_hemi(const char *s, size_t len);
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- telemetry_parse ---
+// Percorre o frame uma unica vez procurando cada delimitador a partir do anterior, de modo que um
+// 'E' de longitude ou um 'A'/'C' fora de ordem nao confunda a separacao dos campos.
+bool telemetry_parse(const char *frame, size_t len, telemetry_sample_t *out)
+{
+  const char *field[FRAME_FIELDS];
+  size_t      flen[FRAME_FIELDS];
+  const char *p   = frame;
+  const char *end = frame + len;
+
+  for(size_t i = 0; i < FRAME_FIELDS; i++)
+  {
+    const char *d = p;
+    while(d < end && *d != FRAME_DELIM[i])
+      d++;
+    if(d >= end)
+      return false;                           // Frame incompleto
+    field[i] = p;
+    flen[i]  = (size_t)(d - p);
+    p = d + 1;
+  }//end for
+
+  telemetry_sample_t s = {0};
+  uint32_t snr;
+
+  if(!parse_float(field[F_PITCH], flen[F_PITCH], &s.anglePitchDeg)) return false;
+  if(!parse_float(field[F_ROLL],  flen[F_ROLL],  &s.angleRollDeg))  return false;
+  if(!parse_float(field[F_TEMP],  flen[F_TEMP],  &s.temp))          return false;
+  if(!parse_uint(field[F_PRESSURE], flen[F_PRESSURE], &s.pressure_bmp)) return false;
+  if(!parse_float(field[F_ALT],   flen[F_ALT],   &s.altitude))      return false;
+  if(!parse_float(field[F_SPEED], flen[F_SPEED], &s.speed))         return false;
+  if(!parse_uint(field[F_SNR],    flen[F_SNR],   &snr))             return false;
+  s.SNR = (uint8_t)snr;
+
+  // Sem fix de GPS o transmissor envia os campos vazios; isso nao invalida o restante do frame.
+  s.lat_e7 = telemetry_parse_coord(field[F_LAT], flen[F_LAT], parse_hemi(field[F_LAT_DIR], flen[F_LAT_DIR]));
+  s.lon_e7 = telemetry_parse_coord(field[F_LON], flen[F_LON], parse_hemi(field[F_LON_DIR], flen[F_LON_DIR]));
+  if(s.lat_e7 != TELEM_COORD_INVALID && s.lon_e7 != TELEM_COORD_INVALID)
+    s.flags |= TELEM_FLAG_FIX;
+
+  *out = s;
+  return true;
+}//end telemetry_parse
+
+//=======================================================================================================
+//--- telemetry_parse_coord ---
+// ddmm.mmmmm (lat) ou dddmm.mmmmm (lon) -> graus * 1e7, sem ponto flutuante:
+//   graus_e7 = graus * 1e7 + minutos_e5 * 1e7 / (60 * 1e5) = graus * 1e7 + minutos_e5 * 5 / 3
+int32_t telemetry_parse_coord(const char *str, size_t len, char hemi)
+{
+  int32_t maxDeg;
+  bool    neg;
+
+  switch(hemi)
+  {
+    case 'N': maxDeg = 90;  neg = false; break;
+    case 'S': maxDeg = 90;  neg = true;  break;
+    case 'E': maxDeg = 180; neg = false; break;
+    case 'W': maxDeg = 180; neg = true;  break;
+    default:  return TELEM_COORD_INVALID;
+  }//end switch
+
+  size_t   i = 0;
+  uint32_t whole = 0;
+  size_t   nWhole = 0;
+  while(i < len && str[i] >= '0' && str[i] <= '9')
+  {
+    if(++nWhole > 5)
+      return TELEM_COORD_INVALID;
+    whole = whole * 10 + (uint32_t)(str[i] - '0');
+    i++;
+  }//end while
+  if(nWhole < 3)                              // No minimo 1 digito de grau e 2 de minuto
+    return TELEM_COORD_INVALID;
+
+  uint32_t frac = 0;
+  size_t   nFrac = 0;
+  if(i < len && str[i] == '.')
+  {
+    i++;
+    while(i < len && str[i] >= '0' && str[i] <= '9')
+    {
+      if(nFrac < COORD_FRAC_MAX)
+      {
+        frac = frac * 10 + (uint32_t)(str[i] - '0');
+        nFrac++;
+      }//end if
+      i++;
+    }//end while
+  }//end if
+  if(i != len)
+    return TELEM_COORD_INVALID;
+  for(; nFrac < COORD_FRAC_MAX; nFrac++)
+    frac *= 10;
+
+  uint32_t deg = whole / 100;
+  uint32_t min = whole % 100;
+  if(min >= 60 || deg > (uint32_t)maxDeg)
+    return TELEM_COORD_INVALID;
+
+  uint32_t min_e5 = min * 100000u + frac;
+  int32_t  value  = (int32_t)(deg * 10000000u + (min_e5 * 5u + 1u) / 3u);
+  if(value > maxDeg * 10000000)
+    return TELEM_COORD_INVALID;
+
+  return neg ? -value : value;
+}//end telemetry_parse_coord
+
+//=======================================================================================================
+//--- parse_float ---
+// Conversao decimal simples ([-]ddd[.ddd]); evita copiar o campo para um buffer so para chamar atof.
+static bool parse_float(const char *s, size_t len, float *out)
+{
+  size_t i = 0;
+  bool   neg = false;
+
+  if(i < len && (s[i] == '-' || s[i] == '+'))
+  {
+    neg = (s[i] == '-');
+    i++;
+  }//end if
+
+  int32_t  ip = 0;
+  uint32_t fp = 0;
+  uint32_t scale = 1;
+  size_t   digits = 0;
+
+  while(i < len && s[i] >= '0' && s[i] <= '9')
+  {
+    if(ip < 100000000)
+      ip = ip * 10 + (s[i] - '0');
+    i++;
+    digits++;
+  }//end while
+  if(i < len && s[i] == '.')
+  {
+    i++;
+    while(i < len && s[i] >= '0' && s[i] <= '9')
+    {
+      if(scale < 1000000)
+      {
+        fp = fp * 10 + (uint32_t)(s[i] - '0');
+        scale *= 10;
+      }//end if
+      i++;
+      digits++;
+    }//end while
+  }//end if
+  if(digits == 0 || i != len)
+    return false;
+
+  float v = (float)ip + (float)fp / (float)scale;
+  *out = neg ? -v : v;
+  return true;
+}//end parse_float
+
+//=======================================================================================================
+//--- parse_uint ---
+static bool parse_uint(const char *s, size_t len, uint32_t *out)
+{
+  uint32_t v = 0;
+
+  if(len == 0 || len > 10)
+    return false;
+  for(size_t i = 0; i < len; i++)
+  {
+    if(s[i] < '0' || s[i] > '9')
+      return false;
+    v = v * 10 + (uint32_t)(s[i] - '0');
+  }//end for
+  *out = v;
+  return true;
+}//end parse_uint
+
+//=======================================================================================================
+//--- parse_hemi ---
+static char parse_hemi(const char *s, size_t len)
+{
+  return len == 1 ? s[0] : '\0';
+}//end parse_hemi
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,77 @@
+//=======================================================================================================
+//
+//   Title: Telemetry frame decoder.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Decodifica o frame ASCII enviado pelo transmissor:
+//     pitch!roll@temp#pressaoC<lat>A<N|S>&<lon>*<E|W>(altitude)velocidadeB<snr>E
+//   Latitude/longitude chegam no formato NMEA (ddmm.mmmm / dddmm.mmmm) e sao
+//   convertidas uma unica vez para inteiros em 1e-7 graus.
+//=======================================================================================================
+
+#ifndef TELEMETRY_h
+#define TELEMETRY_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+//=======================================================================================================
+//--- Macros and Constants ---
+
+#define TELEM_COORD_INVALID INT32_MIN         // Coordenada ausente ou mal formada
+
+#define TELEM_FLAG_FIX      0x01              // lat/lon validos nesta amostra
+#define TELEM_FLAG_GEO      0x02              // range/bearing/elevation calculados
+#define TELEM_FLAG_TTX      0x04              // t_tx_us veio no frame (relogio do transmissor)
+#define TELEM_FLAG_TSYNC    0x08              // t_sample_us mapeado do relogio do transmissor (timesync.h)
+#define TELEM_FLAG_LAUNCH   0x10              // Lancamento detectado nesta amostra (metrics.h)
+#define TELEM_FLAG_APOGEE   0x20              // Apogeu detectado nesta amostra
+#define TELEM_FLAG_LANDED   0x40              // Pouso detectado nesta amostra
+#define TELEM_FLAG_ALARM    0x80              // Alguma regra de alarme ativa no no (alarm.h)
+#define TELEM_FLAG_LATE     0x100             // Liberada fora de ordem (ARQ) ou refeita (FEC): fora dos filtros
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    float    anglePitchDeg;
+    float    angleRollDeg;
+    float    temp;
+    uint32_t pressure_bmp;
+    int32_t  lat_e7;                          // Latitude em 1e-7 graus (+N / -S)
+    int32_t  lon_e7;                          // Longitude em 1e-7 graus (+E / -W)
+    float    altitude;
+    float    speed;
+    float    range_m;                         // Distancia horizontal ate a estacao
+    float    bearing_deg;                     // Rumo a partir da estacao, 0..360 (norte = 0)
+    float    elevation_deg;                   // Elevacao vista da antena da estacao
+    float    vspeed;                          // Velocidade vertical filtrada, m/s (metrics.h)
+    float    alt_max;                         // Maior altitude filtrada do voo
+    float    apogee_s;                        // Lancamento -> apogeu (0 antes do apogeu)
+    float    pitch_avg;                       // Media exponencial de pitch/roll
+    float    roll_avg;
+    int64_t  t_rx_us;                         // esp_timer no RxDone (DIO0)
+    int64_t  t_parse_us;                      // esp_timer ao fim da decodificacao
+    int64_t  t_sample_us;                     // Instante da medida no relogio do receptor (ver RxSample)
+    uint32_t t_tx_us;                         // Relogio do transmissor na medida (com TELEM_FLAG_TTX)
+    int16_t  rssi;                            // RSSI do pacote no receptor (dBm)
+    uint16_t alarms;                          // Regras de alarme ativas no no (bit = indice da regra)
+    uint8_t  node;                            // Endereco do transmissor (cabecalho de enlace)
+    uint8_t  SNR;
+    uint16_t flags;                           // TELEM_FLAG_*
+    uint8_t  phase;                           // metrics_phase_t
+}telemetry_sample_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+bool    telemetry_parse(const char *frame, size_t len, telemetry_sample_t *out);  // Decodifica um frame completo
+int32_t telemetry_parse_coord(const char *str, size_t len, char hemi);             // NMEA ddmm.mmmm + hemisferio -> 1e-7 graus
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
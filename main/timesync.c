@@ -0,0 +1,80 @@
+//=======================================================================================================
+//
+//   Title: Transmitter -> receiver clock mapping.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include "timesync.h"
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- timesync_reset ---
+void timesync_reset(timesync_t *t)
+{
+  memset(t, 0, sizeof(*t));
+}//end timesync_reset
+
+//=======================================================================================================
+//--- timesync_update ---
+// A deriva segue o erro de previsao dividido pelo intervalo entre sincronismos, com ganho 1/4: o
+// jitter do carimbo (alguns us) pesa pouco quando os sincronismos estao a segundos de distancia.
+bool timesync_update(timesync_t *t, const uint8_t *payload, size_t len, int64_t rx_pre_end_us)
+{
+  if(len != TIMESYNC_PAYLOAD)
+    return false;
+  uint32_t tx = (uint32_t)payload[0] | (uint32_t)payload[1] << 8 | (uint32_t)payload[2] << 16 |
+                (uint32_t)payload[3] << 24;
+
+  int64_t predicted;
+  if(timesync_map(t, tx, &predicted))
+  {
+    int64_t err     = rx_pre_end_us - predicted;
+    int32_t elapsed = (int32_t)(tx - t->tx_us);
+    if(err > TIMESYNC_RESET_US || err < -TIMESYNC_RESET_US || elapsed <= 0)
+    {
+      t->resets++;
+      t->valid = false;
+    }//end if
+    else
+    {
+      int64_t skew = t->skew_ppb + err * 1000000000 / elapsed / 4;
+      if(skew > TIMESYNC_SKEW_MAX)
+        skew = TIMESYNC_SKEW_MAX;
+      if(skew < -TIMESYNC_SKEW_MAX)
+        skew = -TIMESYNC_SKEW_MAX;
+      t->skew_ppb = (int32_t)skew;
+      t->err_us   = (int32_t)err;
+    }//end else
+  }//end if
+  if(!t->valid)
+  {
+    t->skew_ppb = 0;
+    t->err_us   = 0;
+    t->valid    = true;
+  }//end if
+  t->tx_us = tx;
+  t->rx_us = rx_pre_end_us;
+  t->syncs++;
+  return true;
+}//end timesync_update
+
+//=======================================================================================================
+//--- timesync_map ---
+bool timesync_map(const timesync_t *t, uint32_t tx_us, int64_t *rx_us)
+{
+  if(!t->valid)
+    return false;
+  int64_t d = (int32_t)(tx_us - t->tx_us);                  // Diferenca com sinal: atravessa a volta do u32
+  *rx_us = t->rx_us + d + d * t->skew_ppb / 1000000000;
+  return true;
+}//end timesync_map
+
+//=======================================================================================================
+//--- End of Program ---
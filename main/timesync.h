@@ -0,0 +1,55 @@
+//=======================================================================================================
+//
+//   Title: Transmitter -> receiver clock mapping.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Sincronismo opcional, de uma via: o transmissor manda um frame LINK_T_TIME cujo payload e o seu
+//   relogio (u32 little-endian, us) no fim do preambulo desse frame (inicio do TX + preambulo + sync
+//   word, que ele conhece). O receptor tem o mesmo instante no seu relogio pelo RxDone corrigido
+//   (radio_preamble_end_us), que nao depende do tamanho do preambulo; a propagacao (3 us por km)
+//   fica de fora. Com dois ou mais sincronismos estima tambem a deriva entre os cristais.
+//
+//   Amostras binarias (delta.h) podem levar o relogio do transmissor no instante da medida
+//   (TELEM_FLAG_TTX); timesync_map leva esse valor para o relogio do receptor. O u32 da a volta em
+//   71 min, entao o mapeamento vale por +-35 min a partir do ultimo sincronismo.
+//=======================================================================================================
+
+#ifndef TIMESYNC_h
+#define TIMESYNC_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+//=======================================================================================================
+//--- Macros and Constants ---
+#define TIMESYNC_PAYLOAD   4                  // Relogio do transmissor, u32 LE
+#define TIMESYNC_RESET_US  50000              // Erro acima disso = relogio reiniciado: recomeca
+#define TIMESYNC_SKEW_MAX  500000             // +-500 ppm (em ppb)
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    bool     valid;
+    uint32_t tx_us;                           // Relogio do transmissor no ultimo sincronismo
+    int64_t  rx_us;                           // O mesmo instante no relogio do receptor
+    int32_t  skew_ppb;                        // Deriva estimada (transmissor lento > 0)
+    int32_t  err_us;                          // Medido - previsto no ultimo sincronismo
+    uint32_t syncs;
+    uint32_t resets;
+}timesync_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void timesync_reset(timesync_t *t);
+bool timesync_update(timesync_t *t, const uint8_t *payload, size_t len, int64_t rx_pre_end_us);  // Frame LINK_T_TIME
+bool timesync_map(const timesync_t *t, uint32_t tx_us, int64_t *rx_us);                          // false sem sincronismo
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
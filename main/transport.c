@@ -0,0 +1,157 @@
+//=======================================================================================================
+//
+//   Title: Uplink transport (UART, USB-CDC, USB-Serial-JTAG) and log channel.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/ringbuf.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include "transport.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#define UPLINK_WAIT_MS 100                    // Maximo que uma amostra espera por espaco no buffer
+#define LOG_LINE       160
+static const char *TAG7 = "TRANSPORT";
+
+#if defined CONFIG_UPLINK_PORT_USB_CDC
+#define UPLINK_OPS TransportUsbCdc
+#elif defined CONFIG_UPLINK_PORT_USB_JTAG
+#define UPLINK_OPS TransportUsbJtag
+#else
+#define UPLINK_OPS TransportUart
+#endif
+
+//=======================================================================================================
+//--- Variaveis ---
+static const transport_ops_t *Port = &UPLINK_OPS;
+static bool                   Ready;
+static volatile uint32_t      Bytes, Dropped, LogDropped;
+#if CONFIG_UPLINK_LOG_BUFFER > 0
+static RingbufHandle_t        LogRing;
+static uint8_t                LogRingBuf[(CONFIG_UPLINK_LOG_BUFFER + 3) & ~3];   // Tamanho alinhado a 4, exigido pelo ringbuf
+static StaticRingbuffer_t     LogRingCtl;
+static StackType_t            LogStack[CONFIG_STACK_LOG];
+static StaticTask_t           LogTcb;
+#endif
+
+//=======================================================================================================
+//--- Functions prototypes ---
+#if CONFIG_UPLINK_LOG_BUFFER > 0
+static int  LogVprintf(const char *fmt, va_list ap);
+static void LogTask(void *p);
+#endif
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- transport_start ---
+esp_err_t transport_start(void)
+{
+  esp_err_t ret = Port->init(CONFIG_UPLINK_TX_BUFFER);
+  if(ret != ESP_OK)
+  {
+    ESP_LOGE(TAG7, "Porta %s: %s", Port->name, esp_err_to_name(ret));
+    return ret;
+  }//end if
+  Ready = true;
+
+#if CONFIG_UPLINK_LOG_BUFFER > 0
+  LogRing = xRingbufferCreateStatic(sizeof(LogRingBuf), RINGBUF_TYPE_NOSPLIT, LogRingBuf, &LogRingCtl);
+  if(LogRing)
+  {
+    xTaskCreateStaticPinnedToCore(LogTask,"Log",sizeof(LogStack),NULL,CONFIG_PRIO_LOG,LogStack,&LogTcb,CONFIG_APP_CORE);
+    esp_log_set_vprintf(LogVprintf);
+  }//end if
+#endif
+  ESP_LOGI(TAG7, "Uplink pela porta %s", Port->name);
+  return ESP_OK;
+}//end transport_start
+
+//=======================================================================================================
+//--- transport_write ---
+size_t transport_write(const void *buf, size_t len)
+{
+  size_t n = Ready ? Port->write(buf, len, UPLINK_WAIT_MS) : 0;
+  Bytes   += n;
+  Dropped += len - n;
+  return n;
+}//end transport_write
+
+//=======================================================================================================
+//--- transport_flush ---
+esp_err_t transport_flush(uint32_t timeout_ms)
+{
+  if(!Ready)
+    return ESP_ERR_INVALID_STATE;
+  return Port->flush ? Port->flush(timeout_ms) : ESP_ERR_NOT_SUPPORTED;
+}//end transport_flush
+
+//=======================================================================================================
+//--- transport_name ---
+const char *transport_name(void)
+{
+  return Port->name;
+}//end transport_name
+
+//=======================================================================================================
+//--- transport_get ---
+void transport_get(transport_stats_t *out)
+{
+  out->bytes       = Bytes;
+  out->dropped     = Dropped;
+  out->log_dropped = LogDropped;
+}//end transport_get
+
+#if CONFIG_UPLINK_LOG_BUFFER > 0
+//=======================================================================================================
+//--- LogVprintf ---
+// Roda na task que logou: so formata e copia para o anel, sem esperar.
+static int LogVprintf(const char *fmt, va_list ap)
+{
+  char line[LOG_LINE];
+  int  n = vsnprintf(line, sizeof(line), fmt, ap);
+
+  if(n <= 0)
+    return n;
+  size_t len = (size_t)n;
+  if(len >= sizeof(line))
+  {
+    len = sizeof(line) - 1;
+    line[len - 1] = '\n';                                   // Linha cortada, mas ainda uma linha
+  }//end if
+  if(xRingbufferSend(LogRing, line, len, 0) != pdTRUE)
+    LogDropped++;
+  return n;
+}//end LogVprintf
+
+//=======================================================================================================
+//--- LogTask ---
+// Um write() por linha: o VFS segura a porta durante a chamada, entao a linha sai inteira.
+static void LogTask(void *p)
+{
+  while(true)
+  {
+    size_t len;
+    char  *item = xRingbufferReceive(LogRing, &len, portMAX_DELAY);
+    if(item == NULL)
+      continue;
+    write(STDOUT_FILENO, item, len);
+    vRingbufferReturnItem(LogRing, item);
+  }//end while
+}//end LogTask
+#endif
+
+//=======================================================================================================
+//--- End of Program ---
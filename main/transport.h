@@ -0,0 +1,60 @@
+//=======================================================================================================
+//
+//   Title: Uplink transport (UART, USB-CDC, USB-Serial-JTAG) and log channel.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   O DataExcel escreve as amostras pela porta escolhida no menuconfig (transport_write). Cada porta
+//   copia para um buffer grande de TX e o hardware escoa sozinho (anel + ISR na UART, DMA do USB),
+//   entao uma rajada de amostras so espera quando o buffer enche.
+//
+//   Canal de log: o ESP_LOG passa por um anel proprio (CONFIG_UPLINK_LOG_BUFFER) e uma task de
+//   prioridade minima escreve linha a linha no stdout. Quem loga nunca bloqueia na serial (com o anel
+//   cheio a linha e descartada e contada) e as linhas nao se misturam com as amostras. Com a porta USB
+//   as amostras saem sozinhas no USB e o stdout (logs, '$' do instr e '$CMD' do console) fica na UART.
+//=======================================================================================================
+
+#ifndef TRANSPORT_h
+#define TRANSPORT_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+//=======================================================================================================
+//--- Types ---
+
+typedef struct{
+    const char *name;                                           // "uart", "usbcdc", "usbjtag"
+    esp_err_t (*init)(size_t tx_buffer);
+    size_t    (*write)(const void *buf, size_t len, uint32_t timeout_ms);  // len (linha inteira no buffer) ou 0
+    esp_err_t (*flush)(uint32_t timeout_ms);                    // Espera o buffer esvaziar (NULL = sem suporte)
+}transport_ops_t;
+
+typedef struct{
+    uint32_t bytes;                           // Aceitos pela porta
+    uint32_t dropped;                         // Descartados por timeout (porta parada ou host ausente)
+    uint32_t log_dropped;                     // Linhas de log descartadas com o anel cheio
+}transport_stats_t;
+
+//=======================================================================================================
+//--- Backends ---
+
+extern const transport_ops_t TransportUart;
+extern const transport_ops_t TransportUsbCdc;
+extern const transport_ops_t TransportUsbJtag;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+esp_err_t   transport_start(void);                              // Porta do menuconfig + canal de log
+size_t      transport_write(const void *buf, size_t len);
+esp_err_t   transport_flush(uint32_t timeout_ms);
+const char *transport_name(void);
+void        transport_get(transport_stats_t *out);
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
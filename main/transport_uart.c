@@ -0,0 +1,86 @@
+//=======================================================================================================
+//
+//   Title: Uplink transport - console UART backend.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/uart.h"
+#include "esp_vfs_dev.h"
+#include "sdkconfig.h"
+#include "transport.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+#if CONFIG_ESP_CONSOLE_UART_NUM >= 0
+#define UPLINK_UART CONFIG_ESP_CONSOLE_UART_NUM
+#else
+#define UPLINK_UART 0                         // Console no USB: uplink na UART0
+#endif
+#ifndef CONFIG_UPLINK_UART_BAUD
+#define CONFIG_UPLINK_UART_BAUD 115200
+#endif
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static esp_err_t UartInit(size_t tx_buffer);
+static size_t    UartWrite(const void *buf, size_t len, uint32_t timeout_ms);
+static esp_err_t UartFlush(uint32_t timeout_ms);
+
+const transport_ops_t TransportUart = {"uart", UartInit, UartWrite, UartFlush};
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- UartInit ---
+// O driver fica com o anel de TX; o stdout passa a usar o mesmo driver, senao o printf escreveria
+// direto no FIFO no meio de uma linha do uplink. O RX (256) e o do console.
+static esp_err_t UartInit(size_t tx_buffer)
+{
+  esp_err_t ret = uart_driver_install(UPLINK_UART, 256, tx_buffer, 0, NULL, 0);
+  if(ret != ESP_OK)
+    return ret;
+  uart_set_baudrate(UPLINK_UART, CONFIG_UPLINK_UART_BAUD);
+  esp_vfs_dev_uart_use_driver(UPLINK_UART);
+  return ESP_OK;
+}//end UartInit
+
+//=======================================================================================================
+//--- UartWrite ---
+// Tudo ou nada: um registro cortado sem '\n' emendaria com o proximo no PC. uart_write_bytes bloqueia
+// ate caber tudo (sem timeout no driver), entao so e chamado quando o anel ja tem espaco para a linha
+// inteira; ate la espera no maximo timeout_ms e, sem espaco, a linha e descartada (0).
+static size_t UartWrite(const void *buf, size_t len, uint32_t timeout_ms)
+{
+  TickType_t start = xTaskGetTickCount();
+
+  while(true)
+  {
+    size_t room = 0;
+    uart_get_tx_buffer_free_size(UPLINK_UART, &room);
+    if(room >= len)
+    {
+      int n = uart_write_bytes(UPLINK_UART, buf, len);
+      return n == (int)len ? len : 0;
+    }//end if
+    if(xTaskGetTickCount() - start >= pdMS_TO_TICKS(timeout_ms))
+      return 0;
+    vTaskDelay(1);                            // Um byte a 115200 leva ~87 us: um tick libera ~115 bytes
+  }//end while
+}//end UartWrite
+
+//=======================================================================================================
+//--- UartFlush ---
+static esp_err_t UartFlush(uint32_t timeout_ms)
+{
+  return uart_wait_tx_done(UPLINK_UART, pdMS_TO_TICKS(timeout_ms));
+}//end UartFlush
+
+//=======================================================================================================
+//--- End of Program ---
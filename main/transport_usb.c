@@ -0,0 +1,124 @@
+//=======================================================================================================
+//
+//   Title: Uplink transport - USB backends (CDC-ACM over TinyUSB, USB-Serial-JTAG).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   So existem nos alvos com USB (S2/S3 para o CDC, S3/C3 para o JTAG); nos outros o ops fica
+//   definido com init retornando ESP_ERR_NOT_SUPPORTED, e o menuconfig nem oferece a opcao.
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
+#include "transport.h"
+#ifdef CONFIG_UPLINK_PORT_USB_CDC
+#include "tinyusb.h"
+#include "tusb_cdc_acm.h"
+#endif
+#ifdef CONFIG_UPLINK_PORT_USB_JTAG
+#include "driver/usb_serial_jtag.h"
+#endif
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static esp_err_t Unsupported(size_t tx_buffer);
+#ifdef CONFIG_UPLINK_PORT_USB_CDC
+static esp_err_t CdcInit(size_t tx_buffer);
+static size_t    CdcWrite(const void *buf, size_t len, uint32_t timeout_ms);
+static esp_err_t CdcFlush(uint32_t timeout_ms);
+
+const transport_ops_t TransportUsbCdc = {"usbcdc", CdcInit, CdcWrite, CdcFlush};
+#else
+const transport_ops_t TransportUsbCdc = {"usbcdc", Unsupported, NULL, NULL};
+#endif
+#ifdef CONFIG_UPLINK_PORT_USB_JTAG
+static esp_err_t JtagInit(size_t tx_buffer);
+static size_t    JtagWrite(const void *buf, size_t len, uint32_t timeout_ms);
+
+const transport_ops_t TransportUsbJtag = {"usbjtag", JtagInit, JtagWrite, NULL};
+#else
+const transport_ops_t TransportUsbJtag = {"usbjtag", Unsupported, NULL, NULL};
+#endif
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- Unsupported ---
+static esp_err_t Unsupported(size_t tx_buffer)
+{
+  return ESP_ERR_NOT_SUPPORTED;
+}//end Unsupported
+
+#ifdef CONFIG_UPLINK_PORT_USB_CDC
+//=======================================================================================================
+//--- CdcInit ---
+// O buffer de TX do CDC e o CONFIG_TINYUSB_CDC_TX_BUFSIZE (fixo na compilacao); o USB-OTG tem DMA
+// proprio e transfere em pacotes de 64 bytes sem a CPU.
+static esp_err_t CdcInit(size_t tx_buffer)
+{
+  const tinyusb_config_t tusb = {0};                        // Descritores padrao do esp_tinyusb
+  tinyusb_config_cdcacm_t acm = {
+    .usb_dev          = TINYUSB_USBDEV_0,
+    .cdc_port         = TINYUSB_CDC_ACM_0,
+    .rx_unread_buf_sz = 64,
+  };
+  esp_err_t ret = tinyusb_driver_install(&tusb);
+
+  if(ret == ESP_OK)
+    ret = tusb_cdc_acm_init(&acm);
+  return ret;
+}//end CdcInit
+
+//=======================================================================================================
+//--- CdcWrite ---
+// Tudo ou nada, como na UART: so enfileira quando a fila do CDC tem espaco para a linha inteira. Com a
+// fila cheia espera a transferencia ate o timeout e, sem espaco, descarta a linha (0). Sem terminal
+// aberto (DTR baixo) descarta na hora, senao o DataExcel ficaria parado em cada amostra.
+static size_t CdcWrite(const void *buf, size_t len, uint32_t timeout_ms)
+{
+  if(!tud_cdc_n_connected(TINYUSB_CDC_ACM_0))
+    return 0;
+  if(tud_cdc_n_write_available(TINYUSB_CDC_ACM_0) < len &&
+     (tinyusb_cdcacm_write_flush(TINYUSB_CDC_ACM_0, pdMS_TO_TICKS(timeout_ms)) != ESP_OK ||
+      tud_cdc_n_write_available(TINYUSB_CDC_ACM_0) < len))
+    return 0;
+  size_t done = tinyusb_cdcacm_write_queue(TINYUSB_CDC_ACM_0, buf, len);
+  tinyusb_cdcacm_write_flush(TINYUSB_CDC_ACM_0, 0);        // Dispara a transferencia sem esperar
+  return done == len ? len : 0;
+}//end CdcWrite
+
+//=======================================================================================================
+//--- CdcFlush ---
+static esp_err_t CdcFlush(uint32_t timeout_ms)
+{
+  return tinyusb_cdcacm_write_flush(TINYUSB_CDC_ACM_0, pdMS_TO_TICKS(timeout_ms));
+}//end CdcFlush
+#endif
+
+#ifdef CONFIG_UPLINK_PORT_USB_JTAG
+//=======================================================================================================
+//--- JtagInit ---
+static esp_err_t JtagInit(size_t tx_buffer)
+{
+  usb_serial_jtag_driver_config_t cfg = {
+    .tx_buffer_size = tx_buffer,
+    .rx_buffer_size = 256,
+  };
+  return usb_serial_jtag_driver_install(&cfg);
+}//end JtagInit
+
+//=======================================================================================================
+//--- JtagWrite ---
+// O anel do driver e de bytes e o xRingbufferSend por baixo so aceita a linha inteira: len ou 0.
+static size_t JtagWrite(const void *buf, size_t len, uint32_t timeout_ms)
+{
+  int n = usb_serial_jtag_write_bytes(buf, len, pdMS_TO_TICKS(timeout_ms));
+  return n > 0 ? (size_t)n : 0;
+}//end JtagWrite
+#endif
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,119 @@
+//=======================================================================================================
+//
+//   Title: Uplink record formatting (receiver -> PC).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <stdio.h>
+#include <stdarg.h>
+#include "uplink.h"
+#include "metrics.h"
+
+//=======================================================================================================
+//--- Const and Macro ---
+static const char *FmtName[UPLINK_FMT_COUNT] = {"csv", "json"};
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static size_t put_fmt(char *buf, size_t size, size_t n, const char *fmt, ...);
+static size_t put_e7(char *buf, size_t size, size_t n, int32_t v);
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- uplink_format_csv ---
+size_t uplink_format_csv(const telemetry_sample_t *s, char *buf, size_t size)
+{
+  size_t n = 0;
+
+  n = put_fmt(buf, size, n, "%u,%.1f,%.1f,%.2f,%lu,", s->node, s->anglePitchDeg, s->angleRollDeg, s->temp,
+              (unsigned long)s->pressure_bmp);
+  n = put_e7(buf, size, n, s->lat_e7);
+  n = put_fmt(buf, size, n, ",");
+  n = put_e7(buf, size, n, s->lon_e7);
+  n = put_fmt(buf, size, n, ",%.2f,%.3f,%u,%d,", s->altitude, s->speed, s->SNR, s->rssi);
+  if(s->flags & TELEM_FLAG_GEO)
+    n = put_fmt(buf, size, n, "%.1f,%.1f,%.1f", s->range_m, s->bearing_deg, s->elevation_deg);
+  else
+    n = put_fmt(buf, size, n, ",,");
+  n = put_fmt(buf, size, n, ",%lld,%u,%.1f,%.1f,%u,%.1f,%.1f,%.1f,%u\n", (long long)s->t_sample_us,
+              (s->flags & TELEM_FLAG_TSYNC) ? 1u : 0u, s->vspeed, s->alt_max, s->phase, s->apogee_s, s->pitch_avg,
+              s->roll_avg, s->alarms);
+
+  return n < size ? n : 0;
+}//end uplink_format_csv
+
+//=======================================================================================================
+//--- uplink_format_json ---
+size_t uplink_format_json(const telemetry_sample_t *s, char *buf, size_t size)
+{
+  size_t n = 0;
+
+  n = put_fmt(buf, size, n, "{\"node\":%u,\"pitch\":%.1f,\"roll\":%.1f,\"temp\":%.2f,\"pressure\":%lu,\"lat\":",
+              s->node, s->anglePitchDeg, s->angleRollDeg, s->temp, (unsigned long)s->pressure_bmp);
+  n = s->lat_e7 == TELEM_COORD_INVALID ? put_fmt(buf, size, n, "null") : put_e7(buf, size, n, s->lat_e7);
+  n = put_fmt(buf, size, n, ",\"lon\":");
+  n = s->lon_e7 == TELEM_COORD_INVALID ? put_fmt(buf, size, n, "null") : put_e7(buf, size, n, s->lon_e7);
+  n = put_fmt(buf, size, n, ",\"alt\":%.2f,\"speed\":%.3f,\"snr\":%u,\"rssi\":%d", s->altitude, s->speed,
+              s->SNR, s->rssi);
+  if(s->flags & TELEM_FLAG_GEO)
+    n = put_fmt(buf, size, n, ",\"range\":%.1f,\"bearing\":%.1f,\"elevation\":%.1f", s->range_m,
+                s->bearing_deg, s->elevation_deg);
+  n = put_fmt(buf, size, n, ",\"t_us\":%lld,\"sync\":%s", (long long)s->t_sample_us,
+              (s->flags & TELEM_FLAG_TSYNC) ? "true" : "false");
+  n = put_fmt(buf, size, n, ",\"vz\":%.1f,\"alt_max\":%.1f,\"phase\":\"%s\",\"apogee_s\":%.1f,\"pitch_avg\":%.1f,"
+              "\"roll_avg\":%.1f,\"alarms\":%u}\n", s->vspeed, s->alt_max, metrics_phase_name(s->phase),
+              s->apogee_s, s->pitch_avg, s->roll_avg, s->alarms);
+
+  return n < size ? n : 0;
+}//end uplink_format_json
+
+//=======================================================================================================
+//--- uplink_format ---
+size_t uplink_format(uplink_fmt_t fmt, const telemetry_sample_t *s, char *buf, size_t size)
+{
+  return fmt == UPLINK_JSON ? uplink_format_json(s, buf, size) : uplink_format_csv(s, buf, size);
+}//end uplink_format
+
+//=======================================================================================================
+//--- uplink_format_name ---
+const char *uplink_format_name(uplink_fmt_t fmt)
+{
+  return fmt < UPLINK_FMT_COUNT ? FmtName[fmt] : "?";
+}//end uplink_format_name
+
+//=======================================================================================================
+//--- put_fmt ---
+// snprintf acumulativo; depois de estourar o buffer n fica >= size e as chamadas seguintes nao escrevem.
+static size_t put_fmt(char *buf, size_t size, size_t n, const char *fmt, ...)
+{
+  if(n >= size)
+    return n;
+
+  va_list ap;
+  va_start(ap, fmt);
+  int w = vsnprintf(buf + n, size - n, fmt, ap);
+  va_end(ap);
+  return w < 0 ? size : n + (size_t)w;
+}//end put_fmt
+
+//=======================================================================================================
+//--- put_e7 ---
+// Coordenada em 1e-7 graus impressa sem passar por float (que perderia a 7a casa).
+static size_t put_e7(char *buf, size_t size, size_t n, int32_t v)
+{
+  if(v == TELEM_COORD_INVALID)
+    return n;                                 // Campo vazio quando nao ha fix
+
+  uint32_t a = v < 0 ? (uint32_t)(-(int64_t)v) : (uint32_t)v;
+  return put_fmt(buf, size, n, "%s%lu.%07lu", v < 0 ? "-" : "",
+                 (unsigned long)(a / 10000000u), (unsigned long)(a % 10000000u));
+}//end put_e7
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,50 @@
+//=======================================================================================================
+//
+//   Title: Uplink record formatting (receiver -> PC).
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Uma linha CSV por amostra:
+//     no,pitch,roll,temp,pressao,lat,lon,altitude,velocidade,snr,rssi,range,bearing,elevation,t_us,sinc,
+//     vz,alt_max,fase,apogeu_s,pitch_m,roll_m,alm
+//   lat/lon em graus decimais (7 casas); campos geometricos vazios sem fix de GPS. t_us = instante da
+//   medida no relogio do receptor (esp_timer); sinc = 1 quando veio do relogio do transmissor
+//   (timesync.h), 0 quando e o fim do preambulo do frame. vz..roll_m vem do metrics.h (fase 0..3 =
+//   solo, subida, descida, pouso; apogeu_s = 0 antes do apogeu). alm = mascara das regras de alarme
+//   ativas no no (alarm.h); disparos e retornos tambem saem como linhas $ALM.
+//   Alternativa selecionavel pelo console: um objeto JSON por linha com as mesmas chaves, lat/lon
+//   null e sem as chaves geometricas quando nao ha fix; a fase vai pelo nome.
+//=======================================================================================================
+
+#ifndef UPLINK_h
+#define UPLINK_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include <stddef.h>
+#include "telemetry.h"
+
+//=======================================================================================================
+//--- Macros and Constants ---
+#define UPLINK_LINE_MAX 416                   // Pior caso com os campos no limite dos sensores: JSON 382, CSV 180
+
+//=======================================================================================================
+//--- Types ---
+
+typedef enum{
+    UPLINK_CSV = 0,
+    UPLINK_JSON,
+    UPLINK_FMT_COUNT
+}uplink_fmt_t;
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+size_t uplink_format_csv(const telemetry_sample_t *s, char *buf, size_t size);  // Retorna o tamanho da linha (0 se nao couber)
+size_t uplink_format_json(const telemetry_sample_t *s, char *buf, size_t size);
+size_t uplink_format(uplink_fmt_t fmt, const telemetry_sample_t *s, char *buf, size_t size);
+const char *uplink_format_name(uplink_fmt_t fmt);                               // "csv", "json"
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
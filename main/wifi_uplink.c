@@ -0,0 +1,143 @@
+//=======================================================================================================
+//
+//   Title: Wi-Fi station and network uplink task.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//=======================================================================================================
+
+//=======================================================================================================
+//--- Bibliotecas ---
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+#include "wifi_uplink.h"
+#ifdef CONFIG_NET_UPLINK
+#include "esp_wifi.h"
+#include "esp_netif.h"
+#include "esp_event.h"
+#include "netout.h"
+#endif
+
+#ifdef CONFIG_NET_UPLINK
+//=======================================================================================================
+//--- Const and Macro ---
+#define WIFI_UP    BIT0
+#define NET_POLL_MS 10                        // Atraso maximo entre a amostra no anel e o send()
+static const char *TAG8 = "NET";
+
+//=======================================================================================================
+//--- Variaveis ---
+static sample_ring_t     *Ring;
+static EventGroupHandle_t WifiEvents;
+static StaticEventGroup_t WifiEventsBuf;
+static StackType_t        NetStack[CONFIG_STACK_NET];
+static StaticTask_t       NetTcb;
+
+//=======================================================================================================
+//--- Functions prototypes ---
+static void NetTask(void *p);
+static void WifiInit(void);
+static void WifiEvent(void *arg, esp_event_base_t base, int32_t id, void *data);
+#endif
+
+//=======================================================================================================
+//--- Functions ---
+
+//=======================================================================================================
+//--- wifi_uplink_start ---
+void wifi_uplink_start(sample_ring_t *ring)
+{
+#ifdef CONFIG_NET_UPLINK
+  Ring = ring;
+  xTaskCreateStaticPinnedToCore(NetTask,"Net",sizeof(NetStack),NULL,CONFIG_PRIO_NET,NetStack,&NetTcb,CONFIG_APP_CORE);
+#endif
+}//end wifi_uplink_start
+
+#ifdef CONFIG_NET_UPLINK
+//=======================================================================================================
+//--- NetTask ---
+// Espera o IP, sobe os servidores e alterna entre drenar o anel e o poll dos sockets. O select do
+// poll e a espera da task; nao ha notificacao do radio.
+static void NetTask(void *p)
+{
+  const net_config_t cfg = {
+    .udp_dest = CONFIG_NET_UDP_DEST,
+    .udp_port = CONFIG_NET_UDP_PORT,
+    .tcp_port = CONFIG_NET_TCP_PORT,
+    .ws_port  = CONFIG_NET_WS_PORT,
+    .batch_ms = CONFIG_NET_BATCH_MS,
+  };
+  sample_reader_t    reader;
+  telemetry_sample_t s;
+
+  WifiInit();
+  xEventGroupWaitBits(WifiEvents, WIFI_UP, pdFALSE, pdTRUE, portMAX_DELAY);
+  int err = netout_start(&cfg);
+  if(err)
+  {
+    ESP_LOGE(TAG8, "Servidores de rede nao subiram (errno %d)", -err);
+    vTaskDelete(NULL);
+  }//end if
+  ESP_LOGI(TAG8, "UDP %s:%d, TCP %d, WebSocket %d", CONFIG_NET_UDP_DEST, CONFIG_NET_UDP_PORT, CONFIG_NET_TCP_PORT,
+           CONFIG_NET_WS_PORT);
+
+  sample_ring_reader_init(Ring, &reader);
+  while(true)
+  {
+    while(sample_ring_pop(Ring, &reader, &s))
+      netout_push(&s, esp_timer_get_time());
+    netout_poll(NET_POLL_MS, esp_timer_get_time());
+  }//end while
+}//end NetTask
+
+//=======================================================================================================
+//--- WifiInit ---
+// A NVS (calibracao do radio Wi-Fi) ja foi aberta pelo settings_init.
+static void WifiInit(void)
+{
+  wifi_init_config_t init = WIFI_INIT_CONFIG_DEFAULT();
+  wifi_config_t      sta;
+
+  WifiEvents = xEventGroupCreateStatic(&WifiEventsBuf);
+  ESP_ERROR_CHECK(esp_netif_init());
+  ESP_ERROR_CHECK(esp_event_loop_create_default());
+  esp_netif_create_default_wifi_sta();
+  ESP_ERROR_CHECK(esp_wifi_init(&init));
+  ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID, WifiEvent, NULL, NULL));
+  ESP_ERROR_CHECK(esp_event_handler_instance_register(IP_EVENT, IP_EVENT_STA_GOT_IP, WifiEvent, NULL, NULL));
+
+  memset(&sta, 0, sizeof(sta));
+  strncpy((char *)sta.sta.ssid, CONFIG_NET_WIFI_SSID, sizeof(sta.sta.ssid) - 1);
+  strncpy((char *)sta.sta.password, CONFIG_NET_WIFI_PASSWORD, sizeof(sta.sta.password) - 1);
+  ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
+  ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &sta));
+  ESP_ERROR_CHECK(esp_wifi_start());
+  esp_wifi_set_ps(WIFI_PS_NONE);                            // Modem sleep atrasa cada datagrama ate o proximo beacon
+}//end WifiInit
+
+//=======================================================================================================
+//--- WifiEvent ---
+static void WifiEvent(void *arg, esp_event_base_t base, int32_t id, void *data)
+{
+  if(base == WIFI_EVENT && (id == WIFI_EVENT_STA_START || id == WIFI_EVENT_STA_DISCONNECTED))
+  {
+    if(id == WIFI_EVENT_STA_DISCONNECTED)
+      xEventGroupClearBits(WifiEvents, WIFI_UP);
+    esp_wifi_connect();                                     // Reconecta para sempre; os sockets seguem abertos
+  }//end if
+  else if(base == IP_EVENT && id == IP_EVENT_STA_GOT_IP)
+  {
+    ip_event_got_ip_t *ev = data;
+    ESP_LOGI(TAG8, "IP " IPSTR, IP2STR(&ev->ip_info.ip));
+    xEventGroupSetBits(WifiEvents, WIFI_UP);
+  }//end else if
+}//end WifiEvent
+#endif
+
+//=======================================================================================================
+//--- End of Program ---
@@ -0,0 +1,26 @@
+//=======================================================================================================
+//
+//   Title: Wi-Fi station and network uplink task.
+//   Author: Joao Ricardo Chaves.
+//   Date: October,2026.
+//
+//   Com CONFIG_NET_UPLINK a task "Net" conecta na rede do menuconfig, le o SampleRing com o proprio
+//   cursor (como o DataExcel e o log em flash) e entrega as amostras ao netout (UDP/TCP/WebSocket).
+//   O radio nunca espera pela rede: se a task atrasar, so o cursor dela perde amostras.
+//=======================================================================================================
+
+#ifndef WIFI_UPLINK_h
+#define WIFI_UPLINK_h
+
+//=======================================================================================================
+//--- Libraries ---
+#include "sample_ring.h"
+
+//=======================================================================================================
+//--- Functions Prototypes ---
+
+void wifi_uplink_start(sample_ring_t *ring);                  // Nada sem CONFIG_NET_UPLINK
+
+#endif
+//=======================================================================================================
+//--- End of Program ---
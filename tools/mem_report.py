@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+"""Static RAM report of the receiver firmware, per subsystem, with a budget gate.
+
+Reads the GNU ld map file of the build and sums every RAM input section
+(.data*, .bss*, .dram*, COMMON) that comes from the main and lora components.
+Since tasks, queues and rings are allocated statically (Kconfig "Memory plan"),
+this covers the stacks too. The build runs it after linking:
+
+    tools/mem_report.py build/Telemetry_IDF.map build/config/sdkconfig.h
+
+and fails when the total goes over CONFIG_MEM_BUDGET_KB. With -v the largest
+symbols of each subsystem are listed as well. IDF drivers (UART/USB TX buffers,
+Wi-Fi) still allocate from the heap once at boot; see the $MEM report line.
+"""
+
+import argparse
+import re
+import sys
+from collections import defaultdict
+
+# Components whose RAM is ours to budget
+LIBS = ("libmain.a", "liblora.a")
+
+# Source file -> subsystem; anything else is reported under its own name
+SUBSYSTEM = {
+    "main": "tasks/main",
+    "lcd_jr": "lcd", "display": "lcd", "ssd1306": "lcd",
+    "radio": "link", "link": "link", "tdma": "link", "arq": "link", "fec": "link",
+    "delta": "link", "integrity": "link", "nodes": "link", "timesync": "link", "radiosup": "link",
+    "sample_ring": "ring", "telemetry": "ring", "geo": "ring", "metrics": "ring", "uplink": "ring",
+    "transport": "transport", "transport_uart": "transport", "transport_usb": "transport",
+    "netout": "net", "wifi_uplink": "net",
+    "instr": "instr", "lat_hist": "instr",
+    "console": "console", "settings": "console", "flashlog": "flashlog",
+    "power": "power",
+    "lora": "lora", "lora_sim": "lora",
+}
+
+RAM_SECTION = re.compile(r"^\.(data|bss|sdata|sbss|dram\d*)\b|^COMMON$")
+OBJECT = re.compile(r"(lib\w+\.a)\(([\w.-]+?)\.c\.o(?:bj)?\)$")
+# " .bss.Name  0xADDR  0xSIZE  path" (a long section name wraps the rest to the next line)
+ENTRY = re.compile(r"^ (\S+)(?:\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S+))?\s*$")
+WRAPPED = re.compile(r"^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S+)\s*$")
+
+
+def parse_map(path):
+    """Returns {(lib, source): [(section, size), ...]} for the RAM sections of LIBS."""
+    found = defaultdict(list)
+    with open(path, errors="replace") as f:
+        for line in f:
+            if line.startswith("Linker script and memory map"):
+                break
+        else:
+            sys.exit("%s: not a GNU ld map file" % path)
+
+        pending = None
+        for line in f:
+            if pending is not None:
+                m = WRAPPED.match(line)
+                section, pending = pending, None
+                if m:
+                    add(found, section, int(m.group(2), 16), m.group(3))
+                    continue
+            m = ENTRY.match(line)
+            if not m or m.group(1).startswith("*"):
+                continue
+            if m.group(2) is None:
+                pending = m.group(1)
+            else:
+                add(found, m.group(1), int(m.group(3), 16), m.group(4))
+    return found
+
+
+def add(found, section, size, obj):
+    m = OBJECT.search(obj)
+    if size == 0 or not m or m.group(1) not in LIBS or not RAM_SECTION.match(section):
+        return
+    found[(m.group(1), m.group(2))].append((section, size))
+
+
+def budget_kb(sdkconfig):
+    with open(sdkconfig) as f:
+        m = re.search(r"#define\s+CONFIG_MEM_BUDGET_KB\s+(\d+)", f.read())
+    return int(m.group(1)) if m else None
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("map", help="linker map file (build/<project>.map)")
+    ap.add_argument("sdkconfig", nargs="?", help="build/config/sdkconfig.h (for CONFIG_MEM_BUDGET_KB)")
+    ap.add_argument("--budget-kb", type=int, help="override CONFIG_MEM_BUDGET_KB")
+    ap.add_argument("-v", "--verbose", action="store_true", help="list the largest symbols of each subsystem")
+    args = ap.parse_args()
+
+    found = parse_map(args.map)
+    if not found:
+        sys.exit("%s: no RAM sections from %s" % (args.map, ", ".join(LIBS)))
+
+    groups = defaultdict(lambda: {"data": 0, "bss": 0, "symbols": []})
+    for (lib, src), sections in found.items():
+        g = groups[SUBSYSTEM.get(src, src)]
+        for section, size in sections:
+            g["data" if section.startswith((".data", ".sdata", ".dram")) else "bss"] += size
+            g["symbols"].append((size, "%s:%s" % (src, section.split(".")[-1])))
+
+    total = sum(g["data"] + g["bss"] for g in groups.values())
+    print("%-12s %8s %8s %8s %6s" % ("subsystem", "data", "bss", "total", "%"))
+    for name, g in sorted(groups.items(), key=lambda kv: -(kv[1]["data"] + kv[1]["bss"])):
+        sub = g["data"] + g["bss"]
+        print("%-12s %8d %8d %8d %5.1f%%" % (name, g["data"], g["bss"], sub, 100.0 * sub / total))
+        if args.verbose:
+            for size, sym in sorted(g["symbols"], reverse=True)[:5]:
+                print("    %-28s %8d" % (sym, size))
+    print("%-12s %8s %8s %8d" % ("total", "", "", total))
+
+    budget = args.budget_kb
+    if budget is None and args.sdkconfig:
+        budget = budget_kb(args.sdkconfig)
+    if budget is None:
+        return 0
+    print("budget       %26d (%d KB, %d bytes free)" % (budget * 1024, budget, budget * 1024 - total))
+    if total > budget * 1024:
+        print("error: static RAM %d bytes is over CONFIG_MEM_BUDGET_KB=%d" % (total, budget), file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""End-to-end throughput test of the receiver firmware under QEMU.
+
+Builds Telemetry_IDF with the simulated SX1276 (sdkconfig.qemu: CONFIG_LORA_SIM),
+boots it in qemu-system-xtensa and checks that every injected frame comes out as an
+uplink CSV record on the emulated UART. The simulator sweeps the injection rate
+(CONFIG_LORA_SIM_RATE_*) and prints one $SIM line per step; this script reports the
+highest rate with no dropped frames and fails if it is below --min-rate.
+
+    tools/qemu_e2e.py                     # build + run, default gate
+    tools/qemu_e2e.py --no-build --min-rate 50 --json result.json
+    tools/qemu_e2e.py --no-build --cmd-period 0.5   # same sweep with console traffic
+
+QEMU's UART is not baud-limited, so the result measures the firmware pipeline
+(radio task, parse, ring, uplink formatting), not the 115200 baud link.
+
+With --cmd-period the script types console commands on the emulated UART during the
+sweep and reports the last $LAT,cmd (command handling) and $LAT,rx_parse (receive
+path) histograms; compare rx_parse with and without it to see the console's effect.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import threading
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+BUILD = os.path.join(ROOT, "build-qemu")
+
+# Index of the pressure field (carries the simulator sequence number) in the uplink CSV
+SEQ_FIELD = 4
+
+# Commands cycled by --cmd-period (none of them changes what the sweep measures)
+COMMANDS = ["stats", "regs", "profile", "uplink csv", "log status", "help"]
+
+
+def build():
+    cmd = ["idf.py", "-C", ROOT, "-B", BUILD,
+           "-D", "SDKCONFIG=" + os.path.join(BUILD, "sdkconfig"),
+           "-D", "SDKCONFIG_DEFAULTS=sdkconfig.defaults;sdkconfig.qemu",
+           "build"]
+    subprocess.run(cmd, check=True)
+    subprocess.run(["esptool.py", "--chip", "esp32", "merge_bin", "--fill-flash-size", "4MB",
+                    "-o", "flash.bin", "@flash_args"], cwd=BUILD, check=True)
+
+
+def type_commands(proc, period, stop):
+    i = 0
+    while not stop.wait(period):
+        try:
+            proc.stdin.write(COMMANDS[i % len(COMMANDS)] + "\n")
+            proc.stdin.flush()
+        except (BrokenPipeError, ValueError):
+            return
+        i += 1
+
+
+def lat_record(line):
+    _, name, n, lo, mean, p50, p99, hi = line.split(",")
+    return {"name": name, "n": int(n), "min_us": int(lo), "mean_us": int(mean),
+            "p50_us": int(p50), "p99_us": int(p99), "max_us": int(hi)}
+
+
+def run(timeout, cmd_period):
+    cmd = ["qemu-system-xtensa", "-nographic", "-machine", "esp32",
+           "-drive", "file=" + os.path.join(BUILD, "flash.bin") + ",if=mtd,format=raw"]
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            stdin=subprocess.PIPE if cmd_period else subprocess.DEVNULL,
+                            text=True, errors="replace")
+    seen = set()
+    steps = []
+    lat = {}
+    boot = {}
+    stop = threading.Event()
+    if cmd_period:
+        threading.Thread(target=type_commands, args=(proc, cmd_period, stop), daemon=True).start()
+    deadline = time.monotonic() + timeout
+    try:
+        for line in proc.stdout:
+            line = line.strip()
+            if line.startswith("$SIM,END"):
+                break
+            if line.startswith("$LAT,"):
+                rec = lat_record(line)
+                lat[rec["name"]] = rec
+            if line.startswith("$BOOT,"):
+                boot = dict(zip(("radio_ms", "rx_ms", "lcd_ms", "ready_ms", "first_packet_ms"),
+                                map(int, line.split(",")[1:])))
+            if line.startswith("$SIM,"):
+                _, step, rate, first, sent, overrun = line.split(",")
+                first, sent = int(first), int(sent)
+                got = sum(1 for s in range(first, first + sent) if s in seen)
+                steps.append({"step": int(step), "rate_hz": int(rate), "sent": sent,
+                              "received": got, "radio_overrun": int(overrun)})
+                print("step %2s  %5s Hz  sent %6d  received %6d  overrun %s"
+                      % (step, rate, sent, got, overrun), flush=True)
+            elif not line.startswith("$"):
+                fields = line.split(",")
+                if len(fields) > SEQ_FIELD and fields[SEQ_FIELD].isdigit():
+                    seen.add(int(fields[SEQ_FIELD]))
+            if time.monotonic() > deadline:
+                print("timeout waiting for $SIM,END", file=sys.stderr)
+                break
+    finally:
+        stop.set()
+        proc.kill()
+        proc.wait()
+    return steps, lat, boot
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--no-build", action="store_true", help="reuse build-qemu/flash.bin")
+    ap.add_argument("--min-rate", type=int, default=20, help="fail if max lossless rate is below this (packets/s)")
+    ap.add_argument("--timeout", type=int, default=600, help="seconds before giving up")
+    ap.add_argument("--json", help="write the per-step results here")
+    ap.add_argument("--cmd-period", type=float, default=0,
+                    help="type a console command every N seconds during the sweep (0 = off)")
+    args = ap.parse_args()
+
+    if not args.no_build:
+        build()
+    steps, lat, boot = run(args.timeout, args.cmd_period)
+    if not steps:
+        print("no $SIM results (firmware did not boot?)", file=sys.stderr)
+        return 1
+
+    lossless = [s["rate_hz"] for s in steps if s["received"] == s["sent"]]
+    best = max(lossless) if lossless else 0
+    print("max sustained rate without drops: %d packets/s" % best)
+    for name in ("rx_parse", "cmd"):
+        if name in lat:
+            r = lat[name]
+            print("latency %-8s n %7d  p50 %6d us  p99 %6d us  max %6d us"
+                  % (name, r["n"], r["p50_us"], r["p99_us"], r["max_us"]))
+    if boot:
+        print("boot: radio %d ms, rx %d ms, ready %d ms, first packet %d ms"
+              % (boot["radio_ms"], boot["rx_ms"], boot["ready_ms"], boot["first_packet_ms"]))
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump({"max_lossless_rate_hz": best, "steps": steps, "latency": lat, "boot": boot}, f, indent=2)
+    return 0 if best >= args.min_rate else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,80 @@
+#!/usr/bin/env python3
+"""Uplink port throughput, measured on the board and on the PC.
+
+Sends the console command "tput N" and counts the $TPUT lines that arrive on the
+uplink port. The board reports how long its port took to drain N kB ($CMD,tput);
+the PC side reports the rate it actually received. The uplink port is chosen at
+build time (CONFIG_UPLINK_PORT_*), so run once per backend:
+
+    tools/uplink_tput.py --console /dev/ttyUSB0                         # uart
+    tools/uplink_tput.py --console /dev/ttyUSB0 --uplink /dev/ttyACM0   # usbcdc / usbjtag
+
+Needs pyserial. With a USB uplink the baud rate is ignored by the port.
+"""
+
+import argparse
+import sys
+import time
+
+try:
+    import serial
+except ImportError:
+    sys.exit("needs pyserial (pip install pyserial)")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    ap.add_argument("--console", required=True, help="serial port of the command console")
+    ap.add_argument("--uplink", help="serial port of the uplink (default: the console port)")
+    ap.add_argument("--baud", type=int, default=115200, help="CONFIG_UPLINK_UART_BAUD")
+    ap.add_argument("--kbytes", type=int, default=256)
+    ap.add_argument("--timeout", type=float, default=60)
+    args = ap.parse_args()
+
+    console = serial.Serial(args.console, args.baud, timeout=0)
+    uplink = console if args.uplink in (None, args.console) else serial.Serial(args.uplink, args.baud, timeout=0)
+    uplink.reset_input_buffer()
+    console.write(b"tput %d\n" % args.kbytes)
+
+    got = 0
+    first = last = None
+    reply = None
+    pending = {console: b"", uplink: b""}
+    deadline = time.monotonic() + args.timeout
+    while time.monotonic() < deadline:
+        idle = True
+        for port in set(pending):
+            data = port.read(4096)
+            if not data:
+                continue
+            idle = False
+            now = time.monotonic()
+            lines = (pending[port] + data).split(b"\n")
+            pending[port] = lines.pop()
+            for line in lines:
+                if line.startswith(b"$TPUT") and port is uplink:
+                    got += len(line) + 1
+                    first = first or now
+                    last = now
+                elif line.startswith(b"$CMD,tput"):
+                    reply = line.decode(errors="replace").strip()
+        if reply and idle and (last is None or time.monotonic() - last > 1.0):
+            break
+        if idle:
+            time.sleep(0.005)
+
+    if reply is None:
+        sys.exit("no $CMD,tput reply (console off or wrong port?)")
+    status, port_name, sent, ms, kbs = reply.split(",")[2:7]
+    print("port %-8s board: %s bytes in %s ms = %s kB/s (%s)" % (port_name, sent, ms, kbs, status))
+    if first is not None and last > first:
+        print("port %-8s PC:    %d bytes in %d ms = %d kB/s"
+              % (port_name, got, (last - first) * 1000, got / (last - first) / 1000))
+    if got < int(sent):
+        print("lost %d bytes between board and PC" % (int(sent) - got))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())